@@ -0,0 +1,64 @@
+/**
+ * @file ByteOrder.hpp
+ * @brief Little-endian field encoding for the binary on-disk formats
+ *
+ * Fields are written byte by byte so files are identical regardless of the
+ * host's endianness; compilers lower these loops to single moves on x86.
+ * getBE() reads the big-endian fields of external formats such as TZif.
+ */
+
+#ifndef BYTE_ORDER_HPP
+#define BYTE_ORDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace ByteOrder {
+
+    /**
+     * @brief Append an integer in little-endian byte order
+     * @param out Destination buffer
+     * @param value Value to encode (sizeof(T) bytes)
+     */
+    template<typename T>
+    void putLE(std::string& out, T value) {
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            out.push_back(static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF));
+        }
+    }
+
+    /**
+     * @brief Read a little-endian integer
+     * @param data Source bytes
+     * @param pos Offset of the first byte (caller checks bounds)
+     * @return Decoded value
+     */
+    template<typename T>
+    [[nodiscard]] T getLE(std::string_view data, size_t pos) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            value |= static_cast<uint64_t>(static_cast<uint8_t>(data[pos + i])) << (8 * i);
+        }
+        return static_cast<T>(value);
+    }
+
+    /**
+     * @brief Read a big-endian integer
+     * @param data Source bytes
+     * @param pos Offset of the first byte (caller checks bounds)
+     * @return Decoded value
+     */
+    template<typename T>
+    [[nodiscard]] T getBE(std::string_view data, size_t pos) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            value = (value << 8) | static_cast<uint8_t>(data[pos + i]);
+        }
+        return static_cast<T>(value);
+    }
+
+} // namespace ByteOrder
+
+#endif // BYTE_ORDER_HPP
@@ -0,0 +1,102 @@
+/**
+ * @file ChangeFeed.hpp
+ * @brief Durable, sequence-numbered stream of task changes
+ *
+ * Every logical change made through Tasks is appended to a feed file
+ * (<stem>.changes.jsonl) next to the data file, one compact JSON object per
+ * line:
+ *
+ *   {"seq":12,"after":{"status":3},"before":{"status":1},"id":42,"time":...,"type":"update"}
+ *
+ * `seq` always comes first so readers can find a position by peeking at
+ * line prefixes instead of parsing whole records. Sequence numbers start at
+ * 1 and increase by one per event across the life of the store; storage
+ * maintenance (flushes, checkpoints, resharding) never emits events.
+ */
+
+#ifndef CHANGE_FEED_HPP
+#define CHANGE_FEED_HPP
+
+#include "json.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+/**
+ * @class ChangeFeed
+ * @brief Append-only change log consumers can resume from any sequence number
+ */
+class ChangeFeed {
+public:
+    /**
+     * @struct Event
+     * @brief One change to one task
+     *
+     * before/after hold only the fields that changed (all fields for add and
+     * remove; the missing side is null). A bulk "import" carries no task
+     * fields: id is the first new task and after holds first_id, last_id,
+     * count and source.
+     */
+    struct Event {
+        std::string type;           ///< add, update, remove, tag, due, archive or import
+        int id = 0;                 ///< Task identifier
+        nlohmann::json before;      ///< Changed fields before (null for add)
+        nlohmann::json after;       ///< Changed fields after (null for remove and archive)
+    };
+
+    /**
+     * @brief Describe the difference between two versions of a task
+     * @param before Task JSON before the change (nullptr if the task is new)
+     * @param after Task JSON after the change (nullptr if the task is gone)
+     * @return Event, or nullopt if nothing changed
+     *
+     * Changes confined to tags are "tag" events, to the due date "due"
+     * events; anything else is an "update".
+     */
+    [[nodiscard]] static std::optional<Event> diff(const nlohmann::json* before, const nlohmann::json* after);
+
+    /**
+     * @brief Get the feed that belongs to a data file
+     * @param dataFile Logical data file (e.g. data/data.json)
+     * @return Sibling feed path (e.g. data/data.changes.jsonl)
+     */
+    [[nodiscard]] static std::filesystem::path pathFor(const std::filesystem::path& dataFile);
+
+    explicit ChangeFeed(std::filesystem::path dataFile);
+
+    /**
+     * @brief Durably append events, numbering them after the current last one
+     * @param events Events in the order they happened
+     * @throws std::runtime_error if the feed cannot be written or synced
+     */
+    void append(std::span<const Event> events);
+
+    /**
+     * @brief Get the sequence number of the newest event
+     * @return Last sequence number (0 for an empty feed)
+     */
+    [[nodiscard]] uint64_t lastSequence() const;
+
+    /**
+     * @brief Visit events newer than a sequence number
+     * @param since Only events with seq > since are visited
+     * @param visit Called with each event's JSON line (without the newline)
+     * @return Sequence number of the last event visited (since if none)
+     *
+     * The start position is found by binary search over line starts, so
+     * catching up costs O(log feed size) seeks plus the events returned.
+     */
+    uint64_t readSince(uint64_t since, const std::function<void(std::string_view)>& visit) const;
+
+    [[nodiscard]] const std::filesystem::path& path() const noexcept;  ///< Get the feed file
+
+private:
+    std::filesystem::path path_;                    ///< Feed file
+    mutable std::optional<uint64_t> lastSeq_;       ///< Cached newest sequence number
+};
+
+#endif // CHANGE_FEED_HPP
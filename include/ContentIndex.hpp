@@ -0,0 +1,81 @@
+/**
+ * @file ContentIndex.hpp
+ * @brief Merkle-style hashes over id-ordered ranges of a task store
+ *
+ * Every task contributes its content hash (Task::contentHash()). The hash
+ * of an id range is the sum of the hashes of the tasks in it, so any range
+ * can be hashed from prefix sums in O(log N) without building a tree. Two
+ * stores are compared by hashing the whole id space on both sides and only
+ * descending into halves whose hashes differ. Finding k differing tasks
+ * therefore costs O(k x log(id span) x log N) instead of a full comparison.
+ */
+
+#ifndef CONTENT_INDEX_HPP
+#define CONTENT_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * @class ContentIndex
+ * @brief Id-sorted content hashes with O(log N) range hashing
+ */
+class ContentIndex {
+public:
+    /**
+     * @struct Entry
+     * @brief One task's identity and content hash
+     */
+    struct Entry {
+        int id = 0;             ///< Task identifier
+        uint64_t hash = 0;      ///< Task::contentHash()
+    };
+
+    /**
+     * @struct Comparison
+     * @brief Result of comparing two indexes
+     */
+    struct Comparison {
+        std::vector<int> ids;       ///< IDs added, removed or changed, ascending
+        size_t rangesCompared = 0;  ///< Range hashes compared while descending
+    };
+
+    ContentIndex() = default;
+
+    /**
+     * @brief Build an index from unordered entries
+     * @param entries One entry per task (IDs must be unique)
+     */
+    explicit ContentIndex(std::vector<Entry> entries);
+
+    /**
+     * @brief Hash every task with an ID in [low, high)
+     * @param low First ID in the range
+     * @param high One past the last ID in the range
+     * @return Sum of the content hashes in the range (0 if it is empty)
+     */
+    [[nodiscard]] uint64_t rangeHash(int64_t low, int64_t high) const;
+
+    [[nodiscard]] uint64_t rootHash() const noexcept;                  ///< Get the hash of the whole store
+    [[nodiscard]] size_t size() const noexcept;                        ///< Get the number of tasks
+    [[nodiscard]] std::optional<uint64_t> find(int id) const;          ///< Get one task's hash, if present
+    [[nodiscard]] const std::vector<Entry>& entries() const noexcept;  ///< Get entries sorted by ID
+
+    /**
+     * @brief Find tasks that differ between two stores
+     * @param first One store's index
+     * @param second The other store's index
+     * @return Differing IDs and the number of ranges compared to find them
+     */
+    [[nodiscard]] static Comparison compare(const ContentIndex& first, const ContentIndex& second);
+
+private:
+    std::vector<Entry> entries_;        ///< Entries sorted by ID
+    std::vector<uint64_t> prefix_;      ///< prefix_[i] = sum of the first i hashes
+
+    [[nodiscard]] size_t lowerBound(int64_t id) const;  ///< Index of the first entry with ID >= id
+};
+
+#endif // CONTENT_INDEX_HPP
@@ -0,0 +1,41 @@
+/**
+ * @file EvalContext.hpp
+ * @brief The instant a command evaluates time-dependent task state against
+ *
+ * Overdue checks, day counts and every filter, statistic and renderer
+ * built on them read "now" from one EvalContext instead of sampling the
+ * clock per task, so a listing is internally consistent and costs one
+ * clock read. `--as-of <date>` replaces the sample with a fixed instant.
+ */
+
+#ifndef EVAL_CONTEXT_HPP
+#define EVAL_CONTEXT_HPP
+
+#include <chrono>
+
+/**
+ * @struct EvalContext
+ * @brief One clock sample plus the local midnight that starts its day
+ */
+struct EvalContext {
+    std::chrono::system_clock::time_point now;    ///< Instant overdue checks compare against
+    std::chrono::system_clock::time_point today;  ///< Local midnight at the start of now's day
+
+    /**
+     * @brief Build a context for a fixed instant
+     * @param instant Point in time to evaluate at
+     * @return Context with today derived through the local TimeZone
+     */
+    [[nodiscard]] static EvalContext at(std::chrono::system_clock::time_point instant);
+
+    [[nodiscard]] static EvalContext current();   ///< Build a context from one clock sample
+
+    /**
+     * @brief Count local calendar days from today to an instant's day
+     * @param instant Point in time to measure to
+     * @return Whole days (negative for earlier days)
+     */
+    [[nodiscard]] std::chrono::days daysUntil(std::chrono::system_clock::time_point instant) const;
+};
+
+#endif // EVAL_CONTEXT_HPP
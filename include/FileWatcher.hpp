@@ -0,0 +1,53 @@
+/**
+ * @file FileWatcher.hpp
+ * @brief Blocking wait for file changes in a directory (Linux inotify)
+ *
+ * Writers in this application replace files by renaming a temporary over
+ * them, or append and close them, so the watch is placed on the directory
+ * and reports completed writes, renames into it and deletions. Waiting
+ * blocks in poll() and costs nothing while nothing changes.
+ */
+
+#ifndef FILE_WATCHER_HPP
+#define FILE_WATCHER_HPP
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <set>
+#include <string>
+
+/**
+ * @class FileWatcher
+ * @brief inotify watch on one directory
+ */
+class FileWatcher {
+public:
+    /**
+     * @brief Start watching a directory
+     * @param directory Directory to watch (the current directory if empty)
+     * @throws std::runtime_error if inotify is unavailable or the directory cannot be watched
+     */
+    explicit FileWatcher(const std::filesystem::path& directory);
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * @brief Block until files in the directory change
+     * @param settle Quiet period used to coalesce a burst of events into one batch
+     * @return Names of the files that changed (an empty name means events were
+     *         lost and anything may have changed), or nullopt if a signal
+     *         interrupted the wait
+     * @throws std::runtime_error if the watch fails
+     */
+    [[nodiscard]] std::optional<std::set<std::string>> wait(std::chrono::milliseconds settle = std::chrono::milliseconds(50));
+
+private:
+    int fd_ = -1;   ///< inotify instance
+
+    bool drain(std::set<std::string>& names);  ///< Read pending events; false if interrupted
+};
+
+#endif // FILE_WATCHER_HPP
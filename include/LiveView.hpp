@@ -0,0 +1,64 @@
+/**
+ * @file LiveView.hpp
+ * @brief Full-screen text view that repaints only the lines that changed
+ *
+ * Each frame is a block of text. The view remembers the last frame it drew
+ * and, for the next one, moves the cursor only to rows whose text differs,
+ * rewrites them and clears what is left of the line. Unchanged rows cost
+ * nothing, so updating one task in a table redraws one line.
+ */
+
+#ifndef LIVE_VIEW_HPP
+#define LIVE_VIEW_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class LiveView
+ * @brief Incrementally redrawn terminal screen
+ */
+class LiveView {
+public:
+    /**
+     * @brief Take over the screen (hides the cursor; the first draw clears it)
+     */
+    LiveView();
+
+    /**
+     * @brief Restore the cursor below the last frame
+     */
+    ~LiveView();
+
+    LiveView(const LiveView&) = delete;
+    LiveView& operator=(const LiveView&) = delete;
+
+    /**
+     * @brief Get the terminal height
+     * @return Rows on the controlling terminal (24 if stdout is not a terminal)
+     */
+    [[nodiscard]] static size_t terminalRows();
+
+    /**
+     * @brief Show a frame, rewriting only lines that differ from the previous one
+     * @param frame Text to show; lines past the bottom of the terminal are dropped
+     * @return Bytes written to the terminal
+     */
+    size_t draw(std::string_view frame);
+
+    /**
+     * @brief Forget the previous frame so the next draw repaints everything
+     *
+     * Used after the terminal is resized.
+     */
+    void invalidate();
+
+private:
+    std::vector<std::string> lines_;    ///< Lines of the frame currently on screen
+    size_t cursorRow_ = 0;              ///< Row the cursor is on (0-based)
+    bool clearPending_ = true;          ///< Whether the next draw starts from a cleared screen
+};
+
+#endif // LIVE_VIEW_HPP
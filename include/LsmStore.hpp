@@ -0,0 +1,225 @@
+/**
+ * @file LsmStore.hpp
+ * @brief Log-structured change tiers layered on top of the task snapshot
+ *
+ * Mutations are not written into the snapshot directly. They go through
+ * three tiers, newest first:
+ * - Memtable: the write-ahead log (<stem>.journal), replayed into memory
+ *   on demand. Every put or delete is appended and fsynced here first.
+ * - Runs: immutable, id-sorted files (<stem>.run-NNNNNN) produced when the
+ *   memtable fills up. Runs are merged together when too many accumulate.
+ * - Base: the snapshot file itself (JSON, compressed or binary).
+ *
+ * A checkpoint (full snapshot rewrite) is the major compaction. It folds all
+ * runs and the memtable into the base and drops tombstones. Run membership
+ * and lifetime I/O counters live in a small manifest (<stem>.lsm.json).
+ */
+
+#ifndef LSM_STORE_HPP
+#define LSM_STORE_HPP
+
+#include "Task.hpp"
+#include "TaskStorage.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @class LsmStore
+ * @brief Write-ahead log, memtable and sorted runs for one data file
+ */
+class LsmStore {
+public:
+    static constexpr size_t MEMTABLE_LIMIT = 1024;  ///< Memtable records that trigger a flush to a run
+    static constexpr size_t MAX_RUNS = 4;           ///< Runs that trigger a minor (run-to-run) compaction
+
+    /**
+     * @struct RunInfo
+     * @brief Manifest entry for one immutable sorted run
+     */
+    struct RunInfo {
+        std::string file;         ///< File name, relative to the data file's directory
+        uint32_t tasks = 0;       ///< Live task records
+        uint32_t tombstones = 0;  ///< Delete markers
+        uint64_t bytes = 0;       ///< File size
+    };
+
+    /**
+     * @struct Stats
+     * @brief Lifetime write and compaction counters
+     */
+    struct Stats {
+        uint64_t logicalBytes = 0;      ///< Encoded size of the changes callers asked for
+        uint64_t walBytes = 0;          ///< Bytes appended to the write-ahead log
+        uint64_t flushBytes = 0;        ///< Bytes written creating runs from the memtable
+        uint64_t compactionBytes = 0;   ///< Bytes written merging runs
+        uint64_t checkpointBytes = 0;   ///< Bytes written rewriting the base snapshot
+        uint64_t flushes = 0;           ///< Memtable flushes
+        uint64_t compactions = 0;       ///< Minor compactions (run merges)
+        uint64_t checkpoints = 0;       ///< Major compactions (snapshot rewrites)
+        uint64_t tombstonesDropped = 0; ///< Delete markers discarded by checkpoints
+
+        /**
+         * @brief Physical bytes written per logical byte changed
+         * @return Write amplification (0 if nothing has been written yet)
+         */
+        [[nodiscard]] double writeAmplification() const noexcept;
+
+        /**
+         * @brief Merge counters from another store (e.g. another shard)
+         * @param other Counters to add
+         * @return Reference to this object
+         */
+        Stats& operator+=(const Stats& other) noexcept;
+    };
+
+    /**
+     * @struct CheckpointPolicy
+     * @brief Limits on un-checkpointed changes; exceeding any one triggers a checkpoint
+     *
+     * Together these bound how much a full load has to replay on startup.
+     */
+    struct CheckpointPolicy {
+        uint64_t maxBytes = 16ull << 20;    ///< Log plus run bytes
+        uint64_t maxRecords = 50000;        ///< Log plus run records
+        double maxReplayMs = 250.0;         ///< Estimated time to replay the backlog
+    };
+
+    static constexpr double DEFAULT_REPLAY_BYTES_PER_SECOND = 30e6; ///< Replay rate assumed before one is measured
+
+    /**
+     * @struct Backlog
+     * @brief Changes a full load would replay on top of the base
+     */
+    struct Backlog {
+        uint64_t bytes = 0;     ///< Log plus run bytes
+        uint64_t records = 0;   ///< Log frames plus run entries
+    };
+
+    /**
+     * @struct ReplayReport
+     * @brief What one replay applied and how long it took
+     */
+    struct ReplayReport {
+        uint64_t records = 0;   ///< Records applied (puts and tombstones)
+        uint64_t bytes = 0;     ///< Log and run bytes read
+        double seconds = 0.0;   ///< Time spent replaying
+
+        ReplayReport& operator+=(const ReplayReport& other) noexcept; ///< Merge another shard's replay
+    };
+
+    /**
+     * @brief Open the tiers that belong to a data file
+     * @param dataFile Base snapshot path
+     *
+     * Only the manifest is read here; the memtable is replayed on first use.
+     */
+    explicit LsmStore(std::filesystem::path dataFile);
+
+    // ==============
+    // Writes
+    // ==============
+
+    /**
+     * @brief Durably record new task states and deletions
+     * @param puts Tasks whose current state supersedes older versions
+     * @param deletes IDs of removed tasks (written as tombstones)
+     * @throws std::runtime_error if the log, a run or the manifest cannot be written
+     *
+     * Flushes the memtable to a run when it reaches MEMTABLE_LIMIT, and
+     * merges runs when there are more than MAX_RUNS.
+     */
+    void write(std::span<const Task* const> puts, std::span<const int> deletes = {});
+
+    /**
+     * @brief Write the memtable out as a sorted run and clear the log
+     */
+    void flush();
+
+    /**
+     * @brief Merge every run into one (tombstones are kept; the base may still hold those IDs)
+     */
+    void compactRuns();
+
+    /**
+     * @brief Record that the base snapshot now contains every tier
+     * @param snapshotBytes Size of the snapshot just written
+     *
+     * Drops runs, the log and their tombstones, then updates the counters.
+     */
+    void checkpointed(uint64_t snapshotBytes);
+
+    /**
+     * @brief Delete the log, runs and manifest without folding them anywhere
+     *
+     * Used when the base snapshot is being retired (e.g. by a reshard).
+     */
+    void discard();
+
+    // ==============
+    // Reads
+    // ==============
+
+    /**
+     * @brief Apply runs (oldest first) and then the memtable to loaded base tasks
+     * @param tasks Base tasks in storage order; updated in place
+     * @param nextId Raised past every ID seen in the tiers
+     * @return Records applied, bytes read and elapsed time
+     */
+    ReplayReport replay(std::vector<std::unique_ptr<Task>>& tasks, int& nextId) const;
+
+    /**
+     * @brief Find one task, newest tier first, without loading the base
+     * @param id Task identifier
+     * @return Lookup result (a tombstone reports the task as absent)
+     */
+    [[nodiscard]] TaskStorage::RecordLookup lookup(int id) const;
+
+    // ==============
+    // Introspection
+    // ==============
+
+    [[nodiscard]] Stats stats() const;                                  ///< Get lifetime counters (including the current log)
+    [[nodiscard]] const std::vector<RunInfo>& runs() const noexcept;    ///< Get runs, oldest first
+    [[nodiscard]] size_t memtableSize() const;                          ///< Get distinct IDs in the memtable
+    [[nodiscard]] bool empty() const;                                   ///< Check whether the base is fully up to date
+    [[nodiscard]] Backlog backlog() const;                              ///< Get what a full load would replay
+
+    /**
+     * @brief Check the backlog against a checkpoint policy
+     * @param policy Limits to apply
+     * @param bytesPerSecond Replay rate used to estimate replay time
+     * @return Description of the first limit exceeded, or nullopt if none is
+     */
+    [[nodiscard]] std::optional<std::string> checkpointReason(const CheckpointPolicy& policy, double bytesPerSecond) const;
+
+private:
+    using Record = std::optional<Task>; ///< Task state, or nullopt for a tombstone
+
+    std::filesystem::path dataFile_;                ///< Base snapshot path
+    std::filesystem::path walFile_;                 ///< Write-ahead log path
+    std::filesystem::path manifestFile_;            ///< Run list and counters
+    std::vector<RunInfo> runs_;                     ///< Runs, oldest first
+    uint64_t nextRun_ = 1;                          ///< Sequence number for the next run file
+    Stats stats_;                                   ///< Counters for data no longer in the log
+
+    mutable std::optional<std::map<int, Record>> memtable_; ///< Latest record per ID from the log (loaded lazily)
+    mutable uint64_t walLogicalBytes_ = 0;          ///< Logical bytes in the current log
+    mutable uint64_t walBytes_ = 0;                 ///< Physical bytes in the current log
+    mutable uint64_t walRecords_ = 0;               ///< Frames in the current log
+    mutable bool walTorn_ = false;                  ///< Replay stopped before the end; cut the log at walBytes_ before appending
+
+    std::map<int, Record>& memtable() const;        ///< Replay the log on first access
+    void saveManifest() const;                      ///< Atomically rewrite the manifest
+    [[nodiscard]] std::filesystem::path runPath(const RunInfo& run) const;  ///< Resolve a run file
+    RunInfo writeRun(const std::map<int, Record>& records);                 ///< Write records as a new run
+};
+
+#endif // LSM_STORE_HPP
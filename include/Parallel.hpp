@@ -0,0 +1,129 @@
+/**
+ * @file Parallel.hpp
+ * @brief Minimal fork/join helpers for data-parallel work over task collections
+ *
+ * Provides the small set of primitives the bulk paths need without pulling in
+ * an external threading library:
+ * - Worker count selection with a per-worker minimum batch size
+ * - Contiguous chunk fan-out with exception propagation
+ * - Parallel merge sort built on chunk-local std::sort and pairwise merges
+ */
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace Parallel {
+
+    /**
+     * @brief Choose how many workers to use for a batch of items
+     * @param items Number of items to process
+     * @param minItemsPerWorker Smallest batch worth handing to a separate thread
+     * @return Worker count in [1, hardware_concurrency]
+     *
+     * Small inputs stay on the calling thread so short commands never pay
+     * for thread creation.
+     */
+    [[nodiscard]] inline size_t workerCount(size_t items, size_t minItemsPerWorker = 4096) noexcept {
+        size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        size_t wanted = items / std::max<size_t>(minItemsPerWorker, 1);
+        return std::clamp<size_t>(wanted, 1, hardware);
+    }
+
+    /**
+     * @brief Run fn(worker, begin, end) over contiguous chunks of [0, count)
+     * @param count Total number of items
+     * @param workers Number of chunks (chunk 0 runs on the calling thread)
+     * @param fn Callable invoked once per chunk
+     *
+     * Chunks are as equal as possible and ordered by worker index, so
+     * callers can concatenate per-worker output to preserve input order.
+     * The first exception thrown by any worker is rethrown after all join.
+     */
+    template<typename Fn>
+    void forEachChunk(size_t count, size_t workers, Fn&& fn) {
+        workers = std::clamp<size_t>(workers, 1, std::max<size_t>(count, 1));
+        if (workers == 1) {
+            fn(size_t{ 0 }, size_t{ 0 }, count);
+            return;
+        }
+
+        std::vector<std::exception_ptr> errors(workers);
+        auto chunkBegin = [count, workers](size_t w) { return count * w / workers; };
+        auto runChunk = [&](size_t w) {
+            try {
+                fn(w, chunkBegin(w), chunkBegin(w + 1));
+            }
+            catch (...) {
+                errors[w] = std::current_exception();
+            }
+            };
+
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(workers - 1);
+            for (size_t w = 1; w < workers; ++w) {
+                threads.emplace_back(runChunk, w);
+            }
+            runChunk(0);
+        } // jthreads join here
+
+        for (const auto& error : errors) {
+            if (error) std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * @brief Sort a vector using all cores for large inputs
+     * @param items Vector to sort in place
+     * @param comp Strict weak ordering
+     * @param minItemsPerWorker Batch size below which the sort stays serial
+     *
+     * Each worker sorts one contiguous run, then runs are merged pairwise in
+     * parallel rounds until a single run remains. Not stable across runs.
+     */
+    template<typename T, typename Compare = std::less<>>
+    void sort(std::vector<T>& items, Compare comp = {}, size_t minItemsPerWorker = 16384) {
+        const size_t count = items.size();
+        const size_t workers = workerCount(count, minItemsPerWorker);
+        if (workers == 1) {
+            std::sort(items.begin(), items.end(), comp);
+            return;
+        }
+
+        // Run boundaries match forEachChunk's split so they can be merged later
+        std::vector<size_t> bounds(workers + 1);
+        for (size_t w = 0; w <= workers; ++w) {
+            bounds[w] = count * w / workers;
+        }
+
+        forEachChunk(count, workers, [&](size_t, size_t begin, size_t end) {
+            std::sort(items.begin() + begin, items.begin() + end, comp);
+            });
+
+        // Pairwise merge rounds: run i absorbs run i + width
+        for (size_t width = 1; width < workers; width *= 2) {
+            const size_t merges = (workers + 2 * width - 1) / (2 * width);
+            forEachChunk(merges, merges, [&](size_t, size_t first, size_t last) {
+                for (size_t m = first; m < last; ++m) {
+                    size_t left = m * 2 * width;
+                    size_t mid = std::min(left + width, workers);
+                    size_t right = std::min(left + 2 * width, workers);
+                    if (mid < right) {
+                        std::inplace_merge(items.begin() + bounds[left], items.begin() + bounds[mid],
+                            items.begin() + bounds[right], comp);
+                    }
+                }
+                });
+        }
+    }
+
+} // namespace Parallel
+
+#endif // PARALLEL_HPP
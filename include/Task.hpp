@@ -12,9 +12,12 @@
 
 #include <string>
 #include <chrono>
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <string_view>
 #include <vector>
+#include "EvalContext.hpp"
 #include "json.hpp"
 
  /**
@@ -37,6 +40,39 @@ enum class TaskPriority : int {
     HIGH = 3    ///< High importance task - urgent
 };
 
+/**
+ * @struct TaskColdFields
+ * @brief Task fields that listing, overdue and statistics commands never read
+ */
+struct TaskColdFields {
+    std::string description;                                           ///< Detailed description
+    std::vector<std::string> tags;                                     ///< Tag list
+    std::optional<std::chrono::system_clock::time_point> completed_at; ///< Completion timestamp
+};
+
+/**
+ * @class ColdFieldSource
+ * @brief Storage backend that can decode a task's cold fields on demand
+ *
+ * Implemented by snapshot readers that keep the file mapped, so a task only
+ * pays for its description and tags when something actually reads them.
+ */
+class ColdFieldSource {
+public:
+    virtual ~ColdFieldSource() = default;
+
+    /**
+     * @brief Decode one task's cold record
+     * @param offset Record offset within the source
+     * @param length Record length in bytes
+     * @return Decoded fields
+     * @throws std::runtime_error if the record is corrupt
+     */
+    [[nodiscard]] virtual TaskColdFields load(uint64_t offset, uint32_t length) const = 0;
+};
+
+class TaskSchema;
+
 /**
  * @class Task
  * @brief Core task entity with comprehensive functionality
@@ -49,6 +85,8 @@ enum class TaskPriority : int {
  * - JSON serialization for persistence
  */
 class Task {
+    friend class TaskSchema; ///< Field table and generated codecs (TaskSchema.hpp)
+
 private:
     // Core task properties
     int id;                          ///< Unique identifier for the task
@@ -58,12 +96,28 @@ private:
 
     // Timestamp management
     std::chrono::system_clock::time_point created_at;                           ///< When the task was created
-    std::optional<std::chrono::system_clock::time_point> completed_at;          ///< When the task was completed (if applicable)
+    mutable std::optional<std::chrono::system_clock::time_point> completed_at;  ///< When the task was completed (cold, may be lazy)
     std::optional<std::chrono::system_clock::time_point> due_date;              ///< When the task is due (optional)
 
-    // Additional metadata
-    std::string description;         ///< Detailed description of the task
-    std::vector<std::string> tags;   ///< List of tags for categorization
+    // Additional metadata (cold fields, may be decoded lazily)
+    mutable std::string description;         ///< Detailed description of the task
+    mutable std::vector<std::string> tags;   ///< List of tags for categorization
+
+    // Lazy cold field state: set only for tasks loaded from a mapped snapshot
+    mutable std::shared_ptr<const ColdFieldSource> cold_source; ///< Where undecoded cold fields live (null once decoded)
+    uint64_t cold_offset = 0;                                   ///< Cold record offset in the source
+    uint32_t cold_length = 0;                                   ///< Cold record length in bytes
+
+    void ensureColdFields() const;   ///< Decode cold fields on first access
+
+    // Content hash: a sum of per-field terms, so a setter swaps one term instead of rehashing the task.
+    // Values are positions in TaskSchema::fields.
+    enum class Field : uint8_t { Id, Name, Status, Priority, CreatedAt, Description, Tags, CompletedAt, DueDate };
+    mutable std::optional<uint64_t> content_hash;   ///< Cached content hash (nullopt until first requested)
+
+    [[nodiscard]] uint64_t fieldHash(Field field) const; ///< Hash one field as persisted
+    void retractField(Field field);                      ///< Remove a field's term before the field changes
+    void restoreField(Field field);                      ///< Add the field's term back after it changed
 
 public:
     // ===========================
@@ -97,10 +151,20 @@ public:
     [[nodiscard]] TaskStatus getStatus() const noexcept;                                                      ///< Get task status
     [[nodiscard]] TaskPriority getPriority() const noexcept;                                                  ///< Get task priority
     [[nodiscard]] const std::chrono::system_clock::time_point& getCreatedAt() const noexcept;                ///< Get creation timestamp
-    [[nodiscard]] const std::optional<std::chrono::system_clock::time_point>& getCompletedAt() const noexcept; ///< Get completion timestamp
+    [[nodiscard]] const std::optional<std::chrono::system_clock::time_point>& getCompletedAt() const;         ///< Get completion timestamp (may decode cold fields)
     [[nodiscard]] const std::optional<std::chrono::system_clock::time_point>& getDueDate() const noexcept;    ///< Get due date
-    [[nodiscard]] const std::string& getDescription() const noexcept;                                         ///< Get task description
-    [[nodiscard]] const std::vector<std::string>& getTags() const noexcept;                                   ///< Get list of tags
+    [[nodiscard]] const std::string& getDescription() const;                                                  ///< Get task description (may decode cold fields)
+    [[nodiscard]] const std::vector<std::string>& getTags() const;                                            ///< Get list of tags (may decode cold fields)
+    [[nodiscard]] bool hasColdFieldsLoaded() const noexcept;                                                  ///< Check whether cold fields are in memory
+
+    /**
+     * @brief Get a 64-bit hash over every persisted field, in toJson() order
+     * @return Hash that changes whenever toJson() would change
+     *
+     * Computed on first use (decoding cold fields if needed) and then kept
+     * current by the setters, which swap only the term of the field they change.
+     */
+    [[nodiscard]] uint64_t contentHash() const;
 
     // =========================
     // Property Setters with Validation
@@ -128,8 +192,8 @@ public:
     [[nodiscard]] std::string getPriorityString() const;    ///< Get human-readable priority
     [[nodiscard]] std::string getFormattedCreatedAt() const; ///< Get formatted creation date
     [[nodiscard]] std::string getFormattedDueDate() const;  ///< Get formatted due date
-    [[nodiscard]] bool isOverdue() const;                   ///< Check if task is past due date
-    [[nodiscard]] std::chrono::days getDaysUntilDue() const; ///< Get days until due (can be negative)
+    [[nodiscard]] bool isOverdue(const EvalContext& context) const;                  ///< Check if task is past due at context.now
+    [[nodiscard]] std::chrono::days getDaysUntilDue(const EvalContext& context) const; ///< Get calendar days until due (can be negative)
 
     // ==================
     // Convenience Methods
@@ -145,12 +209,50 @@ public:
     [[nodiscard]] nlohmann::json toJson() const;            ///< Convert task to JSON for persistence
     static Task fromJson(const nlohmann::json& j);          ///< Create task from JSON data
 
+    /**
+     * @brief Create a task from already validated fields, keeping its timestamps
+     * @param id Task identifier
+     * @param name Task name (must not be empty)
+     * @param status Task status
+     * @param priority Task priority
+     * @param created_at Creation timestamp
+     * @param completed_at Optional completion timestamp
+     * @param due_date Optional due date
+     * @param description Description
+     * @param tags Tags (assumed free of duplicates)
+     * @return Task built without going through JSON
+     * @throws std::invalid_argument if name is empty
+     */
+    static Task fromFields(int id, std::string_view name, TaskStatus status, TaskPriority priority,
+        std::chrono::system_clock::time_point created_at,
+        const std::optional<std::chrono::system_clock::time_point>& completed_at,
+        const std::optional<std::chrono::system_clock::time_point>& due_date,
+        std::string description, std::vector<std::string> tags);
+
+    /**
+     * @brief Create a task from hot fields, deferring cold fields to a source
+     * @param id Task identifier
+     * @param name Task name
+     * @param status Task status
+     * @param priority Task priority
+     * @param created_at Creation timestamp
+     * @param due_date Optional due date
+     * @param source Decoder for the cold record (kept alive by the task)
+     * @param offset Cold record offset within the source
+     * @param length Cold record length
+     * @return Task whose description, tags and completion time decode on first access
+     */
+    static Task fromHotFields(int id, std::string_view name, TaskStatus status, TaskPriority priority,
+        std::chrono::system_clock::time_point created_at,
+        const std::optional<std::chrono::system_clock::time_point>& due_date,
+        std::shared_ptr<const ColdFieldSource> source, uint64_t offset, uint32_t length);
+
     // =================
     // Display Methods
     // =================
 
-    [[nodiscard]] std::string toString() const;             ///< Get compact string representation
-    [[nodiscard]] std::string toDetailedString() const;     ///< Get detailed string representation
+    [[nodiscard]] std::string toString(const EvalContext& context) const;         ///< Get compact string representation
+    [[nodiscard]] std::string toDetailedString(const EvalContext& context) const; ///< Get detailed string representation
 
     // ==================
     // Comparison Operators
@@ -4,6 +4,17 @@
 #include "Task.hpp"
 #include <ranges>
 #include <concepts>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 // Phase 2 optimization: Modern C++ ranges and concepts for efficient filtering
 namespace TaskFilters {
@@ -41,13 +52,13 @@ namespace TaskFilters {
                 });
     }
 
-    // Overdue tasks with critical priority
+    // Overdue tasks with critical priority, as of the context's instant
     template<TaskContainer Container>
-    auto getCriticalOverdueTasks(const Container& tasks) {
+    auto getCriticalOverdueTasks(const Container& tasks, const EvalContext& context) {
         return tasks
-            | std::views::filter([](const auto& task_ptr) {
+            | std::views::filter([context](const auto& task_ptr) {
             const Task& task = getTaskRef(task_ptr);
-            return task.isOverdue() && task.getPriority() == TaskPriority::HIGH;
+            return task.isOverdue(context) && task.getPriority() == TaskPriority::HIGH;
                 });
     }
 
@@ -64,17 +75,137 @@ namespace TaskFilters {
                 });
     }
 
-    // Completion rate calculation using ranges
+    // Every status, priority and overdue counter, produced by one fused pass
+    struct TaskCounts {
+        size_t total = 0;
+        std::array<size_t, 3> by_status{};      // Indexed by TaskStatus - 1
+        std::array<size_t, 3> by_priority{};    // Indexed by TaskPriority - 1
+        size_t overdue = 0;
+
+        [[nodiscard]] size_t status(TaskStatus s) const noexcept { return by_status[static_cast<size_t>(s) - 1]; }
+        [[nodiscard]] size_t priority(TaskPriority p) const noexcept { return by_priority[static_cast<size_t>(p) - 1]; }
+
+        // Fold in one task; for paths that see tasks one at a time (streams, hash groups)
+        void add(const Task& task, const EvalContext& context) noexcept {
+            ++total;
+            ++by_status[static_cast<size_t>(task.getStatus()) - 1];
+            ++by_priority[static_cast<size_t>(task.getPriority()) - 1];
+            overdue += task.isOverdue(context) ? 1 : 0;
+        }
+
+        TaskCounts& operator+=(const TaskCounts& other) noexcept {
+            total += other.total;
+            for (size_t i = 0; i < by_status.size(); ++i) by_status[i] += other.by_status[i];
+            for (size_t i = 0; i < by_priority.size(); ++i) by_priority[i] += other.by_priority[i];
+            overdue += other.overdue;
+            return *this;
+        }
+    };
+
+    namespace detail {
+
+        // Tasks are gathered into columns one block at a time; a block's matches fit one 64-bit mask
+        constexpr size_t kBlock = 64;
+
+        struct ColumnBlock {
+            alignas(32) std::array<uint8_t, kBlock> status{};      // 0 in unused slots (matches no status)
+            alignas(32) std::array<uint8_t, kBlock> priority{};    // 0 in unused slots
+            alignas(32) std::array<int64_t, kBlock> due{};         // Clock ticks; INT64_MAX when undated or unused
+        };
+
+        // Bit i set where column[i] == value
+        inline uint64_t matchMask(const std::array<uint8_t, kBlock>& column, uint8_t value) noexcept {
+            uint64_t mask = 0;
+#if defined(__SSE2__)
+            const __m128i needle = _mm_set1_epi8(static_cast<char>(value));
+            for (size_t i = 0; i < kBlock; i += 16) {
+                __m128i chunk = _mm_load_si128(reinterpret_cast<const __m128i*>(column.data() + i));
+                auto bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+                mask |= static_cast<uint64_t>(bits) << i;
+            }
+#else
+            for (size_t i = 0; i < kBlock; ++i) {
+                mask |= static_cast<uint64_t>(column[i] == value) << i;
+            }
+#endif
+            return mask;
+        }
+
+        // Bit i set where due[i] < now
+        inline uint64_t pastMask(const std::array<int64_t, kBlock>& due, int64_t now) noexcept {
+            uint64_t mask = 0;
+#if defined(__AVX2__)
+            const __m256i instant = _mm256_set1_epi64x(now);
+            for (size_t i = 0; i < kBlock; i += 4) {
+                __m256i chunk = _mm256_load_si256(reinterpret_cast<const __m256i*>(due.data() + i));
+                auto bits = static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(instant, chunk))));
+                mask |= static_cast<uint64_t>(bits) << i;
+            }
+#else
+            for (size_t i = 0; i < kBlock; ++i) {
+                mask |= static_cast<uint64_t>(now > due[i]) << i;
+            }
+#endif
+            return mask;
+        }
+
+        // All counters for one block: compares build masks, popcounts turn them into counts
+        inline void countBlock(const ColumnBlock& block, size_t used, int64_t now, TaskCounts& counts) noexcept {
+            counts.total += used;
+            uint64_t completed = 0;
+            for (uint8_t s = 1; s <= 3; ++s) {
+                uint64_t mask = matchMask(block.status, s);
+                counts.by_status[s - 1] += static_cast<size_t>(std::popcount(mask));
+                if (s == static_cast<uint8_t>(TaskStatus::COMPLETED)) completed = mask;
+            }
+            for (uint8_t p = 1; p <= 3; ++p) {
+                counts.by_priority[p - 1] += static_cast<size_t>(std::popcount(matchMask(block.priority, p)));
+            }
+            counts.overdue += static_cast<size_t>(std::popcount(pastMask(block.due, now) & ~completed));
+        }
+
+    } // namespace detail
+
+    // Fused counters in a single pass; same results as isOverdue()/getStatus()/getPriority() per task
+    template<TaskContainer Container>
+    TaskCounts countTasks(const Container& tasks, const EvalContext& context) {
+        TaskCounts counts;
+        const int64_t now = context.now.time_since_epoch().count();
+
+        detail::ColumnBlock block;
+        size_t used = 0;
+        auto flush = [&] {
+            detail::countBlock(block, used, now, counts);
+            block.status.fill(0);
+            block.priority.fill(0);
+            block.due.fill(std::numeric_limits<int64_t>::max());
+            used = 0;
+            };
+        block.due.fill(std::numeric_limits<int64_t>::max());
+
+        // getTaskRef resolves the element type (unique_ptr or raw pointer) at compile time
+        for (const auto& task_ptr : tasks) {
+            const Task& task = getTaskRef(task_ptr);
+            block.status[used] = static_cast<uint8_t>(task.getStatus());
+            block.priority[used] = static_cast<uint8_t>(task.getPriority());
+            if (const auto& due = task.getDueDate()) {
+                block.due[used] = due->time_since_epoch().count();
+            }
+            if (++used == detail::kBlock) flush();
+        }
+        if (used > 0) flush();
+        return counts;
+    }
+
+    // Completion rate; status only, so no evaluation instant is needed
     template<TaskContainer Container>
-    constexpr double calculateCompletionRate(const Container& tasks) {
+    double calculateCompletionRate(const Container& tasks) {
         if (std::ranges::empty(tasks)) return 0.0;
 
-        auto completed_count = std::ranges::count_if(tasks, [](const auto& task_ptr) {
-            const Task& task = getTaskRef(task_ptr);
-            return task.getStatus() == TaskStatus::COMPLETED;
+        auto completed = std::ranges::count_if(tasks, [](const auto& task_ptr) {
+            return getTaskRef(task_ptr).getStatus() == TaskStatus::COMPLETED;
             });
-
-        return static_cast<double>(completed_count) / std::ranges::size(tasks);
+        return static_cast<double>(completed) / static_cast<double>(std::ranges::size(tasks));
     }
 
     // Task statistics using ranges algorithms
@@ -86,7 +217,7 @@ namespace TaskFilters {
         size_t overdue_tasks;
         double completion_rate;
 
-        static TaskMetrics calculate(const Container& tasks) {
+        static TaskMetrics calculate(const Container& tasks, const EvalContext& context) {
             TaskMetrics metrics{};
 
             metrics.total_tasks = std::ranges::size(tasks);
@@ -95,20 +226,11 @@ namespace TaskFilters {
                 return metrics;
             }
 
-            metrics.completed_tasks = std::ranges::count_if(tasks, [](const auto& task_ptr) {
-                const Task& task = getTaskRef(task_ptr);
-                return task.getStatus() == TaskStatus::COMPLETED;
-                });
-
-            metrics.high_priority_tasks = std::ranges::count_if(tasks, [](const auto& task_ptr) {
-                const Task& task = getTaskRef(task_ptr);
-                return task.getPriority() == TaskPriority::HIGH;
-                });
-
-            metrics.overdue_tasks = std::ranges::count_if(tasks, [](const auto& task_ptr) {
-                const Task& task = getTaskRef(task_ptr);
-                return task.isOverdue();
-                });
+            // One pass fills every counter
+            auto counts = countTasks(tasks, context);
+            metrics.completed_tasks = counts.status(TaskStatus::COMPLETED);
+            metrics.high_priority_tasks = counts.priority(TaskPriority::HIGH);
+            metrics.overdue_tasks = counts.overdue;
 
             metrics.completion_rate = static_cast<double>(metrics.completed_tasks) / metrics.total_tasks;
 
@@ -0,0 +1,93 @@
+/**
+ * @file TaskImport.hpp
+ * @brief Streaming bulk import from CSV, NDJSON and todo.txt files
+ *
+ * Input is read as a stream of records in blocks. Each block is validated
+ * in parallel, its accepted rows receive one contiguous range of IDs, and
+ * the resulting tasks are held until the end of the input. The store is
+ * then written once (Tasks::bulkLoad) instead of once per task.
+ *
+ * Recognized fields:
+ * - CSV (header row required, names case-insensitive): name or title,
+ *   description or notes, status, priority, due or due_date, tags
+ *   (separated by ';' or ','), created or created_at, completed or
+ *   completed_at. Quoted fields may contain commas, quotes ("") and newlines.
+ * - NDJSON: one object per line with the same keys as the data file
+ *   (status and priority as numbers or names, tags as an array or a
+ *   string, dates as epoch seconds or date strings); "id" is ignored.
+ * - todo.txt: "x" completion marker, completion and creation dates,
+ *   (A)/(B)/(C) priorities, +project and @context tags, due:YYYY-MM-DD.
+ *
+ * Dates accept epoch seconds or anything Utils::parseDate() understands.
+ */
+
+#ifndef TASK_IMPORT_HPP
+#define TASK_IMPORT_HPP
+
+#include "Tasks.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TaskImport {
+
+    /**
+     * @enum Format
+     * @brief Supported input formats
+     */
+    enum class Format {
+        Csv,        ///< Comma-separated values with a header row
+        Ndjson,     ///< One JSON object per line
+        TodoTxt     ///< todo.txt lines
+    };
+
+    [[nodiscard]] std::optional<Format> parseFormat(std::string_view name);          ///< Parse "csv", "ndjson" or "todotxt"
+    [[nodiscard]] std::string_view formatName(Format format) noexcept;               ///< Get the name parseFormat() accepts
+    [[nodiscard]] std::optional<Format> detectFormat(const std::filesystem::path& file); ///< Guess the format from the file extension
+
+    inline constexpr size_t MAX_REJECTIONS = 1000; ///< Rejected rows reported individually
+
+    /**
+     * @struct Rejection
+     * @brief An input row that failed validation
+     */
+    struct Rejection {
+        size_t line = 0;        ///< Line the row starts on (1-based)
+        std::string reason;     ///< What was wrong with it
+    };
+
+    /**
+     * @struct Report
+     * @brief Outcome of an import
+     */
+    struct Report {
+        size_t rows = 0;                    ///< Rows read (excluding a CSV header and blank lines)
+        size_t imported = 0;                ///< Tasks added
+        int firstId = 0;                    ///< First ID assigned (0 if none)
+        int lastId = 0;                     ///< Last ID assigned (0 if none)
+        uint64_t bytes = 0;                 ///< Input bytes read
+        double seconds = 0.0;               ///< Total time, including the final write
+        size_t rejectedRows = 0;            ///< Rows that were skipped
+        std::vector<Rejection> rejected;    ///< The first MAX_REJECTIONS skipped rows, in input order
+
+        [[nodiscard]] double rowsPerSecond() const noexcept; ///< Get input rows processed per second
+    };
+
+    /**
+     * @brief Stream a file into a fully loaded store
+     * @param tasks Destination store
+     * @param file Input file
+     * @param format Input format
+     * @return What was imported and rejected
+     * @throws std::runtime_error if the file cannot be read, the CSV header
+     *         has no name column, or the store cannot be written
+     */
+    [[nodiscard]] Report importFile(Tasks& tasks, const std::filesystem::path& file, Format format);
+
+} // namespace TaskImport
+
+#endif // TASK_IMPORT_HPP
@@ -0,0 +1,75 @@
+/**
+ * @file TaskJson.hpp
+ * @brief JSON codec specialized for task records and JSON snapshots
+ *
+ * Writes and reads the data file's fixed shape directly, without building
+ * nlohmann::json values: the emitter appends each field straight into the
+ * output buffer and the parser assigns each value straight into its Task
+ * member. Both are generated from the TaskSchema field table.
+ *
+ * Output is byte-for-byte what nlohmann::json::dump() (compact) or dump(4)
+ * produces for Task::toJson(): keys in sorted order, the same string
+ * escapes, absent optional timestamps omitted.
+ *
+ * The parser handles well-formed documents of the expected shape. Anything
+ * else (unknown types, fractional numbers, malformed text, invalid UTF-8,
+ * out-of-range values) is handed to the nlohmann path, so errors and
+ * edge cases behave exactly as before. Unknown keys are validated with
+ * nlohmann and ignored, as Task::fromJson() ignores them.
+ */
+
+#ifndef TASK_JSON_HPP
+#define TASK_JSON_HPP
+
+#include "Task.hpp"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TaskJson {
+
+    /**
+     * @brief Append a task as dump(4) would print Task::toJson(), every line prefixed
+     * @param out Destination buffer
+     * @param task Task to write (decodes cold fields)
+     * @param indent Prefix for each line (the element indent inside a snapshot's "tasks" array)
+     * @throws nlohmann::json::type_error if a string is not valid UTF-8 (as dump() does)
+     */
+    void appendPretty(std::string& out, const Task& task, std::string_view indent = {});
+
+    /**
+     * @brief Append a task as dump() would print Task::toJson() (one line, no spaces)
+     * @param out Destination buffer
+     * @param task Task to write (decodes cold fields)
+     * @throws nlohmann::json::type_error if a string is not valid UTF-8 (as dump() does)
+     */
+    void appendCompact(std::string& out, const Task& task);
+
+    /**
+     * @brief Get a task as compact JSON text
+     * @param task Task to write
+     * @return Same text as task.toJson().dump()
+     */
+    [[nodiscard]] std::string dumpCompact(const Task& task);
+
+    /**
+     * @brief Parse one task object
+     * @param text JSON object text
+     * @return Task, as Task::fromJson(nlohmann::json::parse(text)) would build it
+     * @throws Whatever that expression throws for malformed or invalid input
+     */
+    [[nodiscard]] Task parseTask(std::string_view text);
+
+    /**
+     * @brief Parse a JSON snapshot document ({"nextId": n, "tasks": [...]})
+     * @param text Document text
+     * @param nextId Set from "nextId" when present
+     * @return Tasks in document order
+     * @throws Whatever nlohmann::json::parse() and Task::fromJson() throw for invalid input
+     */
+    [[nodiscard]] std::vector<std::unique_ptr<Task>> parseSnapshot(std::string_view text, int& nextId);
+
+} // namespace TaskJson
+
+#endif // TASK_JSON_HPP
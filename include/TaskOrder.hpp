@@ -0,0 +1,116 @@
+/**
+ * @file TaskOrder.hpp
+ * @brief Persistent display order of a task collection
+ *
+ * Keeps tasks in list order (priority high to low, then due date with
+ * undated tasks last, then creation time, then ID) in an order-statistic
+ * treap. Adding, removing or re-keying one task costs O(log N) instead of
+ * re-sorting the collection, a listing is an in-order walk, and the
+ * position of any task is found in O(log N) from subtree sizes.
+ *
+ * Nodes live in one vector and link by index, so the structure is a few
+ * flat allocations regardless of size; erased slots are reused.
+ */
+
+#ifndef TASK_ORDER_HPP
+#define TASK_ORDER_HPP
+
+#include "Task.hpp"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class TaskOrder
+ * @brief Order-statistic index over tasks in display order
+ */
+class TaskOrder {
+public:
+    /**
+     * @struct Key
+     * @brief A task's sort fields, packed so comparison is a few integer compares
+     */
+    struct Key {
+        int priority = 0;       ///< Negated priority, so high sorts first
+        int64_t due = 0;        ///< Due date ticks (INT64_MAX when unset, so undated sorts last)
+        int64_t created = 0;    ///< Creation ticks
+        int id = 0;             ///< Tie-breaker making every key unique
+
+        auto operator<=>(const Key&) const = default;
+    };
+
+    [[nodiscard]] static Key keyOf(const Task& task) noexcept;  ///< Get the key that places a task
+
+    /**
+     * @brief Replace the index with the given tasks
+     * @param tasks Every task in the collection
+     *
+     * Sorts once and builds the tree bottom-up in linear time.
+     */
+    void rebuild(std::span<const std::unique_ptr<Task>> tasks);
+
+    void insert(Task* task);          ///< Add a task not yet in the index
+    void update(Task* task);          ///< Re-place a task whose sort fields may have changed (inserts if absent)
+    void erase(int id);               ///< Remove a task by ID (no-op if absent)
+    void clear() noexcept;            ///< Remove every task
+
+    /**
+     * @brief Get a task's zero-based position in display order
+     * @param id Task identifier
+     * @return Position, or nullopt if the task is not indexed
+     */
+    [[nodiscard]] std::optional<size_t> position(int id) const;
+
+    /**
+     * @brief Visit tasks in display order until the visitor returns false
+     * @param visit Called with each task; return false to stop
+     */
+    template<typename Visitor>
+    void forEach(Visitor&& visit) const {
+        std::vector<uint32_t> stack;
+        uint32_t node = root_;
+        while (node != kNil || !stack.empty()) {
+            while (node != kNil) {
+                stack.push_back(node);
+                node = nodes_[node].left;
+            }
+            node = stack.back();
+            stack.pop_back();
+            if (!visit(nodes_[node].task)) return;
+            node = nodes_[node].right;
+        }
+    }
+
+    [[nodiscard]] std::vector<Task*> ordered() const;       ///< Get every task in display order
+    [[nodiscard]] size_t size() const noexcept;             ///< Get the number of indexed tasks
+
+private:
+    static constexpr uint32_t kNil = 0;  ///< Slot 0 is a sentinel with size 0
+
+    struct Node {
+        Key key;
+        Task* task = nullptr;
+        uint32_t left = kNil;
+        uint32_t right = kNil;
+        uint32_t size = 0;      ///< Nodes in this subtree
+        uint32_t weight = 0;    ///< Random heap priority keeping the tree balanced
+    };
+
+    std::vector<Node> nodes_{ Node{} };          ///< Node pool (index 0 is the sentinel)
+    std::vector<uint32_t> free_;                 ///< Erased slots available for reuse
+    std::unordered_map<int, uint32_t> nodeOf_;   ///< Task ID -> node slot
+    uint32_t root_ = kNil;
+    uint64_t seed_ = 0x9E3779B97F4A7C15ull;      ///< xorshift state for node weights
+
+    [[nodiscard]] uint32_t nextWeight() noexcept;
+    [[nodiscard]] uint32_t allocate(Task* task, const Key& key);
+    void pull(uint32_t node) noexcept;                                           ///< Recompute a node's size
+    void split(uint32_t node, const Key& key, uint32_t& less, uint32_t& rest);   ///< Split into keys < key and >= key
+    [[nodiscard]] uint32_t merge(uint32_t left, uint32_t right);                 ///< Join trees where left < right
+    [[nodiscard]] uint32_t eraseKey(uint32_t node, const Key& key);              ///< Unlink the node holding key
+};
+
+#endif // TASK_ORDER_HPP
@@ -0,0 +1,96 @@
+/**
+ * @file TaskReport.hpp
+ * @brief Grouped task metrics ("report --group-by tag,status --metrics count,overdue")
+ *
+ * Aggregates any combination of grouping dimensions in one pass over the
+ * tasks. Each worker fills its own hash table keyed by the packed group
+ * key, so the pass needs no locks; the partial tables are merged once at
+ * the end. A task with several tags counts once in each of its tag groups.
+ */
+
+#ifndef TASK_REPORT_HPP
+#define TASK_REPORT_HPP
+
+#include "EvalContext.hpp"
+#include "TaskFilters.hpp"
+#include "Task.hpp"
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TaskReport {
+
+    /// @brief A field tasks can be grouped by
+    enum class Dimension : uint8_t {
+        Tag,        ///< Each of the task's tags ("(none)" when untagged)
+        Status,     ///< Task status
+        Priority,   ///< Task priority (high first)
+        DueWeek     ///< ISO week of the due date in local time, e.g. 2025-W23 ("(none)" when undated)
+    };
+
+    /// @brief A per-group value the report shows
+    enum class Metric : uint8_t {
+        Count,      ///< Tasks in the group
+        Overdue,    ///< Tasks past due at the evaluation instant
+        Completed,  ///< Completed tasks
+        AvgAge      ///< Mean days since creation at the evaluation instant
+    };
+
+    /**
+     * @struct Totals
+     * @brief Accumulated metrics for one group
+     */
+    struct Totals {
+        TaskFilters::TaskCounts counts;     ///< Count, status and overdue counters
+        int64_t ageSeconds = 0;             ///< Sum of task ages
+
+        void add(const Task& task, const EvalContext& context) noexcept;
+        Totals& operator+=(const Totals& other) noexcept;
+
+        [[nodiscard]] double averageAgeDays() const noexcept;  ///< Mean age in days (0 for empty groups)
+    };
+
+    /**
+     * @struct Row
+     * @brief One group and its metrics
+     */
+    struct Row {
+        std::vector<std::string> labels;    ///< One label per grouping dimension
+        Totals totals;
+    };
+
+    /**
+     * @brief Parse a comma-separated dimension list such as "tag,status"
+     * @param spec Names from dimensionNames()
+     * @return Dimensions in order, or nullopt for empty, unknown or repeated names
+     */
+    [[nodiscard]] std::optional<std::vector<Dimension>> parseDimensions(std::string_view spec);
+
+    /**
+     * @brief Parse a comma-separated metric list such as "count,overdue,avg_age"
+     * @param spec Names from metricNames()
+     * @return Metrics in order, or nullopt for empty, unknown or repeated names
+     */
+    [[nodiscard]] std::optional<std::vector<Metric>> parseMetrics(std::string_view spec);
+
+    [[nodiscard]] std::string_view dimensionNames() noexcept;        ///< Get accepted dimension names for help text
+    [[nodiscard]] std::string_view metricNames() noexcept;           ///< Get accepted metric names for help text
+    [[nodiscard]] std::string_view dimensionName(Dimension dimension) noexcept;  ///< Get a dimension's column title
+    [[nodiscard]] std::string_view metricName(Metric metric) noexcept;           ///< Get a metric's column title
+
+    /**
+     * @brief Group tasks and accumulate metrics per group
+     * @param tasks Tasks to aggregate
+     * @param groupBy Grouping dimensions, most significant first
+     * @param context Instant overdue state and ages are evaluated at
+     * @return Rows sorted by group (status and priority in display order, undated and untagged last)
+     */
+    [[nodiscard]] std::vector<Row> aggregate(std::span<const Task* const> tasks,
+        const std::vector<Dimension>& groupBy, const EvalContext& context);
+
+} // namespace TaskReport
+
+#endif // TASK_REPORT_HPP
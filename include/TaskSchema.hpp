@@ -0,0 +1,168 @@
+/**
+ * @file TaskSchema.hpp
+ * @brief Compile-time description of Task's persisted fields
+ *
+ * Every codec that walks a task field by field is generated from the one
+ * table below instead of repeating the field list: the JSON object codec,
+ * the binary field encoding behind content hashes, the CSV writer and the
+ * field-level diff. The table is a tuple of member pointers, so each visit
+ * is expanded at compile time into straight-line code with no runtime
+ * lookups.
+ *
+ * Adding a persisted field means adding a Task member and one table entry;
+ * the order of entries is the order of Task's content hash terms.
+ */
+
+#ifndef TASK_SCHEMA_HPP
+#define TASK_SCHEMA_HPP
+
+#include "Task.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+/**
+ * @class TaskSchema
+ * @brief Field table and the codecs generated from it
+ */
+class TaskSchema {
+public:
+    /**
+     * @enum Kind
+     * @brief How a field's value is encoded
+     */
+    enum class Kind : uint8_t {
+        Integer,        ///< int; JSON number, 4-byte little-endian
+        Text,           ///< std::string; JSON string, raw bytes
+        Status,         ///< TaskStatus; JSON number (1-3), one byte
+        Priority,       ///< TaskPriority; JSON number (1-3), one byte
+        Time,           ///< time_point; epoch seconds, 8-byte little-endian
+        OptionalTime,   ///< optional time_point; omitted (no bytes) when absent
+        TextList        ///< std::vector<std::string>; JSON array, length-prefixed strings
+    };
+
+    /**
+     * @struct Field
+     * @brief One persisted field
+     * @tparam Member Pointer to the Task member holding the value
+     * @tparam K Value encoding
+     */
+    template<auto Member, Kind K>
+    struct Field {
+        std::string_view key;   ///< JSON key and CSV column
+        bool required;          ///< fromJson() fails without it (otherwise the constructor default is kept)
+        bool cold;              ///< Decoded lazily from mapped snapshots (read through ensureColdFields())
+
+        static constexpr auto member = Member;
+        static constexpr Kind kind = K;
+    };
+
+    /// Persisted fields, in content hash order
+    static constexpr auto fields = std::tuple{
+        Field<&Task::id, Kind::Integer>{ "id", true, false },
+        Field<&Task::name, Kind::Text>{ "name", true, false },
+        Field<&Task::status, Kind::Status>{ "status", true, false },
+        Field<&Task::priority, Kind::Priority>{ "priority", true, false },
+        Field<&Task::created_at, Kind::Time>{ "created_at", false, false },
+        Field<&Task::description, Kind::Text>{ "description", false, true },
+        Field<&Task::tags, Kind::TextList>{ "tags", false, true },
+        Field<&Task::completed_at, Kind::OptionalTime>{ "completed_at", false, true },
+        Field<&Task::due_date, Kind::OptionalTime>{ "due_date", false, false },
+    };
+
+    static constexpr size_t FIELD_COUNT = std::tuple_size_v<decltype(fields)>; ///< Number of persisted fields
+    static_assert(FIELD_COUNT <= 32, "changedFields() reports fields as a 32-bit mask");
+
+    /**
+     * @brief Visit every field in table order, expanded at compile time
+     * @param visit Called as visit(field, std::integral_constant<size_t, index>{})
+     */
+    template<typename Visitor>
+    static constexpr void forEach(Visitor&& visit) {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (visit(std::get<I>(fields), std::integral_constant<size_t, I>{}), ...);
+        }(std::make_index_sequence<FIELD_COUNT>{});
+    }
+
+    /**
+     * @brief Get a field's key
+     * @param index Position in the table
+     * @return JSON key (empty if out of range)
+     */
+    [[nodiscard]] static constexpr std::string_view key(size_t index) noexcept {
+        std::string_view found;
+        forEach([&](const auto& field, auto i) { if (i == index) found = field.key; });
+        return found;
+    }
+
+    /**
+     * @brief Find a field by key
+     * @param key JSON key
+     * @return Position in the table, if the key names a field
+     */
+    [[nodiscard]] static constexpr std::optional<size_t> indexOf(std::string_view key) noexcept {
+        std::optional<size_t> found;
+        forEach([&](const auto& field, auto i) { if (field.key == key) found = i; });
+        return found;
+    }
+
+    // ========================
+    // Generated Codecs
+    // ========================
+
+    [[nodiscard]] static nlohmann::json toJson(const Task& task);   ///< Encode every field as a JSON object
+    [[nodiscard]] static Task fromJson(const nlohmann::json& j);    ///< Decode a JSON object (one key lookup per field)
+
+    /**
+     * @brief Append one field's binary encoding (see Kind)
+     * @param out Destination buffer
+     * @param task Task to read (cold fields must already be decoded)
+     * @param index Position in the table
+     */
+    static void encodeField(std::string& out, const Task& task, size_t index);
+
+    /**
+     * @brief Hash one field's binary encoding, seeded by its position
+     * @param task Task to read (cold fields must already be decoded)
+     * @param index Position in the table
+     * @return Term of Task::contentHash()
+     */
+    [[nodiscard]] static uint64_t fieldHash(const Task& task, size_t index);
+
+    /**
+     * @brief Sum every field's hash term
+     * @param task Task to hash (decodes cold fields)
+     * @return Content hash
+     */
+    [[nodiscard]] static uint64_t contentHash(const Task& task);
+
+    /**
+     * @brief Compare two tasks field by field as persisted (timestamps in seconds)
+     * @param a First task
+     * @param b Second task
+     * @return Bit i set when the field at table position i differs
+     */
+    [[nodiscard]] static uint32_t changedFields(const Task& a, const Task& b);
+
+    /**
+     * @brief Get the CSV header row: every key, comma-separated, newline-terminated
+     * @return Header accepted by TaskImport
+     */
+    [[nodiscard]] static std::string csvHeader();
+
+    /**
+     * @brief Append one task as an RFC 4180 CSV row
+     * @param out Destination buffer
+     * @param task Task to write
+     *
+     * Status and priority are written by name, timestamps as epoch seconds
+     * and tags joined with ';', so TaskImport reads the row back unchanged.
+     */
+    static void appendCsvRow(std::string& out, const Task& task);
+};
+
+#endif // TASK_SCHEMA_HPP
@@ -20,6 +20,7 @@
 #include <memory>
 #include <vector>
 #include <functional>
+#include <span>
 #include <string_view>
 
  /**
@@ -84,6 +85,18 @@ public:
      */
     void addTask(const Task& task);
 
+    /**
+     * @brief Rebuild the whole index from a task collection in bulk
+     * @param tasks Tasks to index, in the order results should be reported
+     *
+     * Replaces the current contents. Workers tokenize disjoint chunks of the
+     * collection into (term, task) pairs, the pairs are sorted in parallel and
+     * deduplicated, and the trie is then laid out in a single pass over the
+     * sorted terms. This avoids the per-node duplicate scan that makes
+     * repeated addTask() calls quadratic for popular terms.
+     */
+    void build(std::span<const std::unique_ptr<Task>> tasks);
+
     /**
      * @brief Remove a task from the search index
      * @param task Task to remove
@@ -0,0 +1,62 @@
+/**
+ * @file TaskSort.hpp
+ * @brief User-selected multi-key task ordering ("due,-priority,created")
+ *
+ * Each task's sort fields are range-compressed and packed, most significant
+ * key first, into a fixed-width integer of one to three 64-bit words. The
+ * packed keys are sorted with a stable LSD radix sort over 11-bit digits,
+ * so ordering reads every task once to encode it and never compares
+ * through Task pointers. Large inputs histogram and scatter each pass on
+ * all cores; passes whose digit is the same for every key are skipped.
+ *
+ * Tasks without a due date sort after dated ones in either direction, and
+ * the task ID breaks any remaining tie, so the result is deterministic.
+ */
+
+#ifndef TASK_SORT_HPP
+#define TASK_SORT_HPP
+
+#include "Task.hpp"
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace TaskSort {
+
+    /// @brief A sortable task field
+    enum class Field : uint8_t {
+        Priority,   ///< low < medium < high
+        Due,        ///< Due date (undated last)
+        Created,    ///< Creation time
+        Status,     ///< todo < inprogress < completed
+        Id          ///< Task ID
+    };
+
+    /// @brief One sort key and its direction
+    struct Key {
+        Field field = Field::Id;
+        bool descending = false;
+    };
+
+    using Order = std::vector<Key>;  ///< Keys from most to least significant
+
+    /**
+     * @brief Parse a comma-separated key list such as "due,-priority,created"
+     * @param spec Field names, each optionally prefixed with '-' (descending) or '+'
+     * @return Parsed order, or nullopt for empty, unknown or repeated fields
+     */
+    [[nodiscard]] std::optional<Order> parseOrder(std::string_view spec);
+
+    [[nodiscard]] std::string_view fieldNames() noexcept;  ///< Get the accepted field names for help text
+
+    /**
+     * @brief Sort tasks in place by a key order
+     * @param tasks Tasks to reorder
+     * @param order Sort keys (the task ID is appended as the final tie-break)
+     */
+    void sort(std::vector<Task*>& tasks, const Order& order);
+
+} // namespace TaskSort
+
+#endif // TASK_SORT_HPP
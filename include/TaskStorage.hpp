@@ -0,0 +1,419 @@
+/**
+ * @file TaskStorage.hpp
+ * @brief On-disk snapshot encoding for the task store
+ *
+ * Keeps file-format concerns out of the Tasks container. The snapshot is the
+ * same pretty-printed JSON document the application has always written
+ * (`{"nextId": N, "tasks": [...]}` at 4-space indentation), stored either as
+ * plain text or inside a BlockCodec compressed container.
+ *
+ * The binary format instead splits every task into a fixed-size hot record
+ * (id, status, priority, timestamps, name reference) and a variable-size
+ * cold record (description, tags, completion time). Hot records and names
+ * are packed together at the front of the file; cold records follow and are
+ * decoded from a read-only mapping only when a task's cold fields are used.
+ *
+ * Binary layout (all integers little-endian):
+ * - Header (64 bytes): magic "TDB1", version, nextId, task count, name heap
+ *   offset/size, cold section offset/size, checksum of records + names, flags
+ * - Hot records (48 bytes each): id, status, priority, flags, created,
+ *   due, name offset/length, cold record length/offset
+ * - Name heap, then cold records (each starts with its own checksum)
+ */
+
+#ifndef TASK_STORAGE_HPP
+#define TASK_STORAGE_HPP
+
+#include "Task.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TaskStorage {
+
+    /**
+     * @enum SnapshotFormat
+     * @brief How the snapshot document is stored on disk
+     */
+    enum class SnapshotFormat {
+        Json,       ///< Plain pretty-printed JSON (default, human-editable)
+        Compressed, ///< JSON inside a block-compressed BlockCodec container
+        Binary      ///< Hot/cold split records with lazily decoded cold fields
+    };
+
+    inline constexpr std::string_view BINARY_MAGIC = "TDB1";  ///< Binary snapshot signature
+    inline constexpr uint32_t BINARY_VERSION = 1;             ///< Binary snapshot format version
+
+    /**
+     * @struct BinaryLayout
+     * @brief Section sizes of a binary snapshot
+     */
+    struct BinaryLayout {
+        uint32_t taskCount = 0;   ///< Number of hot records
+        uint64_t hotBytes = 0;    ///< Header, hot records and name heap
+        uint64_t coldBytes = 0;   ///< Cold records
+    };
+
+    [[nodiscard]] std::string_view formatName(SnapshotFormat format) noexcept;           ///< Get user-facing format name
+    [[nodiscard]] std::optional<SnapshotFormat> parseFormat(std::string_view name);       ///< Parse format name ("json", "compressed", "binary")
+
+    /**
+     * @brief Read a whole file into memory
+     * @param path File to read
+     * @return File contents
+     * @throws std::runtime_error if the file cannot be read
+     */
+    [[nodiscard]] std::string readFile(const std::filesystem::path& path);
+
+    /**
+     * @brief Read a snapshot and return its JSON text
+     * @param path Snapshot file
+     * @param detected Set to the format found on disk
+     * @return Snapshot JSON document (decompressed in parallel if needed)
+     */
+    [[nodiscard]] std::string readSnapshotText(const std::filesystem::path& path, SnapshotFormat& detected);
+
+    /**
+     * @brief Identify a snapshot's format from its first bytes
+     * @param path Snapshot file
+     * @return Detected format (Json if no signature matches)
+     */
+    [[nodiscard]] SnapshotFormat detectFormat(const std::filesystem::path& path);
+
+    /**
+     * @brief Load every task from a snapshot in any format
+     * @param path Snapshot file
+     * @param nextId Set to the persisted next task ID (left unchanged if absent)
+     * @param detected Set to the format found on disk
+     * @return Tasks in storage order (binary snapshots keep cold fields mapped)
+     * @throws std::runtime_error or nlohmann::json::exception on malformed data
+     */
+    [[nodiscard]] std::vector<std::unique_ptr<Task>> loadSnapshot(const std::filesystem::path& path, int& nextId,
+        SnapshotFormat& detected);
+
+    // ======================
+    // Binary Snapshot
+    // ======================
+
+    /**
+     * @brief Serialize a snapshot in the binary hot/cold layout
+     * @param nextId Next task ID to persist
+     * @param tasks Tasks in storage order
+     * @return Buffers whose concatenation is the binary snapshot
+     */
+    [[nodiscard]] std::vector<std::string> serializeBinarySnapshot(int nextId, std::span<const std::unique_ptr<Task>> tasks);
+
+    /**
+     * @brief Load a binary snapshot, decoding only the hot section
+     * @param path Binary snapshot file
+     * @param nextId Set to the persisted next task ID
+     * @return Tasks whose cold fields decode from the mapped file on first use
+     * @throws std::runtime_error on bad header, checksum or record bounds
+     *
+     * The file stays mapped for as long as any returned task still has
+     * undecoded cold fields.
+     */
+    [[nodiscard]] std::vector<std::unique_ptr<Task>> loadBinarySnapshot(const std::filesystem::path& path, int& nextId);
+
+    /**
+     * @brief Parse and validate a binary snapshot header
+     * @param data Snapshot bytes (at least the header)
+     * @return Section sizes
+     * @throws std::runtime_error if the header is invalid
+     */
+    [[nodiscard]] BinaryLayout readBinaryLayout(std::string_view data);
+
+    // ======================
+    // Cold Archive Tier
+    // ======================
+
+    /**
+     * @brief Get the archive file that belongs to a data file
+     * @param dataFile Hot snapshot path (e.g. data/data.json)
+     * @return Sibling archive path (e.g. data/data.archive.jsonl)
+     */
+    [[nodiscard]] std::filesystem::path archivePath(const std::filesystem::path& dataFile);
+
+    inline constexpr size_t ARCHIVE_SEGMENT_TASKS = 1024; ///< Tasks per archive segment (zone map granularity)
+
+    /**
+     * @struct ArchiveZone
+     * @brief Zone map and Bloom filter for one archive segment
+     *
+     * Segments are contiguous runs of archive lines. Their summaries live in
+     * a sidecar (<stem>.archive.zones) so scans can rule out a segment
+     * without reading or parsing it.
+     */
+    struct ArchiveZone {
+        uint64_t offset = 0;                     ///< First byte of the segment in the archive
+        uint64_t length = 0;                     ///< Segment size in bytes (whole lines)
+        uint32_t count = 0;                      ///< Tasks (lines) in the segment
+        int minId = 0;                           ///< Smallest task ID
+        int maxId = 0;                           ///< Largest task ID
+        std::array<uint32_t, 3> statusCounts{};  ///< TODO, IN_PROGRESS, COMPLETED
+        std::array<uint32_t, 3> priorityCounts{};///< LOW, MEDIUM, HIGH
+        uint32_t openWithDue = 0;                ///< Not-completed tasks with a due date (overdue candidates)
+        std::optional<std::chrono::system_clock::time_point> minDue; ///< Earliest due date
+        std::optional<std::chrono::system_clock::time_point> maxDue; ///< Latest due date
+        std::vector<int> ids;                    ///< Sorted task IDs (exact membership)
+        std::vector<uint64_t> bloom;             ///< Trigrams of lowercased name, description and tags
+
+        /**
+         * @brief Check whether a search could match any task in the segment
+         * @param query Search text (matched case-insensitively like Task::matches)
+         * @return false only if no task in the segment can contain the query
+         */
+        [[nodiscard]] bool mayContainText(std::string_view query) const;
+
+        /**
+         * @brief Check whether the segment holds a task
+         * @param id Task identifier
+         * @return true if the segment contains the ID
+         */
+        [[nodiscard]] bool containsId(int id) const noexcept;
+    };
+
+    /**
+     * @brief Get the zone map sidecar that belongs to an archive
+     * @param archive Archive file (e.g. data/data.archive.jsonl)
+     * @return Sidecar path (e.g. data/data.archive.zones)
+     */
+    [[nodiscard]] std::filesystem::path archiveZonesPath(const std::filesystem::path& archive);
+
+    /**
+     * @brief Append tasks to the archive, one compact JSON object per line
+     * @param path Archive file (created if missing)
+     * @param tasks Tasks to append
+     * @throws std::runtime_error if the archive cannot be written or synced
+     *
+     * The archive is append-only and flushed to disk before returning so
+     * callers can safely drop the tasks from the hot snapshot afterwards.
+     * Appended lines are grouped into segments whose zone maps are appended
+     * to the sidecar after the archive itself is durable.
+     */
+    void appendArchive(const std::filesystem::path& path, std::span<const std::unique_ptr<Task>> tasks);
+
+    /**
+     * @brief Read the valid zone maps of an archive
+     * @param path Archive file
+     * @return Zones in archive order (empty if the sidecar is missing)
+     *
+     * Zones that are corrupt, overlap, or extend past the archive end are
+     * dropped along with everything after them; those bytes are simply
+     * treated as not covered.
+     */
+    [[nodiscard]] std::vector<ArchiveZone> readArchiveZones(const std::filesystem::path& path);
+
+    /**
+     * @brief Stream archived tasks without loading the whole archive
+     * @param path Archive file (a missing file is an empty archive)
+     * @param visit Called once per archived task, in archive order
+     * @param zoneFilter Optional; segments it rejects are skipped unread.
+     *                   Bytes without a zone map are always read.
+     * @return Number of tasks visited
+     * @throws std::runtime_error with the line number if a record is malformed
+     */
+    size_t forEachArchivedTask(const std::filesystem::path& path, const std::function<void(Task&&)>& visit,
+        const std::function<bool(const ArchiveZone&)>& zoneFilter = {});
+
+    // ======================
+    // Single-Record Access
+    // ======================
+
+    /**
+     * @struct RecordOffset
+     * @brief Location of one task object inside a JSON snapshot
+     */
+    struct RecordOffset {
+        int id = 0;           ///< Task identifier
+        uint32_t length = 0;  ///< Object length in bytes
+        uint64_t offset = 0;  ///< Byte offset of the object in the snapshot
+    };
+
+    /**
+     * @struct RecordLookup
+     * @brief Result of a single-task lookup that avoids loading the store
+     */
+    struct RecordLookup {
+        bool indexed = false;       ///< false if no offset table applies (caller must load everything)
+        std::optional<Task> task;   ///< The task, if it exists
+    };
+
+    /**
+     * @brief Get the JSON offset table that belongs to a data file
+     * @param dataFile Snapshot path (e.g. data/data.json)
+     * @return Sibling sidecar path (e.g. data/data.offsets)
+     */
+    [[nodiscard]] std::filesystem::path offsetIndexPath(const std::filesystem::path& dataFile);
+
+    /**
+     * @brief Find one task by ID in the snapshot without reading all of it
+     * @param dataFile Snapshot path
+     * @param id Task identifier
+     * @return Lookup result (indexed is false if no offset table applies)
+     * @throws std::runtime_error if the located record is corrupt
+     *
+     * Binary snapshots are searched through their fixed-size hot records;
+     * JSON snapshots through the offsets sidecar, which is only trusted while
+     * the snapshot's size and modification time match the ones it recorded.
+     * Cost depends on log(task count), not store size. Newer tiers
+     * (LsmStore) are consulted by the caller first.
+     */
+    [[nodiscard]] RecordLookup lookupSnapshotTask(const std::filesystem::path& dataFile, int id);
+
+    /**
+     * @brief Append bytes to a file and fsync before returning
+     * @param path File to append to (created if missing)
+     * @param bytes Data to append
+     * @param what Short description used in error messages (e.g. "archive")
+     * @throws std::runtime_error on any I/O failure
+     */
+    void appendDurably(const std::filesystem::path& path, std::string_view bytes, std::string_view what);
+
+    // ======================
+    // Sharding
+    // ======================
+
+    /**
+     * @struct ShardLayout
+     * @brief How tasks are partitioned across shard snapshots
+     *
+     * Described by a manifest (<stem>.shards.json) next to the data file.
+     * When the manifest exists the data file itself is not used; each shard
+     * is an ordinary snapshot with its own offsets sidecar and LSM tiers.
+     */
+    struct ShardLayout {
+        /**
+         * @enum Scheme
+         * @brief Rule mapping a task ID to a shard
+         */
+        enum class Scheme {
+            Range, ///< Consecutive blocks of rangeSize IDs; the last shard takes every ID past the end
+            Hash   ///< Multiplicative hash of the ID, for even spread regardless of age
+        };
+
+        Scheme scheme = Scheme::Range;              ///< Partitioning rule
+        int rangeSize = 1;                          ///< IDs per shard (Range only)
+        uint32_t generation = 0;                    ///< Bumped by each reshard so new files never replace live ones
+        std::vector<std::filesystem::path> files;   ///< Shard snapshots, resolved next to the data file
+
+        /**
+         * @brief Get the shard that owns a task
+         * @param id Task identifier
+         * @return Index into files
+         */
+        [[nodiscard]] size_t shardOf(int id) const noexcept;
+    };
+
+    [[nodiscard]] std::string_view schemeName(ShardLayout::Scheme scheme) noexcept;              ///< Get user-facing scheme name
+    [[nodiscard]] std::optional<ShardLayout::Scheme> parseScheme(std::string_view name);         ///< Parse scheme name ("range", "hash")
+
+    /**
+     * @brief Get the shard manifest that belongs to a data file
+     * @param dataFile Logical data file (e.g. data/data.json)
+     * @return Sibling manifest path (e.g. data/data.shards.json)
+     */
+    [[nodiscard]] std::filesystem::path shardManifestPath(const std::filesystem::path& dataFile);
+
+    /**
+     * @brief Check whether a data file names an existing store
+     * @param dataFile Logical data file
+     * @return true if its snapshot, shard manifest, write-ahead log or LSM manifest exists
+     *
+     * A store that has never been checkpointed lives only in its journal
+     * (and later its runs), with no snapshot on disk yet.
+     */
+    [[nodiscard]] bool storeExists(const std::filesystem::path& dataFile);
+
+    /**
+     * @brief Read the shard manifest of a data file
+     * @param dataFile Logical data file
+     * @return Layout, or nullopt if the store is not sharded
+     * @throws std::runtime_error if the manifest exists but is malformed
+     */
+    [[nodiscard]] std::optional<ShardLayout> readShardLayout(const std::filesystem::path& dataFile);
+
+    /**
+     * @brief Describe a new layout and name its shard files
+     * @param dataFile Logical data file
+     * @param scheme Partitioning rule
+     * @param count Number of shards (at least 2)
+     * @param rangeSize IDs per shard (Range only)
+     * @param generation Distinguishes the new files from any previous layout's
+     * @return Layout with file names like data.shard-<generation>.<index>.json
+     */
+    [[nodiscard]] ShardLayout planShards(const std::filesystem::path& dataFile, ShardLayout::Scheme scheme,
+        size_t count, int rangeSize, uint32_t generation);
+
+    /**
+     * @brief Atomically write the shard manifest
+     * @param dataFile Logical data file
+     * @param layout Layout to record (file names are stored relative to the data file)
+     * @throws std::runtime_error if the manifest cannot be written
+     */
+    void writeShardLayout(const std::filesystem::path& dataFile, const ShardLayout& layout);
+
+    // ======================
+    // Snapshot Output
+    // ======================
+
+    /**
+     * @brief Serialize a snapshot into ordered output buffers
+     * @param nextId Next task ID to persist
+     * @param tasks Tasks in storage order
+     * @param offsets If non-null, receives each task object's position in the document
+     * @return Buffers whose concatenation is the snapshot document
+     *
+     * Workers each render a contiguous chunk of tasks into their own buffer,
+     * re-indented to array-element depth and joined with the separators
+     * nlohmann::json::dump(4) would emit. The concatenation is byte-identical
+     * to dumping the whole document on one thread.
+     */
+    [[nodiscard]] std::vector<std::string> serializeSnapshot(int nextId, std::span<const std::unique_ptr<Task>> tasks,
+        std::vector<RecordOffset>* offsets = nullptr);
+
+    /**
+     * @brief Write a snapshot to disk using vectored I/O
+     * @param path Destination file (replaced atomically)
+     * @param nextId Next task ID to persist
+     * @param tasks Tasks in storage order
+     * @param format On-disk encoding
+     * @throws std::runtime_error if the file cannot be opened or written
+     *
+     * JSON snapshots are followed by a refreshed offsets sidecar so single
+     * tasks can be read back without parsing the document.
+     */
+    void writeSnapshot(const std::filesystem::path& path, int nextId, std::span<const std::unique_ptr<Task>> tasks,
+        SnapshotFormat format = SnapshotFormat::Json);
+
+    /**
+     * @brief Delete a snapshot and its offsets sidecar (missing files are ignored)
+     * @param path Snapshot file
+     */
+    void removeSnapshot(const std::filesystem::path& path);
+
+    /**
+     * @brief Write ordered buffers to a file with writev(), retrying short writes
+     * @param path Destination file (replaced atomically)
+     * @param buffers Buffers to write back-to-back
+     * @throws std::runtime_error on any I/O failure
+     *
+     * Data goes to a temporary sibling that is renamed over the destination,
+     * so readers that still map the old file never observe a truncated one.
+     * The file is fsynced before the rename and its directory after it, so
+     * once this returns the new contents survive a crash and callers may
+     * delete the journal or runs they replace.
+     */
+    void writeBuffers(const std::filesystem::path& path, std::span<const std::string> buffers);
+
+} // namespace TaskStorage
+
+#endif // TASK_STORAGE_HPP
@@ -0,0 +1,73 @@
+/**
+ * @file TaskSync.hpp
+ * @brief Three-way merge between two copies of a task store
+ *
+ * After every sync both stores hold the same tasks, and that state is
+ * recorded next to the local data file as the common ancestor:
+ * - <stem>.sync.json: one entry per peer with the sync generation, the
+ *   ancestor snapshot and each side's change feed position
+ * - <stem>.sync-<peer hash>.base: the ancestor itself (binary snapshot)
+ *
+ * The next sync compares content hashes (ContentIndex) of the ancestor
+ * with each side to find changed tasks without comparing every task. It
+ * then merges field by field. A field changed on one side only takes
+ * that side's value. A field changed differently on both sides is a
+ * conflict: the change made later according to the sides' change feeds
+ * wins, and a tie goes to the greater JSON value, so both directions agree.
+ * Status and completion time merge as one field. An edit beats a
+ * deletion. Tasks created on both sides with the same ID are kept. The
+ * other side's task is renumbered past both stores' next ID.
+ *
+ * Merge results are written to each store as a single logged batch
+ * containing only the tasks that changed there.
+ */
+
+#ifndef TASK_SYNC_HPP
+#define TASK_SYNC_HPP
+
+#include "Tasks.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace TaskSync {
+
+    /**
+     * @struct Report
+     * @brief What a sync changed
+     */
+    struct Report {
+        uint64_t generation = 0;    ///< Sync generation recorded for this pair of stores
+        bool firstSync = false;     ///< No ancestor was recorded (tasks with the same ID were treated as the same task)
+        size_t changed = 0;         ///< Tasks changed on either side since the ancestor
+        size_t toLocal = 0;         ///< Tasks written to the local store
+        size_t toRemote = 0;        ///< Tasks written to the other store
+        size_t deletedLocal = 0;    ///< Tasks removed from the local store
+        size_t deletedRemote = 0;   ///< Tasks removed from the other store
+        size_t conflicts = 0;       ///< Fields (or edit/delete pairs) changed differently on both sides
+        size_t remapped = 0;        ///< Tasks renumbered because both sides created the same ID
+        size_t rangesCompared = 0;  ///< Range hashes compared to find changed tasks
+    };
+
+    /**
+     * @brief Get the sync state file that belongs to a data file
+     * @param dataFile Logical data file (e.g. data/data.json)
+     * @return Sibling state path (e.g. data/data.sync.json)
+     */
+    [[nodiscard]] std::filesystem::path statePath(const std::filesystem::path& dataFile);
+
+    /**
+     * @brief Merge two fully loaded stores so both end up with the same tasks
+     * @param local Store opened on localFile
+     * @param localFile Local data file (the sync state is kept next to it)
+     * @param remote Store opened on remoteFile
+     * @param remoteFile The other data file
+     * @return What was merged
+     * @throws std::runtime_error if either store or the sync state cannot be written
+     */
+    [[nodiscard]] Report synchronize(Tasks& local, const std::filesystem::path& localFile,
+        Tasks& remote, const std::filesystem::path& remoteFile);
+
+} // namespace TaskSync
+
+#endif // TASK_SYNC_HPP
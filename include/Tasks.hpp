@@ -12,6 +12,13 @@
 
 #include "Task.hpp"
 #include "TaskSearchIndex.hpp"
+#include "TaskStorage.hpp"
+#include "LsmStore.hpp"
+#include "ChangeFeed.hpp"
+#include "ContentIndex.hpp"
+#include "TaskOrder.hpp"
+#include "TaskReport.hpp"
+#include "TaskSort.hpp"
 #include <vector>
 #include <string>
 #include <string_view>
@@ -22,6 +29,7 @@
 #include <algorithm>
 #include <filesystem>
 #include <optional>
+#include <unordered_map>
 
  /**
   * @struct TaskResult
@@ -69,6 +77,32 @@ struct TaskStats {
     size_t mediumPriority = 0; ///< Number of MEDIUM priority tasks
     size_t highPriority = 0;  ///< Number of HIGH priority tasks
     size_t overdue = 0;       ///< Number of overdue tasks
+
+    /**
+     * @brief Merge counters from another set of statistics
+     * @param other Statistics to add (e.g. from the archive)
+     * @return Reference to this object
+     */
+    TaskStats& operator+=(const TaskStats& other) noexcept {
+        total += other.total;
+        todo += other.todo;
+        inProgress += other.inProgress;
+        completed += other.completed;
+        lowPriority += other.lowPriority;
+        mediumPriority += other.mediumPriority;
+        highPriority += other.highPriority;
+        overdue += other.overdue;
+        return *this;
+    }
+};
+
+/**
+ * @enum LoadMode
+ * @brief How much of the store a Tasks container reads up front
+ */
+enum class LoadMode {
+    Full,     ///< Load the snapshot and replay the change tiers (required for listing, search and bulk edits)
+    Deferred  ///< Load nothing; loadTask() reads single records and save() appends them to the log
 };
 
 /**
@@ -95,6 +129,29 @@ private:
     std::vector<std::unique_ptr<Task>> tasks;    ///< Main task storage using smart pointers
     int nextId;                                   ///< Next available task ID
     std::filesystem::path dataFile;               ///< Path to JSON data file
+    TaskStorage::SnapshotFormat snapshot_format_ = TaskStorage::SnapshotFormat::Json; ///< Encoding detected on load, reused on save
+    bool loaded_ = false;                         ///< Whether every shard and its change tiers are in memory
+    bool load_failed_ = false;                    ///< Whether loading reported an error (never checkpoint then)
+    LsmStore::CheckpointPolicy checkpoint_policy_; ///< Limits that trigger an automatic checkpoint
+    LsmStore::ReplayReport replay_report_;        ///< Change tiers replayed by the last full load
+    EvalContext context_;                         ///< Instant overdue checks, stats and renderers evaluate at
+    std::optional<TaskSort::Order> sort_order_;   ///< User-selected listing order (nullopt: display order)
+
+    // ==================
+    // Shards
+    // ==================
+
+    /**
+     * @struct Shard
+     * @brief One snapshot file and the change tiers layered on it
+     */
+    struct Shard {
+        std::filesystem::path file;   ///< Snapshot path
+        LsmStore store;               ///< Write-ahead log and sorted runs not yet folded into the snapshot
+    };
+
+    std::optional<TaskStorage::ShardLayout> layout_; ///< Partitioning rule (nullopt: dataFile is the only shard)
+    mutable std::vector<Shard> shards_;              ///< Shards in layout order
 
     // =============================
     // Phase 2 Optimization Features
@@ -106,14 +163,36 @@ private:
     mutable std::optional<TaskStats> cached_stats_; ///< Cached statistics to avoid recomputation
     mutable bool stats_dirty_ = true;               ///< Flag to recalculate stats when needed
 
+    mutable TaskOrder order_;                    ///< Tasks in display order, updated per add/remove/edit
+    mutable bool order_dirty_ = true;            ///< Flag to rebuild the order after bulk changes
+
+    // ==================
+    // Cold Archive Tier
+    // ==================
+
+    std::filesystem::path archiveFile;                    ///< Archive of old completed tasks (never loaded eagerly)
+    mutable std::vector<std::unique_ptr<Task>> archived_; ///< Archived tasks materialized by archive scans
+
+    // ==================
+    // Change Feed
+    // ==================
+
+    ChangeFeed feed_;                                     ///< Sequence-numbered log of logical changes
+    std::unordered_map<int, nlohmann::json> originals_;   ///< Before-images of tasks handed out by loadTask()
+
     // ===================
     // Internal Helper Methods
     // ===================
 
-    void loadFromFile();                         ///< Load tasks from JSON file
-    void saveToFile() const;                     ///< Synchronous save to JSON file
+    void loadFromFile();                         ///< Load every shard in parallel and replay runs and the log
+    void saveToFile();                           ///< Checkpoint every shard, reporting errors
+    void writeShards(const std::function<bool(size_t)>& include = {}); ///< Rewrite shard snapshots (all, or those include() selects)
+    void openShards();                           ///< Build shards_ from layout_
+    [[nodiscard]] Shard& shardFor(int id) const; ///< Get the shard that owns a task ID
+    void publish(std::span<const ChangeFeed::Event> events); ///< Append events to the feed (failures only warn)
     void rebuildSearchIndex() const;             ///< Rebuild search index when dirty
     [[nodiscard]] std::vector<Task*> getSortedTasks() const; ///< Get tasks sorted by priority and due date
+    void rebuildOrder() const;                   ///< Rebuild the display order when dirty
 
     // ========================
     // Table Display Helpers
@@ -132,8 +211,10 @@ public:
     /**
      * @brief Construct Tasks container with data file path
      * @param dataFile Path to JSON file for persistence (default: "data/data.json")
+     * @param mode Full loads everything now; Deferred only supports loadTask(),
+     *             showTaskDetails() and save() for single-task commands
      */
-    explicit Tasks(std::filesystem::path dataFile = "data/data.json");
+    explicit Tasks(std::filesystem::path dataFile = "data/data.json", LoadMode mode = LoadMode::Full);
 
     // Rule of 5 for proper resource management
     Tasks(const Tasks&) = delete;               ///< Disable copying (unique ownership)
@@ -150,8 +231,9 @@ public:
      * @brief Display a list of tasks in formatted table
      * @param taskList List of task pointers to display
      * @param title Optional title for the table
+     * @param total Size of the full result when taskList is only its first rows (0: taskList is complete)
      */
-    void displayTaskList(const std::vector<Task*>& taskList, std::string_view title = "") const;
+    void displayTaskList(const std::vector<Task*>& taskList, std::string_view title = "", size_t total = 0) const;
 
     // ====================================
     // Task Management with Error Handling
@@ -167,19 +249,75 @@ public:
     [[nodiscard]] TaskResult removeAllTasks();                                         ///< Remove all tasks
     [[nodiscard]] TaskResult updateTask(int id, std::string_view name, TaskStatus status, TaskPriority priority); ///< Update existing task
 
+    /**
+     * @brief Store a batch of task states and deletions as one logged change
+     * @param puts Task states to store (replacing tasks with the same ID, or added)
+     * @param deletes IDs of tasks to remove (unknown IDs are ignored)
+     * @return Result with the number of tasks written and removed
+     *
+     * Only these tasks reach the change tiers and the change feed; the
+     * snapshot is left to the next checkpoint. Used to apply merge results.
+     */
+    [[nodiscard]] TaskResult applyBatch(std::vector<Task> puts, std::span<const int> deletes = {});
+
+    /**
+     * @brief Add many new tasks and write the store out once
+     * @param imported Tasks numbered consecutively from getNextId(), in ID order
+     * @param source Where the tasks came from (recorded in the change feed)
+     * @return Result with the number of tasks added
+     *
+     * Bypasses the write-ahead log: every shard snapshot is rewritten once
+     * with the new tasks, and the change feed gets a single "import" event
+     * for the whole ID range. The search index and statistics are rebuilt
+     * lazily on their next use rather than per task. The IDs are claimed
+     * only when the snapshots are written; on failure the tasks are dropped
+     * from memory again and the next ID is unchanged.
+     */
+    [[nodiscard]] TaskResult bulkLoad(std::vector<std::unique_ptr<Task>> imported, std::string_view source);
+
     // ================
     // Task Retrieval
     // ================
 
     [[nodiscard]] Task* findTask(int id) noexcept;                                     ///< Find task by ID (mutable)
     [[nodiscard]] const Task* findTask(int id) const noexcept;                        ///< Find task by ID (const)
-    [[nodiscard]] std::vector<Task*> searchTasks(std::string_view query) const;       ///< Basic search functionality
+
+    /**
+     * @brief Find a task by ID, reading only its record when the store is deferred
+     * @param id Task identifier
+     * @return Task pointer or nullptr if no such task exists
+     *
+     * Falls back to a full load when the snapshot has no usable offset
+     * table (compressed snapshots, or JSON edited outside the application).
+     */
+    [[nodiscard]] Task* loadTask(int id);
+    [[nodiscard]] std::vector<const Task*> findTasks(std::span<const int> ids) const; ///< Find many tasks in one pass (nullptr where missing)
+    [[nodiscard]] std::vector<Task*> searchTasks(std::string_view query, bool includeArchive = false) const; ///< Basic search (optionally streaming the archive)
     [[nodiscard]] std::vector<Task*> advancedSearch(std::string_view query) const;    ///< Advanced search using index
     [[nodiscard]] std::vector<Task*> getTasksByStatus(TaskStatus status) const;       ///< Filter by status
     [[nodiscard]] std::vector<Task*> getTasksByPriority(TaskPriority priority) const; ///< Filter by priority
     [[nodiscard]] std::vector<Task*> getTasksByTag(std::string_view tag) const;       ///< Filter by tag
     [[nodiscard]] std::vector<Task*> getOverdueTasks() const;                         ///< Get overdue tasks
 
+    /**
+     * @brief Get the first tasks in display order that match a predicate
+     * @param predicate Filter applied to every task
+     * @param limit Maximum number of tasks returned
+     * @param matched Set to the number of tasks that matched
+     * @return Up to limit matching tasks, sorted by priority and due date
+     *
+     * Walks the persistent display order, so no sorting happens per call.
+     */
+    [[nodiscard]] std::vector<Task*> topTasks(const std::function<bool(const Task&)>& predicate, size_t limit, size_t& matched) const;
+
+    /**
+     * @brief Get a task's zero-based row in the full listing
+     * @param id Task identifier
+     * @return Position in display order, or nullopt if the task is not loaded
+     * @note O(log n) once the order is built
+     */
+    [[nodiscard]] std::optional<size_t> positionOf(int id) const;
+
     // ===========
     // Statistics
     // ===========
@@ -191,22 +329,164 @@ public:
      */
     [[nodiscard]] TaskStats getStatistics() const;
 
+    // ==================
+    // Cold Archive Tier
+    // ==================
+
+    /**
+     * @brief Move completed tasks older than a given age into the archive file
+     * @param olderThan Minimum time since completion
+     * @return Result with the number of tasks archived
+     *
+     * Tasks are appended (and synced) to the archive before the hot file is
+     * rewritten without them. If a crash separates the two steps the task
+     * exists in both places; archive readers skip IDs present in the hot set.
+     */
+    [[nodiscard]] TaskResult archiveCompletedTasks(std::chrono::days olderThan);
+
+    /**
+     * @brief Stream the archive and keep only tasks matching a predicate
+     * @param predicate Filter applied to each archived task as it is decoded
+     * @param zoneFilter Optional segment filter; rejected segments are never read
+     * @return Pointers to matching archived tasks (owned by this container)
+     */
+    [[nodiscard]] std::vector<Task*> scanArchive(const std::function<bool(const Task&)>& predicate,
+        const std::function<bool(const TaskStorage::ArchiveZone&)>& zoneFilter = {}) const;
+
+    /**
+     * @brief Count archived tasks without materializing them
+     * @return Statistics for the archive only
+     *
+     * Segments are counted straight from their zone maps unless one of
+     * their tasks could also be in the hot set or could be overdue.
+     */
+    [[nodiscard]] TaskStats getArchiveStatistics() const;
+
+    // ==================
+    // Evaluation Context
+    // ==================
+
+    /**
+     * @brief Set the instant time-dependent state is evaluated at
+     * @param context Clock sample (or --as-of instant) for overdue checks, stats and rendering
+     *
+     * Defaults to one clock sample taken at construction. Invalidates
+     * cached statistics, since overdue counts depend on it.
+     */
+    void setEvalContext(const EvalContext& context) noexcept;
+    [[nodiscard]] const EvalContext& getEvalContext() const noexcept;                 ///< Get the current evaluation instant
+
+    /**
+     * @brief Order listings by user-selected keys instead of the display order
+     * @param order Sort keys (list --sort), or nullopt to restore the default
+     *
+     * Applies to full and filtered listings and the live view.
+     */
+    void setSortOrder(std::optional<TaskSort::Order> order);
+
     // =================
     // Data Persistence
     // =================
 
-    void save() const;                                                                  ///< Save tasks to file
+    void save();                                                                        ///< Save tasks (log append when deferred)
+    [[nodiscard]] TaskResult compact();                                                ///< Fold runs and the log into the snapshot
+    void setCheckpointPolicy(const LsmStore::CheckpointPolicy& policy) noexcept;       ///< Set automatic checkpoint limits
+    [[nodiscard]] const LsmStore::ReplayReport& getReplayReport() const noexcept;      ///< Get what the last full load replayed
+
+    /**
+     * @brief Checkpoint every shard whose backlog exceeds the policy
+     * @return Result naming the triggers, or nullopt if no limit was exceeded
+     *
+     * Meant to run at the end of a command, so the next full load replays a
+     * bounded amount. Deferred containers load fully first; that cost is only
+     * paid on the command that crosses a limit.
+     */
+    [[nodiscard]] std::optional<TaskResult> checkpointIfNeeded();
+
+    /**
+     * @brief Repartition the store across a new set of shard files (offline)
+     * @param count Number of shards (1 returns to a single data file)
+     * @param scheme Partitioning rule for the new layout
+     * @return Result describing the new layout
+     *
+     * New shard snapshots are written first, then the manifest is replaced,
+     * then the old files and their change tiers are deleted. A crash at any
+     * point leaves either the old or the new layout intact.
+     */
+    [[nodiscard]] TaskResult reshard(size_t count, TaskStorage::ShardLayout::Scheme scheme);
+    [[nodiscard]] TaskResult setSnapshotFormat(TaskStorage::SnapshotFormat format);    ///< Rewrite data file in another format
+    void exportSnapshot(const std::filesystem::path& path, TaskStorage::SnapshotFormat format) const; ///< Write every task to a standalone snapshot file
+    void forEachTask(const std::function<void(const Task&)>& visit) const;            ///< Visit every task in storage order
+    [[nodiscard]] TaskStorage::SnapshotFormat getSnapshotFormat() const noexcept;      ///< Get current on-disk format
 
     // ====================================
     // Display Methods with Enhanced Formatting
     // ====================================
 
     void showAllTasks() const;                                                          ///< Display all tasks in table format
-    void showFilteredTasks(TaskStatus status) const;                                   ///< Display tasks filtered by status
+    void showFilteredTasks(TaskStatus status) const;                                   ///< Display tasks filtered by status (completed includes archive)
     void showFilteredTasks(TaskPriority priority) const;                               ///< Display tasks filtered by priority
-    void showTaskDetails(int id) const;                                                ///< Show detailed view of specific task
+    void showTaskDetails(int id);                                                      ///< Show detailed view of specific task (falls back to archive)
     void showOverdueTasks() const;                                                     ///< Display overdue tasks with warnings
-    void showStatistics() const;                                                       ///< Display comprehensive statistics dashboard
+    void showStatistics(bool includeArchive = false) const;                            ///< Display comprehensive statistics dashboard
+
+    /**
+     * @brief Display metrics grouped by one or more task fields
+     * @param groupBy Grouping dimensions, most significant first
+     * @param metrics Columns to show per group
+     * @param includeArchive Whether archived tasks are aggregated too
+     */
+    void showReport(const std::vector<TaskReport::Dimension>& groupBy,
+        const std::vector<TaskReport::Metric>& metrics, bool includeArchive = false) const;
+    void showStorageInfo() const;                                                      ///< Display data file format and compression report
+
+    // ============
+    // Change Feed
+    // ============
+
+    /**
+     * @brief Visit change events newer than a sequence number
+     * @param since Only events with a greater sequence number are visited
+     * @param visit Called with each event's JSON line
+     * @return Sequence number of the last event visited (since if none)
+     */
+    uint64_t readChanges(uint64_t since, const std::function<void(std::string_view)>& visit) const;
+
+    [[nodiscard]] uint64_t lastChange() const;   ///< Get the sequence number of the newest change event
+
+    /**
+     * @brief Bring a fully loaded container up to date from the change feed
+     * @param since Last event already reflected in memory; advanced past the events applied
+     * @return Number of events applied, or nullopt if the feed does not line
+     *         up with memory (the caller should reload())
+     *
+     * Only the new events are read and applied, so catching up after a
+     * single-task command touches one task regardless of the store size.
+     */
+    [[nodiscard]] std::optional<size_t> applyChanges(uint64_t& since);
+
+    /**
+     * @brief Reload every shard from disk and compare with what was in memory
+     * @param since Set to the newest change event seen before reloading
+     * @return Number of tasks added, removed or changed (by ID and content hash)
+     *
+     * Used when the snapshot changed behind the feed's back, e.g. it was
+     * edited by hand or restored from a backup.
+     */
+    size_t reload(uint64_t& since);
+
+    // ================
+    // Content Hashing
+    // ================
+
+    /**
+     * @brief Hash every task and index the hashes by ID range
+     * @return Index for comparing this store with another
+     *
+     * Tasks keep their hashes current as they change, so after the first
+     * call only tasks modified since are rehashed.
+     */
+    [[nodiscard]] ContentIndex contentIndex() const;
 
     // =================
     // Utility Methods
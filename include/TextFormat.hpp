@@ -0,0 +1,139 @@
+/**
+ * @file TextFormat.hpp
+ * @brief Locale-free number and date formatting for renderers and serializers
+ *
+ * Appends integers, padded columns and calendar dates straight into a
+ * caller's buffer with std::to_chars and integer calendar arithmetic, so
+ * hot output paths never construct streams, consult the locale or take
+ * a lock inside the C library.
+ *
+ * Dates are converted to local time through the process-wide TimeZone
+ * table, which is loaded once and read without locks.
+ *
+ * Output matches the previous std::put_time formatting exactly: "%Y-%m-%d"
+ * and "%Y-%m-%d %H:%M:%S", with the year unpadded outside 1000-9999.
+ */
+
+#ifndef TEXT_FORMAT_HPP
+#define TEXT_FORMAT_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace TextFormat {
+
+    /// @brief Proleptic Gregorian calendar date
+    struct CivilDate {
+        int64_t year;   ///< Astronomical year (0 = 1 BC)
+        unsigned month; ///< 1-12
+        unsigned day;   ///< 1-31
+    };
+
+    /**
+     * @brief Convert days since 1970-01-01 to a calendar date
+     * @param days Day number (negative before the epoch)
+     * @return Calendar date
+     *
+     * Howard Hinnant's era-based algorithm: no tables, no loops, valid for
+     * the full int64 range the callers produce.
+     */
+    [[nodiscard]] constexpr CivilDate civilFromDays(int64_t days) noexcept {
+        days += 719468;
+        const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        const auto doe = static_cast<unsigned>(days - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        const unsigned day = doy - (153 * mp + 2) / 5 + 1;
+        const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+        return { static_cast<int64_t>(yoe) + era * 400 + (month <= 2), month, day };
+    }
+
+    /**
+     * @brief Convert a calendar date to days since 1970-01-01
+     * @param year Astronomical year
+     * @param month 1-12
+     * @param day 1-31
+     * @return Day number (inverse of civilFromDays)
+     */
+    [[nodiscard]] constexpr int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) noexcept {
+        year -= month <= 2;
+        const int64_t era = (year >= 0 ? year : year - 399) / 400;
+        const auto yoe = static_cast<unsigned>(year - era * 400);
+        const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<int64_t>(doe) - 719468;
+    }
+
+    /**
+     * @brief Divide rounding toward negative infinity
+     * @param value Dividend
+     * @param divisor Positive divisor
+     * @return Floor of value / divisor, so instants before the epoch land on the previous day
+     */
+    [[nodiscard]] constexpr int64_t floorDiv(int64_t value, int64_t divisor) noexcept {
+        const int64_t quotient = value / divisor;
+        return quotient - ((value % divisor) != 0 && (value < 0));
+    }
+
+    static_assert(daysFromCivil(1970, 1, 1) == 0);
+    static_assert(floorDiv(-1, 86400) == -1 && floorDiv(86400, 86400) == 1);
+    static_assert(daysFromCivil(2000, 3, 1) == 11017);
+    static_assert(civilFromDays(-1).year == 1969 && civilFromDays(-1).day == 31);
+
+    /**
+     * @brief Local zone offset from UTC at an instant
+     * @param epochSeconds Seconds since the Unix epoch
+     * @return Seconds east of UTC (TimeZone::local().offsetAt())
+     */
+    [[nodiscard]] int32_t utcOffset(int64_t epochSeconds);
+
+    /**
+     * @brief Number of characters std::to_string(value) would produce
+     * @param value Integer to measure
+     * @return Digit count, plus one for a minus sign
+     */
+    [[nodiscard]] size_t digitCount(long long value) noexcept;
+
+    /**
+     * @brief Append an integer in decimal
+     * @param out Destination buffer
+     * @param value Integer to write
+     */
+    void appendInt(std::string& out, long long value);
+
+    /**
+     * @brief Append text left-aligned in a column, as std::left << std::setw(width) would
+     * @param out Destination buffer
+     * @param text Text to write (never truncated)
+     * @param width Minimum column width in bytes
+     */
+    void appendPadded(std::string& out, std::string_view text, size_t width);
+
+    /**
+     * @brief Append an integer left-aligned in a column
+     * @param out Destination buffer
+     * @param value Integer to write
+     * @param width Minimum column width
+     */
+    void appendPadded(std::string& out, long long value, size_t width);
+
+    /**
+     * @brief Append a local date as YYYY-MM-DD
+     * @param out Destination buffer
+     * @param timePoint Instant to format
+     */
+    void appendDate(std::string& out, const std::chrono::system_clock::time_point& timePoint);
+
+    /**
+     * @brief Append a local date and time as YYYY-MM-DD HH:MM:SS
+     * @param out Destination buffer
+     * @param timePoint Instant to format
+     */
+    void appendDateTime(std::string& out, const std::chrono::system_clock::time_point& timePoint);
+
+} // namespace TextFormat
+
+#endif // TEXT_FORMAT_HPP
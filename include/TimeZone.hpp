@@ -0,0 +1,132 @@
+/**
+ * @file TimeZone.hpp
+ * @brief Local time zone loaded once from the TZif database
+ *
+ * Replaces std::localtime/std::mktime, which take a global lock and
+ * re-examine TZ on every call. The zone named by TZ (or /etc/localtime)
+ * is read once per process into a sorted table of UTC transitions; the
+ * TZif footer's POSIX rule is expanded into that table up to year 2200
+ * and evaluated directly beyond it. A bucket index over fixed ~24-day
+ * spans turns a lookup into one array read plus a step or two. The table
+ * is immutable after construction, so conversions are lock-free and safe
+ * from any thread.
+ *
+ * TZ is resolved as glibc does: unset means /etc/localtime, empty means
+ * UTC, a leading ':' is ignored, relative names are looked up under
+ * $TZDIR or /usr/share/zoneinfo, and anything that is not a readable
+ * TZif file is parsed as a POSIX rule ("EST5EDT,M3.2.0,M11.1.0"). Zones
+ * that cannot be resolved fall back to UTC. Leap-second ("right/") data
+ * is ignored.
+ */
+
+#ifndef TIME_ZONE_HPP
+#define TIME_ZONE_HPP
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class TimeZone
+ * @brief Immutable UTC offset table with UTC <-> local conversions
+ */
+class TimeZone {
+public:
+    /**
+     * @brief Get the process's local zone, loading it on first use
+     * @return Zone shared by all threads for the life of the process
+     */
+    [[nodiscard]] static const TimeZone& local();
+
+    /**
+     * @brief Build a zone from TZif file contents (RFC 8536, versions 1-4)
+     * @param data Raw file bytes
+     * @return Zone, or nullopt if the data is not a valid TZif file
+     */
+    [[nodiscard]] static std::optional<TimeZone> fromTzif(std::string_view data);
+
+    /**
+     * @brief Build a zone from a POSIX TZ rule such as "CET-1CEST,M3.5.0,M10.5.0/3"
+     * @param rule Rule text
+     * @return Zone, or nullopt if the rule does not parse
+     */
+    [[nodiscard]] static std::optional<TimeZone> fromPosix(std::string_view rule);
+
+    [[nodiscard]] static TimeZone utc();   ///< Get a zone with no offset and no transitions
+
+    /**
+     * @brief Get the offset from UTC in effect at an instant
+     * @param utcSeconds Seconds since the Unix epoch
+     * @return Seconds east of UTC
+     */
+    [[nodiscard]] int32_t offsetAt(int64_t utcSeconds) const noexcept;
+
+    /**
+     * @brief Convert an instant to local wall-clock seconds
+     * @param utcSeconds Seconds since the Unix epoch
+     * @return Local seconds since 1970-01-01 00:00:00 local
+     */
+    [[nodiscard]] int64_t toLocal(int64_t utcSeconds) const noexcept {
+        return utcSeconds + offsetAt(utcSeconds);
+    }
+
+    /**
+     * @brief Get the local calendar day holding an instant
+     * @param utcSeconds Seconds since the Unix epoch
+     * @return Days since 1970-01-01 in local time (negative before it)
+     */
+    [[nodiscard]] int64_t localDay(int64_t utcSeconds) const noexcept;
+
+    /**
+     * @brief Convert local wall-clock seconds to an instant
+     * @param localSeconds Local seconds since 1970-01-01 00:00:00 local
+     * @return Seconds since the Unix epoch
+     *
+     * Like mktime() with tm_isdst = -1: an ambiguous time (clocks going
+     * back) resolves to its first occurrence, and a skipped time (clocks
+     * going forward) is read with the offset before the gap, so 02:30 on
+     * a spring-forward night becomes 03:30.
+     */
+    [[nodiscard]] int64_t toUtc(int64_t localSeconds) const noexcept;
+
+private:
+    /**
+     * @struct Rule
+     * @brief Parsed POSIX TZ rule ("std offset [dst [offset] [,start[/time],end[/time]]]")
+     */
+    struct Rule {
+        /// One end of the daylight-saving period
+        struct Date {
+            enum class Kind : uint8_t { Julian, ZeroBased, MonthWeekDay };
+            Kind kind = Kind::MonthWeekDay;
+            int day = 0;        ///< Jn day (1-365), n day (0-365) or weekday (0 = Sunday)
+            int month = 0;      ///< M form: 1-12
+            int week = 0;       ///< M form: 1-5 (5 = last)
+            int32_t time = 7200; ///< Local seconds after midnight (may be negative or > 24h)
+        };
+
+        int32_t stdOffset = 0;      ///< Seconds east of UTC outside daylight time
+        int32_t dstOffset = 0;      ///< Seconds east of UTC during daylight time
+        bool hasDst = false;        ///< False for fixed-offset rules
+        Date start;                 ///< Daylight time begins (local standard time)
+        Date end;                   ///< Daylight time ends (local daylight time)
+    };
+
+    std::vector<int64_t> transitions_;  ///< UTC instants where the offset changes, ascending
+    std::vector<int32_t> offsets_;      ///< offsets_[i] applies from transitions_[i]
+    int32_t initialOffset_ = 0;         ///< Offset before the first transition
+    std::optional<Rule> rule_;          ///< Daylight rule for instants past the expanded table
+    int64_t ruleHorizon_ = std::numeric_limits<int64_t>::max(); ///< First instant answered by rule_
+    int64_t bucketBase_ = 0;            ///< Start of the first lookup bucket
+    std::vector<uint32_t> buckets_;     ///< Transitions at or before each bucket's start
+
+    [[nodiscard]] static std::optional<Rule> parseRule(std::string_view text);
+    [[nodiscard]] static int64_t ruleInstant(const Rule::Date& date, int64_t year, int32_t offset) noexcept;
+    [[nodiscard]] static int32_t ruleOffset(const Rule& rule, int64_t utcSeconds) noexcept;
+    void expandRule(int64_t lastYear);  ///< Append rule transitions through lastYear
+    void buildIndex();                  ///< Fill buckets_ once the table is final
+};
+
+#endif // TIME_ZONE_HPP
@@ -13,6 +13,7 @@
 #ifndef UTILS_HPP
 #define UTILS_HPP
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <string_view>
@@ -201,6 +202,17 @@ namespace Utils {
      */
     [[nodiscard]] std::string generateRandomString(size_t length = 8);
 
+    /**
+     * @brief Fast non-cryptographic 64-bit hash of a byte range
+     * @param data Bytes to hash
+     * @param seed Optional seed to derive independent hash functions
+     * @return 64-bit hash value
+     *
+     * Processes eight bytes per step with xxHash-style multiply/rotate mixing
+     * and a final avalanche. Used for storage checksums, not security.
+     */
+    [[nodiscard]] uint64_t hash64(std::string_view data, uint64_t seed = 0) noexcept;
+
     /**
      * @brief Truncate string to maximum length with ellipsis
      * @param str String to truncate
@@ -39,6 +39,47 @@ duration_ms=$(( (end_time - start_time) / 1000000 ))
 
 echo "✅ Generated statistics in ${duration_ms}ms"
 
+# Test snapshot compression (on a scratch copy so the real data file is untouched)
+echo "🗜️  Testing snapshot compression..."
+compress_file=$(mktemp /tmp/todo_compress_XXXXXX.json)
+cp data/data.json "$compress_file" 2>/dev/null
+./todo storage --data-file "$compress_file" --format compressed -q > /dev/null 2>&1
+./todo storage --data-file "$compress_file" 2>/dev/null | grep -E "Raw size|Stored size|Ratio|Decode|Block read" | sed 's/^/   /'
+rm -f "$compress_file"
+
+echo "✅ Compression report complete"
+
+# Test the schema-generated codecs: JSON load, CSV export and CSV import of 20,000 tasks
+echo "🧬 Testing schema codecs..."
+codec_dir=$(mktemp -d /tmp/todo_codec_XXXXXX)
+{
+    echo "name,status,priority,due_date,tags,description"
+    for i in $(seq 1 20000); do
+        echo "Codec task $i,todo,medium,2030-01-01,bench;codec,\"Row $i, quoted\""
+    done
+} > "$codec_dir/input.csv"
+./todo import "$codec_dir/input.csv" --data-file "$codec_dir/a.json" -q > /dev/null 2>&1
+
+start_time=$(date +%s%N)
+./todo stats --data-file "$codec_dir/a.json" > /dev/null 2>&1
+end_time=$(date +%s%N)
+echo "   JSON load: $(( (end_time - start_time) / 1000000 ))ms"
+
+start_time=$(date +%s%N)
+./todo export "$codec_dir/out.csv" --data-file "$codec_dir/a.json" -q > /dev/null 2>&1
+end_time=$(date +%s%N)
+echo "   CSV export: $(( (end_time - start_time) / 1000000 ))ms"
+
+start_time=$(date +%s%N)
+./todo import "$codec_dir/out.csv" --data-file "$codec_dir/b.json" -q > /dev/null 2>&1
+end_time=$(date +%s%N)
+echo "   CSV import: $(( (end_time - start_time) / 1000000 ))ms"
+
+./todo diff "$codec_dir/a.json" "$codec_dir/b.json" 2>/dev/null | tail -1 | sed 's/^/   /'
+rm -rf "$codec_dir"
+
+echo "✅ Codec round trip complete"
+
 # Cleanup
 echo "🧹 Cleaning up test tasks..."
 task_count=$(./todo list -q 2>/dev/null | grep "Performance test task" | wc -l)
@@ -0,0 +1,45 @@
+#!/bin/bash
+
+# Regression checks for the todo application (run from the repository root after `make`)
+echo "🧪 Todo Application Regression Test"
+echo "===================================="
+
+failures=0
+
+# A watched batch holding a remove followed by an import must fall back to a full reload
+# without touching the removed task's slot
+echo "👀 Testing live view with a remove and an import in one batch..."
+dir=$(mktemp -d /tmp/todo_watch_XXXXXX)
+data="$dir/data.json"
+for i in 1 2 3; do
+    ./todo add "Watched task $i" --data-file "$data" -q > /dev/null 2>&1
+done
+printf '{"name":"Imported task","status":"todo","priority":"low"}\n' > "$dir/batch.ndjson"
+
+./todo list --watch --data-file "$data" > "$dir/view.out" 2>&1 &
+pid=$!
+sleep 1
+kill -STOP $pid    # Hold the view so both changes reach it as a single batch
+./todo remove 2 --data-file "$data" -q > /dev/null 2>&1
+./todo import "$dir/batch.ndjson" --data-file "$data" -q > /dev/null 2>&1
+kill -CONT $pid
+sleep 1
+kill -INT $pid 2>/dev/null
+wait $pid
+status=$?
+
+if [ $status -eq 0 ] && grep -q "Imported task" "$dir/view.out"; then
+    echo "✅ Live view reloaded after the batch"
+else
+    echo "❌ Live view exited with status $status"
+    failures=$((failures + 1))
+fi
+rm -rf "$dir"
+
+echo ""
+if [ $failures -eq 0 ]; then
+    echo "🎉 All regression checks passed"
+else
+    echo "💥 $failures regression check(s) failed"
+fi
+exit $failures
@@ -0,0 +1,326 @@
+/**
+ * @file BlockCodec.cpp
+ * @brief LZ77 block codec and block-framed container implementation
+ *
+ * The sequence format follows the well-known LZ4 block layout:
+ * a token byte (literal length in the high nibble, match length - 4 in the
+ * low nibble, 15 meaning "extended with 255-run bytes"), the literals, then a
+ * 16-bit little-endian match offset. The final sequence carries literals only.
+ */
+
+#include "BlockCodec.hpp"
+#include "ByteOrder.hpp"
+#include "Parallel.hpp"
+#include "utils.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+    using ByteOrder::getLE;
+    using ByteOrder::putLE;
+
+    constexpr size_t kMinMatch = 4;          ///< Shortest encodable match
+    constexpr size_t kLastLiterals = 5;      ///< Trailing bytes always emitted as literals
+    constexpr size_t kMaxOffset = 65535;     ///< 16-bit match window
+    constexpr int kHashBits = 14;            ///< Match finder table size (16K entries)
+    constexpr size_t kHeaderSize = 32;       ///< Fixed container header size
+    constexpr size_t kEntrySize = 32;        ///< Block table entry size
+
+    uint32_t read32(const char* p) noexcept {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    uint32_t hashPosition(uint32_t sequence) noexcept {
+        return (sequence * 2654435761U) >> (32 - kHashBits);
+    }
+
+    void putLength(std::string& out, size_t length) {
+        while (length >= 255) {
+            out.push_back(static_cast<char>(255));
+            length -= 255;
+        }
+        out.push_back(static_cast<char>(length));
+    }
+
+    void emitSequence(std::string& out, std::string_view literals, size_t offset, size_t matchLength) {
+        size_t literalLength = literals.size();
+        size_t matchCode = matchLength >= kMinMatch ? matchLength - kMinMatch : 0;
+
+        auto token = static_cast<uint8_t>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchCode, 15));
+        out.push_back(static_cast<char>(token));
+        if (literalLength >= 15) putLength(out, literalLength - 15);
+        out.append(literals);
+
+        if (matchLength == 0) return; // Final literal-only sequence
+
+        out.push_back(static_cast<char>(offset & 0xFF));
+        out.push_back(static_cast<char>(offset >> 8));
+        if (matchCode >= 15) putLength(out, matchCode - 15);
+    }
+
+    std::runtime_error corrupt(std::string_view what) {
+        return std::runtime_error("Corrupt compressed data: " + std::string{ what });
+    }
+
+    /**
+     * @brief Decode block index into its slot of the output buffer and verify it
+     */
+    void decodeInto(std::string_view container, const BlockCodec::BlockInfo& block, char* output) {
+        if (block.offset > container.size() || block.storedSize > container.size() - block.offset) {
+            throw corrupt("block extends past end of file");
+        }
+
+        std::string_view payload = container.substr(block.offset, block.storedSize);
+        if (block.flags & BlockCodec::BLOCK_STORED) {
+            if (payload.size() != block.rawSize) throw corrupt("stored block size mismatch");
+            std::memcpy(output, payload.data(), payload.size());
+        }
+        else {
+            BlockCodec::decompressBlock(payload, output, block.rawSize);
+        }
+
+        if (Utils::hash64({ output, block.rawSize }) != block.checksum) {
+            throw corrupt("block checksum mismatch");
+        }
+    }
+
+} // namespace
+
+namespace BlockCodec {
+
+    std::string compressBlock(std::string_view input) {
+        std::string out;
+        out.reserve(input.size() / 2 + 16);
+
+        const size_t n = input.size();
+        const char* base = input.data();
+        size_t anchor = 0;
+
+        if (n > kMinMatch + kLastLiterals) {
+            // Positions are stored +1 so zero means "empty slot"
+            std::vector<uint32_t> table(size_t{ 1 } << kHashBits, 0);
+            const size_t searchLimit = n - kMinMatch - kLastLiterals;
+            size_t ip = 0;
+            unsigned misses = 0;
+
+            while (ip <= searchLimit) {
+                uint32_t sequence = read32(base + ip);
+                uint32_t& slot = table[hashPosition(sequence)];
+                size_t candidate = slot;
+                slot = static_cast<uint32_t>(ip + 1);
+
+                if (candidate != 0 && ip - (candidate - 1) <= kMaxOffset && read32(base + candidate - 1) == sequence) {
+                    size_t ref = candidate - 1;
+                    size_t length = kMinMatch;
+                    while (ip + length < n - kLastLiterals && base[ref + length] == base[ip + length]) {
+                        ++length;
+                    }
+
+                    emitSequence(out, input.substr(anchor, ip - anchor), ip - ref, length);
+                    ip += length;
+                    anchor = ip;
+                    misses = 0;
+                }
+                else {
+                    // Skip faster through incompressible stretches
+                    ip += 1 + (misses++ >> 6);
+                }
+            }
+        }
+
+        emitSequence(out, input.substr(anchor), 0, 0);
+        return out;
+    }
+
+    void decompressBlock(std::string_view input, char* output, size_t outputSize) {
+        const auto* ip = reinterpret_cast<const uint8_t*>(input.data());
+        const auto* const iend = ip + input.size();
+        char* op = output;
+        char* const oend = output + outputSize;
+
+        auto readLength = [&](size_t length) {
+            uint8_t byte;
+            do {
+                if (ip >= iend) throw corrupt("truncated length");
+                byte = *ip++;
+                length += byte;
+                if (length > outputSize) throw corrupt("length exceeds block size");
+            } while (byte == 255);
+            return length;
+            };
+
+        while (true) {
+            if (ip >= iend) throw corrupt("missing sequence token");
+            uint8_t token = *ip++;
+
+            size_t literalLength = token >> 4;
+            if (literalLength == 15) literalLength = readLength(literalLength);
+            if (static_cast<size_t>(iend - ip) < literalLength || static_cast<size_t>(oend - op) < literalLength) {
+                throw corrupt("literal run out of bounds");
+            }
+            std::memcpy(op, ip, literalLength);
+            ip += literalLength;
+            op += literalLength;
+
+            if (ip == iend) break; // Last sequence has no match part
+
+            if (iend - ip < 2) throw corrupt("truncated match offset");
+            size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > static_cast<size_t>(op - output)) {
+                throw corrupt("match offset out of range");
+            }
+
+            size_t matchLength = token & 0x0F;
+            if (matchLength == 15) matchLength = readLength(matchLength);
+            matchLength += kMinMatch;
+            if (static_cast<size_t>(oend - op) < matchLength) throw corrupt("match overruns block");
+
+            const char* match = op - offset;
+            if (offset >= matchLength) {
+                std::memcpy(op, match, matchLength);
+            }
+            else {
+                // Overlapping copy replicates the last `offset` bytes (run-length case)
+                for (size_t i = 0; i < matchLength; ++i) op[i] = match[i];
+            }
+            op += matchLength;
+        }
+
+        if (op != oend) throw corrupt("decoded size mismatch");
+    }
+
+    bool isContainer(std::string_view data) noexcept {
+        return data.starts_with(MAGIC);
+    }
+
+    std::vector<std::string> compress(std::string_view raw, size_t blockSize) {
+        if (blockSize == 0 || blockSize > kMaxOffset + 1) {
+            throw std::invalid_argument("Block size must be between 1 byte and 64 KiB");
+        }
+
+        const size_t blockCount = (raw.size() + blockSize - 1) / blockSize;
+        std::vector<std::string> payloads(blockCount);
+        std::vector<BlockInfo> table(blockCount);
+
+        Parallel::forEachChunk(blockCount, Parallel::workerCount(blockCount, 4), [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                std::string_view block = raw.substr(i * blockSize, blockSize);
+                std::string packed = compressBlock(block);
+
+                table[i].rawSize = static_cast<uint32_t>(block.size());
+                table[i].checksum = Utils::hash64(block);
+                if (packed.size() >= block.size()) {
+                    payloads[i].assign(block);
+                    table[i].flags = BLOCK_STORED;
+                }
+                else {
+                    payloads[i] = std::move(packed);
+                }
+                table[i].storedSize = static_cast<uint32_t>(payloads[i].size());
+            }
+            });
+
+        // Offsets are only known once every block's compressed size is
+        uint64_t offset = kHeaderSize + blockCount * kEntrySize;
+        std::string tableBytes;
+        tableBytes.reserve(blockCount * kEntrySize);
+        for (auto& entry : table) {
+            entry.offset = offset;
+            offset += entry.storedSize;
+            putLE(tableBytes, entry.offset);
+            putLE(tableBytes, entry.storedSize);
+            putLE(tableBytes, entry.rawSize);
+            putLE(tableBytes, entry.checksum);
+            putLE(tableBytes, entry.flags);
+            putLE(tableBytes, uint32_t{ 0 }); // reserved
+        }
+
+        std::string header{ MAGIC };
+        putLE(header, VERSION);
+        putLE(header, static_cast<uint32_t>(blockSize));
+        putLE(header, static_cast<uint32_t>(blockCount));
+        putLE(header, static_cast<uint64_t>(raw.size()));
+        putLE(header, Utils::hash64(tableBytes));
+        header += tableBytes;
+
+        std::vector<std::string> buffers;
+        buffers.reserve(blockCount + 1);
+        buffers.push_back(std::move(header));
+        for (auto& payload : payloads) {
+            buffers.push_back(std::move(payload));
+        }
+        return buffers;
+    }
+
+    ContainerInfo readInfo(std::string_view container) {
+        if (container.size() < kHeaderSize || !isContainer(container)) {
+            throw corrupt("missing container header");
+        }
+        if (getLE<uint32_t>(container, 4) != VERSION) {
+            throw corrupt("unsupported container version");
+        }
+
+        ContainerInfo info;
+        info.blockSize = getLE<uint32_t>(container, 8);
+        auto blockCount = getLE<uint32_t>(container, 12);
+        info.rawSize = getLE<uint64_t>(container, 16);
+        auto tableChecksum = getLE<uint64_t>(container, 24);
+
+        if (info.blockSize == 0 || (container.size() - kHeaderSize) / kEntrySize < blockCount) {
+            throw corrupt("block table out of bounds");
+        }
+        if (static_cast<uint64_t>(blockCount) != (info.rawSize + info.blockSize - 1) / info.blockSize) {
+            throw corrupt("block count does not match raw size");
+        }
+
+        std::string_view tableBytes = container.substr(kHeaderSize, blockCount * kEntrySize);
+        if (Utils::hash64(tableBytes) != tableChecksum) {
+            throw corrupt("block table checksum mismatch");
+        }
+
+        info.blocks.resize(blockCount);
+        for (size_t i = 0; i < blockCount; ++i) {
+            size_t pos = i * kEntrySize;
+            auto& entry = info.blocks[i];
+            entry.offset = getLE<uint64_t>(tableBytes, pos);
+            entry.storedSize = getLE<uint32_t>(tableBytes, pos + 8);
+            entry.rawSize = getLE<uint32_t>(tableBytes, pos + 12);
+            entry.checksum = getLE<uint64_t>(tableBytes, pos + 16);
+            entry.flags = getLE<uint32_t>(tableBytes, pos + 24);
+
+            uint64_t expected = std::min<uint64_t>(info.blockSize, info.rawSize - i * uint64_t{ info.blockSize });
+            if (entry.rawSize != expected) throw corrupt("block raw size mismatch");
+        }
+
+        return info;
+    }
+
+    std::string decompressBlockAt(std::string_view container, const ContainerInfo& info, size_t index) {
+        if (index >= info.blocks.size()) {
+            throw std::out_of_range("Block index out of range");
+        }
+        std::string out(info.blocks[index].rawSize, '\0');
+        decodeInto(container, info.blocks[index], out.data());
+        return out;
+    }
+
+    std::string decompress(std::string_view container) {
+        ContainerInfo info = readInfo(container);
+        std::string raw(info.rawSize, '\0');
+
+        // Blocks decode into disjoint slices of the output, so no coordination is needed
+        const size_t blockCount = info.blocks.size();
+        Parallel::forEachChunk(blockCount, Parallel::workerCount(blockCount, 4), [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                decodeInto(container, info.blocks[i], raw.data() + i * info.blockSize);
+            }
+            });
+
+        return raw;
+    }
+
+} // namespace BlockCodec
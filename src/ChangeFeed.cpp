@@ -0,0 +1,248 @@
+/**
+ * @file ChangeFeed.cpp
+ * @brief Change feed encoding, tail recovery and sequence lookup
+ */
+
+#include "ChangeFeed.hpp"
+#include "TaskStorage.hpp"
+#include "TextFormat.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <set>
+
+namespace {
+
+    constexpr std::string_view kSeqPrefix = "{\"seq\":";
+    constexpr uint64_t kScanWindow = 64 * 1024; ///< Stop bisecting once the range is this small
+    constexpr size_t kReadBlock = 4096;
+
+    // Read the sequence number from a line prefix without parsing the record
+    std::optional<uint64_t> lineSequence(std::string_view line) {
+        if (!line.starts_with(kSeqPrefix)) {
+            return std::nullopt;
+        }
+        line.remove_prefix(kSeqPrefix.size());
+        uint64_t seq = 0;
+        auto [end, ec] = std::from_chars(line.data(), line.data() + line.size(), seq);
+        if (ec != std::errc{} || end == line.data() + line.size() || *end != ',') {
+            return std::nullopt;
+        }
+        return seq;
+    }
+
+    // Offset of the first line starting at or after pos (size if none)
+    uint64_t lineStartAtOrAfter(std::ifstream& file, uint64_t pos, uint64_t size) {
+        if (pos == 0) {
+            return 0;
+        }
+
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(pos - 1));
+        char block[kReadBlock];
+        while (pos - 1 < size) {
+            file.read(block, sizeof(block));
+            auto got = static_cast<size_t>(file.gcount());
+            if (got == 0) break;
+            if (auto* newline = std::find(block, block + got, '\n'); newline != block + got) {
+                return pos + static_cast<uint64_t>(newline - block);
+            }
+            pos += got;
+        }
+        return size;
+    }
+
+    std::optional<uint64_t> sequenceAt(std::ifstream& file, uint64_t pos) {
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(pos));
+        char prefix[32] = {};
+        file.read(prefix, sizeof(prefix));
+        return lineSequence({ prefix, static_cast<size_t>(file.gcount()) });
+    }
+
+    /**
+     * @struct Tail
+     * @brief End of the last complete line and its sequence number
+     */
+    struct Tail {
+        uint64_t validSize = 0;
+        uint64_t lastSeq = 0;
+    };
+
+    // A crash mid-append can leave a partial last line; everything before it is intact
+    Tail readTail(const std::filesystem::path& path) {
+        Tail tail;
+        if (!std::filesystem::exists(path)) {
+            return tail;
+        }
+
+        std::ifstream file(path, std::ios::binary);
+        uint64_t size = std::filesystem::file_size(path);
+        std::string window;
+        uint64_t begin = size;
+        while (begin > 0) {
+            uint64_t step = std::min<uint64_t>(begin, std::max<uint64_t>(kReadBlock, window.size()));
+            begin -= step;
+            std::string chunk(step, '\0');
+            file.clear();
+            file.seekg(static_cast<std::streamoff>(begin));
+            file.read(chunk.data(), static_cast<std::streamsize>(step));
+            window.insert(0, chunk);
+
+            // Need the last newline and the line start before it
+            auto lastNewline = window.rfind('\n');
+            if (lastNewline == std::string::npos) continue;
+            auto lineStart = lastNewline == 0 ? std::string::npos : window.rfind('\n', lastNewline - 1);
+            if (lineStart == std::string::npos && begin > 0) continue;
+
+            size_t start = lineStart == std::string::npos ? 0 : lineStart + 1;
+            tail.validSize = begin + lastNewline + 1;
+            tail.lastSeq = lineSequence(std::string_view{ window }.substr(start, lastNewline - start)).value_or(0);
+            return tail;
+        }
+        return tail;
+    }
+
+} // namespace
+
+// ======================
+// Events
+// ======================
+
+std::optional<ChangeFeed::Event> ChangeFeed::diff(const nlohmann::json* before, const nlohmann::json* after) {
+    if (!before && !after) {
+        return std::nullopt;
+    }
+
+    Event event;
+    event.id = (after ? *after : *before).at("id").get<int>();
+    if (!before) {
+        event.type = "add";
+        event.after = *after;
+        return event;
+    }
+    if (!after) {
+        event.type = "remove";
+        event.before = *before;
+        return event;
+    }
+
+    std::set<std::string> keys;
+    for (const auto& [key, value] : before->items()) keys.insert(key);
+    for (const auto& [key, value] : after->items()) keys.insert(key);
+
+    bool onlyTags = true;
+    bool onlyDue = true;
+    for (const auto& key : keys) {
+        auto was = before->contains(key) ? (*before)[key] : nlohmann::json{};
+        auto now = after->contains(key) ? (*after)[key] : nlohmann::json{};
+        if (was == now) continue;
+
+        event.before[key] = std::move(was);
+        event.after[key] = std::move(now);
+        onlyTags = onlyTags && key == "tags";
+        onlyDue = onlyDue && key == "due_date";
+    }
+
+    if (event.after.is_null()) {
+        return std::nullopt;
+    }
+    event.type = onlyTags ? "tag" : onlyDue ? "due" : "update";
+    return event;
+}
+
+// ======================
+// Feed File
+// ======================
+
+std::filesystem::path ChangeFeed::pathFor(const std::filesystem::path& dataFile) {
+    auto feed = dataFile;
+    feed.replace_filename(dataFile.stem().string() + ".changes.jsonl");
+    return feed;
+}
+
+ChangeFeed::ChangeFeed(std::filesystem::path dataFile) : path_(pathFor(dataFile)) {}
+
+void ChangeFeed::append(std::span<const Event> events) {
+    if (events.empty()) {
+        return;
+    }
+
+    // Drop a torn last line so the new records start on a line boundary
+    auto tail = readTail(path_);
+    if (std::filesystem::exists(path_) && std::filesystem::file_size(path_) > tail.validSize) {
+        std::filesystem::resize_file(path_, tail.validSize);
+    }
+
+    auto now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    uint64_t seq = tail.lastSeq;
+    std::string lines;
+    for (const auto& event : events) {
+        nlohmann::json body{
+            {"type", event.type},
+            {"id", event.id},
+            {"before", event.before},
+            {"after", event.after},
+            {"time", now}
+        };
+        lines += kSeqPrefix;
+        TextFormat::appendInt(lines, ++seq);
+        lines += ',';
+        lines += std::string_view{ body.dump() }.substr(1);
+        lines += '\n';
+    }
+
+    TaskStorage::appendDurably(path_, lines, "change feed");
+    lastSeq_ = seq;
+}
+
+uint64_t ChangeFeed::lastSequence() const {
+    if (!lastSeq_) {
+        lastSeq_ = readTail(path_).lastSeq;
+    }
+    return *lastSeq_;
+}
+
+uint64_t ChangeFeed::readSince(uint64_t since, const std::function<void(std::string_view)>& visit) const {
+    if (!std::filesystem::exists(path_)) {
+        return since;
+    }
+
+    std::ifstream file(path_, std::ios::binary);
+    const uint64_t size = std::filesystem::file_size(path_);
+
+    // Bisect on byte offsets to the last line start known to be at or before `since`
+    uint64_t low = 0;
+    uint64_t high = size;
+    while (high - low > kScanWindow) {
+        uint64_t mid = low + (high - low) / 2;
+        uint64_t start = lineStartAtOrAfter(file, mid, size);
+        auto seq = start < size ? sequenceAt(file, start) : std::nullopt;
+        if (seq && *seq <= since) {
+            low = start;
+        }
+        else {
+            high = mid;
+        }
+    }
+
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(low));
+    uint64_t last = since;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (file.eof()) {
+            break; // No trailing newline: a torn append
+        }
+        if (auto seq = lineSequence(line); seq && *seq > since) {
+            visit(line);
+            last = *seq;
+        }
+    }
+    return last;
+}
+
+const std::filesystem::path& ChangeFeed::path() const noexcept {
+    return path_;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file ContentIndex.cpp
+ * @brief Range hashing and top-down comparison of task stores
+ */
+
+#include "ContentIndex.hpp"
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+    constexpr size_t kLeafEntries = 16; ///< Ranges this small are compared entry by entry
+
+} // namespace
+
+ContentIndex::ContentIndex(std::vector<Entry> entries) : entries_(std::move(entries)) {
+    std::ranges::sort(entries_, {}, &Entry::id);
+    prefix_.resize(entries_.size() + 1, 0);
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        prefix_[i + 1] = prefix_[i] + entries_[i].hash; // Wraps modulo 2^64 by design
+    }
+}
+
+size_t ContentIndex::lowerBound(int64_t id) const {
+    auto it = std::ranges::lower_bound(entries_, id, {}, [](const Entry& entry) { return static_cast<int64_t>(entry.id); });
+    return static_cast<size_t>(it - entries_.begin());
+}
+
+uint64_t ContentIndex::rangeHash(int64_t low, int64_t high) const {
+    if (entries_.empty() || low >= high) {
+        return 0;
+    }
+    return prefix_[lowerBound(high)] - prefix_[lowerBound(low)];
+}
+
+uint64_t ContentIndex::rootHash() const noexcept {
+    return prefix_.empty() ? 0 : prefix_.back();
+}
+
+size_t ContentIndex::size() const noexcept {
+    return entries_.size();
+}
+
+std::optional<uint64_t> ContentIndex::find(int id) const {
+    size_t at = lowerBound(id);
+    if (at < entries_.size() && entries_[at].id == id) {
+        return entries_[at].hash;
+    }
+    return std::nullopt;
+}
+
+const std::vector<ContentIndex::Entry>& ContentIndex::entries() const noexcept {
+    return entries_;
+}
+
+ContentIndex::Comparison ContentIndex::compare(const ContentIndex& first, const ContentIndex& second) {
+    Comparison result;
+    if (first.entries_.empty() && second.entries_.empty()) {
+        return result;
+    }
+
+    // Cover every ID present on either side
+    int64_t low = INT64_MAX;
+    int64_t high = INT64_MIN;
+    for (const auto* index : { &first, &second }) {
+        if (!index->entries_.empty()) {
+            low = std::min<int64_t>(low, index->entries_.front().id);
+            high = std::max<int64_t>(high, index->entries_.back().id + int64_t{ 1 });
+        }
+    }
+
+    std::function<void(int64_t, int64_t)> descend = [&](int64_t rangeLow, int64_t rangeHigh) {
+        ++result.rangesCompared;
+        size_t a0 = first.lowerBound(rangeLow), a1 = first.lowerBound(rangeHigh);
+        size_t b0 = second.lowerBound(rangeLow), b1 = second.lowerBound(rangeHigh);
+        if (a1 - a0 == b1 - b0 && first.prefix_[a1] - first.prefix_[a0] == second.prefix_[b1] - second.prefix_[b0]) {
+            return; // Same tasks with the same contents
+        }
+
+        // Small ranges are cheaper to merge than to split further
+        if ((a1 - a0) + (b1 - b0) <= kLeafEntries || rangeHigh - rangeLow == 1) {
+            while (a0 < a1 || b0 < b1) {
+                if (b0 == b1 || (a0 < a1 && first.entries_[a0].id < second.entries_[b0].id)) {
+                    result.ids.push_back(first.entries_[a0++].id);
+                }
+                else if (a0 == a1 || second.entries_[b0].id < first.entries_[a0].id) {
+                    result.ids.push_back(second.entries_[b0++].id);
+                }
+                else {
+                    if (first.entries_[a0].hash != second.entries_[b0].hash) {
+                        result.ids.push_back(first.entries_[a0].id);
+                    }
+                    ++a0;
+                    ++b0;
+                }
+            }
+            return;
+        }
+
+        int64_t middle = rangeLow + (rangeHigh - rangeLow) / 2;
+        descend(rangeLow, middle);
+        descend(middle, rangeHigh);
+    };
+    descend(low, high);
+    return result;
+}
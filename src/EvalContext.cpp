@@ -0,0 +1,30 @@
+/**
+ * @file EvalContext.cpp
+ * @brief Construction and calendar arithmetic for EvalContext
+ */
+
+#include "EvalContext.hpp"
+#include "TimeZone.hpp"
+
+namespace {
+
+    constexpr int64_t kSecondsPerDay = 86400;
+
+    int64_t localDay(std::chrono::system_clock::time_point instant) {
+        return TimeZone::local().localDay(std::chrono::system_clock::to_time_t(instant));
+    }
+
+} // anonymous namespace
+
+EvalContext EvalContext::at(std::chrono::system_clock::time_point instant) {
+    const int64_t midnight = TimeZone::local().toUtc(localDay(instant) * kSecondsPerDay);
+    return { instant, std::chrono::system_clock::from_time_t(static_cast<std::time_t>(midnight)) };
+}
+
+EvalContext EvalContext::current() {
+    return at(std::chrono::system_clock::now());
+}
+
+std::chrono::days EvalContext::daysUntil(std::chrono::system_clock::time_point instant) const {
+    return std::chrono::days{ localDay(instant) - localDay(today) };
+}
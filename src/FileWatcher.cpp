@@ -0,0 +1,84 @@
+/**
+ * @file FileWatcher.cpp
+ * @brief inotify-based directory watch
+ */
+
+#include "FileWatcher.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace {
+
+    std::runtime_error systemError(std::string_view what, const std::filesystem::path& path) {
+        return std::runtime_error(std::string{ what } + " " + path.string() + ": " + std::strerror(errno));
+    }
+
+} // namespace
+
+FileWatcher::FileWatcher(const std::filesystem::path& directory) {
+    auto target = directory.empty() ? std::filesystem::path(".") : directory;
+    fd_ = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (fd_ < 0) {
+        throw systemError("Cannot watch", target);
+    }
+    if (inotify_add_watch(fd_, target.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE) < 0) {
+        auto error = systemError("Cannot watch", target);
+        ::close(fd_);
+        throw error;
+    }
+}
+
+FileWatcher::~FileWatcher() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+bool FileWatcher::drain(std::set<std::string>& names) {
+    alignas(inotify_event) char buffer[16 * 1024];
+    while (true) {
+        ssize_t got = ::read(fd_, buffer, sizeof(buffer));
+        if (got < 0) {
+            if (errno == EAGAIN) return true;
+            if (errno == EINTR) return false;
+            throw std::runtime_error(std::string{ "Watch failed: " } + std::strerror(errno));
+        }
+
+        for (ssize_t offset = 0; offset < got;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            if (event->mask & IN_Q_OVERFLOW) {
+                names.emplace(); // Events were dropped; the caller cannot tell what changed
+            }
+            else if (event->len > 0) {
+                names.emplace(event->name);
+            }
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+    }
+}
+
+std::optional<std::set<std::string>> FileWatcher::wait(std::chrono::milliseconds settle) {
+    std::set<std::string> names;
+    pollfd watch{ fd_, POLLIN, 0 };
+
+    // Sleep until the first event, then keep collecting until the directory goes quiet
+    int timeout = -1;
+    while (true) {
+        int ready = ::poll(&watch, 1, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) return std::nullopt;
+            throw std::runtime_error(std::string{ "Watch failed: " } + std::strerror(errno));
+        }
+        if (ready == 0) {
+            return names;
+        }
+        if (!drain(names)) {
+            return std::nullopt;
+        }
+        timeout = static_cast<int>(settle.count());
+    }
+}
@@ -0,0 +1,107 @@
+/**
+ * @file LiveView.cpp
+ * @brief Line-diffing terminal renderer
+ */
+
+#include "LiveView.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace {
+
+    constexpr std::string_view kHideCursor = "\033[?25l";
+    constexpr std::string_view kShowCursor = "\033[?25h";
+    constexpr std::string_view kClearScreen = "\033[H\033[2J";
+    constexpr std::string_view kClearToLineEnd = "\033[K";
+    constexpr std::string_view kClearToScreenEnd = "\033[J";
+
+    void writeAll(std::string_view bytes) {
+        std::cout.flush();
+        while (!bytes.empty()) {
+            ssize_t written = ::write(STDOUT_FILENO, bytes.data(), bytes.size());
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return;
+            }
+            bytes.remove_prefix(static_cast<size_t>(written));
+        }
+    }
+
+    std::vector<std::string> splitLines(std::string_view text, size_t limit) {
+        std::vector<std::string> lines;
+        while (!text.empty() && lines.size() < limit) {
+            auto end = text.find('\n');
+            lines.emplace_back(text.substr(0, end));
+            text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+        }
+        return lines;
+    }
+
+} // namespace
+
+LiveView::LiveView() {
+    writeAll(kHideCursor);
+}
+
+LiveView::~LiveView() {
+    writeAll("\033[" + std::to_string(lines_.size() + 1) + ";1H" + std::string{ kShowCursor });
+}
+
+size_t LiveView::terminalRows() {
+    winsize size{};
+    if (::ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0) {
+        return size.ws_row;
+    }
+    return 24;
+}
+
+size_t LiveView::draw(std::string_view frame) {
+    // Keep the last row free so writing the bottom line never scrolls the screen
+    auto next = splitLines(frame, std::max<size_t>(terminalRows(), 2) - 1);
+
+    std::string out;
+    if (clearPending_) {
+        out += kClearScreen;
+        lines_.clear();
+        cursorRow_ = 0;
+        clearPending_ = false;
+    }
+
+    // Cheapest move to the start of a row: carriage return, newline, or an absolute position
+    auto moveTo = [&](size_t row) {
+        if (row == cursorRow_) {
+            out += '\r';
+        }
+        else if (row == cursorRow_ + 1) {
+            out += "\r\n";
+        }
+        else {
+            out += "\033[" + std::to_string(row + 1) + ";1H";
+        }
+        cursorRow_ = row;
+    };
+
+    for (size_t row = 0; row < next.size(); ++row) {
+        if (row < lines_.size() && lines_[row] == next[row]) {
+            continue;
+        }
+        moveTo(row);
+        out += next[row];
+        out += kClearToLineEnd;
+    }
+    if (next.size() < lines_.size()) {
+        moveTo(next.size());
+        out += kClearToScreenEnd;
+    }
+
+    lines_ = std::move(next);
+    writeAll(out);
+    return out.size();
+}
+
+void LiveView::invalidate() {
+    clearPending_ = true;
+}
@@ -0,0 +1,705 @@
+/**
+ * @file LsmStore.cpp
+ * @brief Write-ahead log, sorted runs and compaction for the task store
+ */
+
+#include "LsmStore.hpp"
+#include "ByteOrder.hpp"
+#include "Parallel.hpp"
+#include "TaskJson.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+
+    using ByteOrder::getLE;
+    using ByteOrder::putLE;
+
+    // ======================
+    // Write-Ahead Log Encoding
+    // ======================
+
+    // Log records are framed as [u32 body length][u64 body checksum][body], where the
+    // body is a kind byte followed by an i32 ID and, for puts, the task JSON. The ID is
+    // outside the JSON so replay can partition records without parsing them.
+    constexpr size_t kFrameSize = 12;
+    constexpr uint8_t kPut = 1;         ///< Legacy put: task JSON only (still replayed)
+    constexpr uint8_t kDelete = 2;
+    constexpr uint8_t kPutById = 3;
+
+    constexpr size_t kDecodeBatch = 256; ///< Records per replay worker before fanning out
+
+    void appendFrame(std::string& out, std::string_view body) {
+        putLE(out, static_cast<uint32_t>(body.size()));
+        putLE(out, Utils::hash64(body));
+        out += body;
+    }
+
+    /**
+     * @struct LogFrame
+     * @brief A validated log record whose payload has not been decoded yet
+     */
+    struct LogFrame {
+        int id = 0;
+        uint8_t kind = 0;
+        std::string_view payload;     ///< Task JSON (puts only), pointing into the log buffer
+        std::optional<Task> legacy;   ///< Legacy puts are decoded up front to learn their ID
+    };
+
+    std::optional<LogFrame> decodeFrame(std::string_view body) {
+        LogFrame frame;
+        frame.kind = static_cast<uint8_t>(body[0]);
+        if ((frame.kind == kPutById && body.size() >= 5) || (frame.kind == kDelete && body.size() == 5)) {
+            frame.id = getLE<int32_t>(body, 1);
+            frame.payload = body.substr(5);
+            return frame;
+        }
+        if (frame.kind == kPut) {
+            frame.legacy = TaskJson::parseTask(body.substr(1));
+            frame.id = frame.legacy->getId();
+            return frame;
+        }
+        return std::nullopt;
+    }
+
+    std::optional<Task> decodeFramePayload(const LogFrame& frame) {
+        if (frame.kind == kDelete) return std::nullopt;
+        if (frame.legacy) return frame.legacy;
+        return TaskJson::parseTask(frame.payload);
+    }
+
+    // ======================
+    // Sorted Run Encoding
+    // ======================
+
+    // Runs: 32-byte header, id-sorted 32-byte entries, then compact JSON payloads
+    constexpr std::string_view kRunMagic = "TDR1";
+    constexpr uint32_t kRunVersion = 1;
+    constexpr size_t kRunHeaderSize = 32;   ///< Magic, version, count, tombstones, reserved, entry table checksum
+    constexpr size_t kRunEntrySize = 32;    ///< id, flags, offset, length, reserved, payload checksum
+    constexpr uint32_t kTombstone = 1;      ///< Entry flag: ID was deleted
+
+    std::runtime_error corruptRun(const std::filesystem::path& path, std::string_view what) {
+        return std::runtime_error(std::format("Corrupt run {}: {}", path.string(), what));
+    }
+
+    std::string encodeRun(const std::map<int, std::optional<Task>>& records, uint32_t& tasks, uint32_t& tombstones) {
+        std::string entries;
+        std::string payloads;
+        const uint64_t payloadBase = kRunHeaderSize + records.size() * kRunEntrySize;
+        tasks = tombstones = 0;
+
+        for (const auto& [id, record] : records) {
+            std::string payload = record ? TaskJson::dumpCompact(*record) : std::string{};
+            putLE(entries, static_cast<int32_t>(id));
+            putLE(entries, record ? uint32_t{ 0 } : kTombstone);
+            putLE(entries, payloadBase + payloads.size());
+            putLE(entries, static_cast<uint32_t>(payload.size()));
+            putLE(entries, uint32_t{ 0 }); // reserved
+            putLE(entries, Utils::hash64(payload));
+            payloads += payload;
+            ++(record ? tasks : tombstones);
+        }
+
+        std::string run{ kRunMagic };
+        putLE(run, kRunVersion);
+        putLE(run, static_cast<uint32_t>(records.size()));
+        putLE(run, tombstones);
+        putLE(run, uint64_t{ 0 }); // reserved
+        putLE(run, Utils::hash64(entries));
+        run += entries;
+        run += payloads;
+        return run;
+    }
+
+    /**
+     * @brief Decode entry index of a run already read into memory
+     */
+    std::optional<Task> decodeRunRecord(const std::filesystem::path& path, std::string_view run, size_t index, int& id) {
+        size_t pos = kRunHeaderSize + index * kRunEntrySize;
+        id = getLE<int32_t>(run, pos);
+        if (getLE<uint32_t>(run, pos + 4) & kTombstone) {
+            return std::nullopt;
+        }
+
+        auto offset = getLE<uint64_t>(run, pos + 8);
+        auto length = getLE<uint32_t>(run, pos + 16);
+        if (offset > run.size() || length > run.size() - offset) {
+            throw corruptRun(path, "payload out of bounds");
+        }
+        std::string_view payload = run.substr(offset, length);
+        if (Utils::hash64(payload) != getLE<uint64_t>(run, pos + 24)) {
+            throw corruptRun(path, "payload checksum mismatch");
+        }
+        return TaskJson::parseTask(payload);
+    }
+
+    Task decodeRunTask(const std::filesystem::path& path, std::string_view run, size_t index) {
+        int id = 0;
+        auto task = decodeRunRecord(path, run, index, id);
+        if (!task) {
+            throw corruptRun(path, "tombstone where a task was expected");
+        }
+        return std::move(*task);
+    }
+
+    /**
+     * @struct RecordRef
+     * @brief Where the surviving version of a replayed task lives
+     */
+    struct RecordRef {
+        size_t run = 0;             ///< Run index (when task is null)
+        uint32_t entry = 0;         ///< Entry within the run
+        const Task* task = nullptr; ///< Memtable version, if it came from the log
+        bool set = false;           ///< Whether the slot has a version to decode
+
+        [[nodiscard]] bool live() const noexcept { return set; }
+    };
+
+    /**
+     * @brief Validate a run's header and entry table
+     * @return Number of entries
+     */
+    uint32_t checkRun(const std::filesystem::path& path, std::string_view run) {
+        if (run.size() < kRunHeaderSize || !run.starts_with(kRunMagic) || getLE<uint32_t>(run, 4) != kRunVersion) {
+            throw corruptRun(path, "bad header");
+        }
+        auto count = getLE<uint32_t>(run, 8);
+        if ((run.size() - kRunHeaderSize) / kRunEntrySize < count) {
+            throw corruptRun(path, "entry table out of bounds");
+        }
+        if (Utils::hash64(run.substr(kRunHeaderSize, count * kRunEntrySize)) != getLE<uint64_t>(run, 24)) {
+            throw corruptRun(path, "entry table checksum mismatch");
+        }
+        return count;
+    }
+
+    /**
+     * @brief Binary search one run for an ID, reading only the probed entries
+     * @return nullopt if absent; otherwise the record (itself nullopt for a tombstone)
+     */
+    std::optional<std::optional<Task>> lookupRun(const std::filesystem::path& path, int id) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            throw corruptRun(path, "missing file");
+        }
+
+        auto readAt = [&](uint64_t offset, size_t size) {
+            std::string bytes(size, '\0');
+            file.seekg(static_cast<std::streamoff>(offset));
+            file.read(bytes.data(), static_cast<std::streamsize>(size));
+            if (file.gcount() != static_cast<std::streamsize>(size)) {
+                throw corruptRun(path, "truncated");
+            }
+            return bytes;
+            };
+
+        std::string header = readAt(0, kRunHeaderSize);
+        if (!header.starts_with(kRunMagic) || getLE<uint32_t>(header, 4) != kRunVersion) {
+            throw corruptRun(path, "bad header");
+        }
+
+        size_t low = 0, high = getLE<uint32_t>(header, 8);
+        while (low < high) {
+            size_t mid = low + (high - low) / 2;
+            std::string entry = readAt(kRunHeaderSize + mid * kRunEntrySize, kRunEntrySize);
+            int entryId = getLE<int32_t>(entry, 0);
+            if (entryId < id) {
+                low = mid + 1;
+            }
+            else if (entryId > id) {
+                high = mid;
+            }
+            else if (getLE<uint32_t>(entry, 4) & kTombstone) {
+                return std::optional<Task>{};
+            }
+            else {
+                std::string payload = readAt(getLE<uint64_t>(entry, 8), getLE<uint32_t>(entry, 16));
+                if (Utils::hash64(payload) != getLE<uint64_t>(entry, 24)) {
+                    throw corruptRun(path, "payload checksum mismatch");
+                }
+                return std::optional<Task>{ TaskJson::parseTask(payload) };
+            }
+        }
+        return std::nullopt;
+    }
+
+} // namespace
+
+// ======================
+// Construction and Manifest
+// ======================
+
+double LsmStore::Stats::writeAmplification() const noexcept {
+    uint64_t physical = walBytes + flushBytes + compactionBytes + checkpointBytes;
+    return logicalBytes == 0 ? 0.0 : static_cast<double>(physical) / static_cast<double>(logicalBytes);
+}
+
+LsmStore::Stats& LsmStore::Stats::operator+=(const Stats& other) noexcept {
+    logicalBytes += other.logicalBytes;
+    walBytes += other.walBytes;
+    flushBytes += other.flushBytes;
+    compactionBytes += other.compactionBytes;
+    checkpointBytes += other.checkpointBytes;
+    flushes += other.flushes;
+    compactions += other.compactions;
+    checkpoints += other.checkpoints;
+    tombstonesDropped += other.tombstonesDropped;
+    return *this;
+}
+
+LsmStore::ReplayReport& LsmStore::ReplayReport::operator+=(const ReplayReport& other) noexcept {
+    records += other.records;
+    bytes += other.bytes;
+    seconds += other.seconds;
+    return *this;
+}
+
+LsmStore::LsmStore(std::filesystem::path dataFile)
+    : dataFile_(std::move(dataFile)), walFile_(dataFile_), manifestFile_(dataFile_) {
+    walFile_.replace_filename(dataFile_.stem().string() + ".journal");
+    manifestFile_.replace_filename(dataFile_.stem().string() + ".lsm.json");
+
+    if (!std::filesystem::exists(manifestFile_)) {
+        return;
+    }
+
+    try {
+        auto j = nlohmann::json::parse(TaskStorage::readFile(manifestFile_));
+        nextRun_ = j.value("nextRun", uint64_t{ 1 });
+        for (const auto& run : j.value("runs", nlohmann::json::array())) {
+            runs_.push_back({ run.at("file"), run.at("tasks"), run.at("tombstones"), run.at("bytes") });
+        }
+
+        const auto& s = j.at("stats");
+        stats_.logicalBytes = s.value("logicalBytes", uint64_t{ 0 });
+        stats_.walBytes = s.value("walBytes", uint64_t{ 0 });
+        stats_.flushBytes = s.value("flushBytes", uint64_t{ 0 });
+        stats_.compactionBytes = s.value("compactionBytes", uint64_t{ 0 });
+        stats_.checkpointBytes = s.value("checkpointBytes", uint64_t{ 0 });
+        stats_.flushes = s.value("flushes", uint64_t{ 0 });
+        stats_.compactions = s.value("compactions", uint64_t{ 0 });
+        stats_.checkpoints = s.value("checkpoints", uint64_t{ 0 });
+        stats_.tombstonesDropped = s.value("tombstonesDropped", uint64_t{ 0 });
+    }
+    catch (const std::exception& e) {
+        throw std::runtime_error(std::format("Corrupt manifest {}: {}", manifestFile_.string(), e.what()));
+    }
+}
+
+void LsmStore::saveManifest() const {
+    nlohmann::json runs = nlohmann::json::array();
+    for (const auto& run : runs_) {
+        runs.push_back({ {"file", run.file}, {"tasks", run.tasks}, {"tombstones", run.tombstones}, {"bytes", run.bytes} });
+    }
+
+    nlohmann::json j{
+        {"version", 1},
+        {"nextRun", nextRun_},
+        {"runs", runs},
+        {"stats", {
+            {"logicalBytes", stats_.logicalBytes},
+            {"walBytes", stats_.walBytes},
+            {"flushBytes", stats_.flushBytes},
+            {"compactionBytes", stats_.compactionBytes},
+            {"checkpointBytes", stats_.checkpointBytes},
+            {"flushes", stats_.flushes},
+            {"compactions", stats_.compactions},
+            {"checkpoints", stats_.checkpoints},
+            {"tombstonesDropped", stats_.tombstonesDropped}
+        }}
+    };
+
+    std::string buffers[] = { j.dump(4) };
+    TaskStorage::writeBuffers(manifestFile_, buffers);
+}
+
+std::filesystem::path LsmStore::runPath(const RunInfo& run) const {
+    return dataFile_.has_parent_path() ? dataFile_.parent_path() / run.file : std::filesystem::path{ run.file };
+}
+
+// ======================
+// Memtable and Log
+// ======================
+
+std::map<int, LsmStore::Record>& LsmStore::memtable() const {
+    if (memtable_) {
+        return *memtable_;
+    }
+
+    memtable_.emplace();
+    walBytes_ = walLogicalBytes_ = walRecords_ = 0;
+    walTorn_ = false;
+    if (!std::filesystem::exists(walFile_)) {
+        return *memtable_;
+    }
+
+    // Phase 1 (sequential): validate framing and checksums, and find the latest frame per ID
+    std::string log = TaskStorage::readFile(walFile_);
+    std::string_view view{ log };
+    std::vector<LogFrame> frames;
+    std::unordered_map<int, size_t> latest;
+    for (size_t pos = 0; pos + kFrameSize <= view.size();) {
+        auto length = getLE<uint32_t>(view, pos);
+        if (length == 0 || length > view.size() - pos - kFrameSize) {
+            break; // Torn tail from an interrupted append; everything before it is intact
+        }
+        std::string_view body = view.substr(pos + kFrameSize, length);
+        if (Utils::hash64(body) != getLE<uint64_t>(view, pos + 4)) {
+            break;
+        }
+
+        auto frame = decodeFrame(body);
+        if (!frame) {
+            break;
+        }
+        latest.insert_or_assign(frame->id, frames.size());
+        frames.push_back(std::move(*frame));
+
+        walBytes_ += kFrameSize + length;
+        walLogicalBytes_ += length - 1;
+        ++walRecords_;
+        pos += kFrameSize + length;
+    }
+    walTorn_ = walBytes_ < view.size();
+
+    // Phase 2 (parallel): decode only the surviving version of each ID
+    std::vector<size_t> winners;
+    winners.reserve(latest.size());
+    for (const auto& [id, index] : latest) {
+        winners.push_back(index);
+    }
+
+    std::vector<Record> decoded(winners.size());
+    Parallel::forEachChunk(winners.size(), Parallel::workerCount(winners.size(), kDecodeBatch), [&](size_t, size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            decoded[k] = decodeFramePayload(frames[winners[k]]);
+        }
+        });
+
+    for (size_t k = 0; k < winners.size(); ++k) {
+        memtable_->insert_or_assign(frames[winners[k]].id, std::move(decoded[k]));
+    }
+    return *memtable_;
+}
+
+void LsmStore::write(std::span<const Task* const> puts, std::span<const int> deletes) {
+    auto& table = memtable();
+
+    std::string records;
+    uint64_t logical = 0;
+    for (const Task* task : puts) {
+        std::string body(1, static_cast<char>(kPutById));
+        putLE(body, static_cast<int32_t>(task->getId()));
+        TaskJson::appendCompact(body, *task);
+        logical += body.size() - 1;
+        appendFrame(records, body);
+    }
+    for (int id : deletes) {
+        std::string body(1, static_cast<char>(kDelete));
+        putLE(body, static_cast<int32_t>(id));
+        logical += body.size() - 1;
+        appendFrame(records, body);
+    }
+    if (records.empty()) {
+        return;
+    }
+
+    // Appends after a torn tail would sit behind it, where replay never reaches
+    if (walTorn_) {
+        std::filesystem::resize_file(walFile_, walBytes_);
+        walTorn_ = false;
+    }
+    TaskStorage::appendDurably(walFile_, records, "write-ahead log");
+    walBytes_ += records.size();
+    walLogicalBytes_ += logical;
+    walRecords_ += puts.size() + deletes.size();
+
+    for (const Task* task : puts) {
+        table[task->getId()].emplace(*task);
+    }
+    for (int id : deletes) {
+        table[id].reset();
+    }
+
+    if (table.size() >= MEMTABLE_LIMIT) {
+        flush();
+    }
+}
+
+// ======================
+// Runs and Compaction
+// ======================
+
+LsmStore::RunInfo LsmStore::writeRun(const std::map<int, Record>& records) {
+    RunInfo run;
+    run.file = std::format("{}.run-{:06}", dataFile_.stem().string(), nextRun_++);
+
+    std::string buffers[] = { encodeRun(records, run.tasks, run.tombstones) };
+    run.bytes = buffers[0].size();
+    TaskStorage::writeBuffers(runPath(run), buffers);
+    return run;
+}
+
+void LsmStore::flush() {
+    auto& table = memtable();
+    if (table.empty()) {
+        return;
+    }
+
+    RunInfo run = writeRun(table);
+    runs_.push_back(run);
+    stats_.flushBytes += run.bytes;
+    stats_.walBytes += walBytes_;
+    stats_.logicalBytes += walLogicalBytes_;
+    ++stats_.flushes;
+
+    // The manifest names the new run before the log goes away, so a crash replays at worst twice
+    saveManifest();
+    std::filesystem::remove(walFile_);
+    table.clear();
+    walBytes_ = walLogicalBytes_ = walRecords_ = 0;
+    walTorn_ = false;
+
+    if (runs_.size() > MAX_RUNS) {
+        compactRuns();
+    }
+}
+
+void LsmStore::compactRuns() {
+    if (runs_.size() < 2) {
+        return;
+    }
+
+    // Newer runs overwrite older ones; tombstones must survive until the base is rewritten
+    std::map<int, Record> merged;
+    for (const auto& run : runs_) {
+        auto path = runPath(run);
+        std::string bytes = TaskStorage::readFile(path);
+        uint32_t count = checkRun(path, bytes);
+        for (uint32_t i = 0; i < count; ++i) {
+            int id = 0;
+            Record record = decodeRunRecord(path, bytes, i, id);
+            merged.insert_or_assign(id, std::move(record));
+        }
+    }
+
+    auto obsolete = std::exchange(runs_, {});
+    RunInfo run = writeRun(merged);
+    runs_.push_back(run);
+    stats_.compactionBytes += run.bytes;
+    ++stats_.compactions;
+
+    saveManifest();
+    for (const auto& old : obsolete) {
+        std::filesystem::remove(runPath(old));
+    }
+}
+
+void LsmStore::checkpointed(uint64_t snapshotBytes) {
+    size_t tombstones = 0;
+    for (const auto& run : runs_) {
+        tombstones += run.tombstones;
+    }
+    for (const auto& [id, record] : memtable()) {
+        if (!record) ++tombstones;
+    }
+
+    auto obsolete = std::exchange(runs_, {});
+    stats_.walBytes += walBytes_;
+    stats_.logicalBytes += walLogicalBytes_;
+    stats_.checkpointBytes += snapshotBytes;
+    stats_.tombstonesDropped += tombstones;
+    ++stats_.checkpoints;
+
+    // Manifest first: if we crash before the deletes, replaying old tiers over the new base is idempotent
+    saveManifest();
+    std::filesystem::remove(walFile_);
+    for (const auto& run : obsolete) {
+        std::filesystem::remove(runPath(run));
+    }
+    memtable_->clear();
+    walBytes_ = walLogicalBytes_ = walRecords_ = 0;
+    walTorn_ = false;
+}
+
+void LsmStore::discard() {
+    std::filesystem::remove(walFile_);
+    for (const auto& run : runs_) {
+        std::filesystem::remove(runPath(run));
+    }
+    std::filesystem::remove(manifestFile_);
+
+    runs_.clear();
+    stats_ = {};
+    memtable_.emplace();
+    walBytes_ = walLogicalBytes_ = walRecords_ = 0;
+    walTorn_ = false;
+}
+
+// ======================
+// Reads
+// ======================
+
+LsmStore::ReplayReport LsmStore::replay(std::vector<std::unique_ptr<Task>>& tasks, int& nextId) const {
+    auto start = std::chrono::steady_clock::now();
+    ReplayReport report;
+    if (runs_.empty() && memtable().empty()) {
+        return report;
+    }
+    report.bytes = backlog().bytes;
+
+    std::unordered_map<int, size_t> positions;
+    positions.reserve(tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        positions.emplace(tasks[i]->getId(), i);
+    }
+
+    // Phase 1 (sequential): validate run entry tables and replay IDs only. This fixes
+    // each task's final slot and winning version exactly as a record-by-record replay
+    // would, without decoding any payload. Deleted slots become null and are squeezed
+    // out at the end, preserving order.
+    std::vector<std::string> runData;
+    std::vector<std::filesystem::path> runPaths;
+    runData.reserve(runs_.size());
+    std::vector<RecordRef> refs(tasks.size());
+
+    auto apply = [&](int id, const RecordRef& ref, bool tombstone) {
+        ++report.records;
+        nextId = std::max(nextId, id + 1);
+        auto it = positions.find(id);
+        if (tombstone) {
+            if (it != positions.end()) {
+                tasks[it->second].reset();
+                refs[it->second] = {};
+                positions.erase(it);
+            }
+        }
+        else if (it != positions.end()) {
+            refs[it->second] = ref;
+        }
+        else {
+            positions.emplace(id, tasks.size());
+            tasks.emplace_back();
+            refs.push_back(ref);
+        }
+        };
+
+    for (const auto& run : runs_) {
+        runPaths.push_back(runPath(run));
+        runData.push_back(TaskStorage::readFile(runPaths.back()));
+        const std::string& bytes = runData.back();
+        uint32_t count = checkRun(runPaths.back(), bytes);
+        for (uint32_t i = 0; i < count; ++i) {
+            size_t pos = kRunHeaderSize + i * kRunEntrySize;
+            bool tombstone = getLE<uint32_t>(bytes, pos + 4) & kTombstone;
+            apply(getLE<int32_t>(bytes, pos), { runData.size() - 1, i, nullptr, true }, tombstone);
+        }
+    }
+    for (const auto& [id, record] : memtable()) {
+        apply(id, { 0, 0, record ? &*record : nullptr, true }, !record);
+    }
+
+    // Phase 2 (parallel): every live slot holds a distinct ID, so workers decode
+    // disjoint partitions of IDs and write only their own slots
+    std::vector<size_t> pending;
+    for (size_t slot = 0; slot < refs.size(); ++slot) {
+        if (refs[slot].live()) pending.push_back(slot);
+    }
+
+    Parallel::forEachChunk(pending.size(), Parallel::workerCount(pending.size(), kDecodeBatch), [&](size_t, size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            size_t slot = pending[k];
+            const RecordRef& ref = refs[slot];
+            Task task = ref.task ? *ref.task : decodeRunTask(runPaths[ref.run], runData[ref.run], ref.entry);
+            if (tasks[slot]) {
+                *tasks[slot] = std::move(task);
+            }
+            else {
+                tasks[slot] = std::make_unique<Task>(std::move(task));
+            }
+        }
+        });
+
+    std::erase(tasks, nullptr);
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+TaskStorage::RecordLookup LsmStore::lookup(int id) const {
+    TaskStorage::RecordLookup result;
+
+    auto& table = memtable();
+    if (auto it = table.find(id); it != table.end()) {
+        result.indexed = true;
+        result.task = it->second;
+        return result;
+    }
+
+    for (auto run = runs_.rbegin(); run != runs_.rend(); ++run) {
+        if (auto found = lookupRun(runPath(*run), id)) {
+            result.indexed = true;
+            result.task = std::move(*found);
+            return result;
+        }
+    }
+
+    return TaskStorage::lookupSnapshotTask(dataFile_, id);
+}
+
+// ======================
+// Introspection
+// ======================
+
+LsmStore::Stats LsmStore::stats() const {
+    memtable(); // Count the current log
+    Stats current = stats_;
+    current.walBytes += walBytes_;
+    current.logicalBytes += walLogicalBytes_;
+    return current;
+}
+
+const std::vector<LsmStore::RunInfo>& LsmStore::runs() const noexcept {
+    return runs_;
+}
+
+size_t LsmStore::memtableSize() const {
+    return memtable().size();
+}
+
+bool LsmStore::empty() const {
+    return runs_.empty() && memtable().empty();
+}
+
+LsmStore::Backlog LsmStore::backlog() const {
+    memtable(); // Count the current log
+    Backlog backlog{ walBytes_, walRecords_ };
+    for (const auto& run : runs_) {
+        backlog.bytes += run.bytes;
+        backlog.records += run.tasks + run.tombstones;
+    }
+    return backlog;
+}
+
+std::optional<std::string> LsmStore::checkpointReason(const CheckpointPolicy& policy, double bytesPerSecond) const {
+    auto pending = backlog();
+    if (pending.bytes > policy.maxBytes) {
+        return std::format("{} bytes pending (limit {})", pending.bytes, policy.maxBytes);
+    }
+    if (pending.records > policy.maxRecords) {
+        return std::format("{} records pending (limit {})", pending.records, policy.maxRecords);
+    }
+
+    double replayMs = bytesPerSecond > 0 ? 1000.0 * static_cast<double>(pending.bytes) / bytesPerSecond : 0.0;
+    if (replayMs > policy.maxReplayMs) {
+        return std::format("estimated replay {:.1f} ms (limit {:.1f} ms)", replayMs, policy.maxReplayMs);
+    }
+    return std::nullopt;
+}
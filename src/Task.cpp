@@ -12,9 +12,9 @@
  */
 
 #include "Task.hpp"
+#include "TaskSchema.hpp"
+#include "TextFormat.hpp"
 #include "utils.hpp"
-#include <sstream>
-#include <iomanip>
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
@@ -190,7 +190,8 @@ const std::chrono::system_clock::time_point& Task::getCreatedAt() const noexcept
     return created_at;
 }
 
-const std::optional<std::chrono::system_clock::time_point>& Task::getCompletedAt() const noexcept {
+const std::optional<std::chrono::system_clock::time_point>& Task::getCompletedAt() const {
+    ensureColdFields();
     return completed_at;
 }
 
@@ -198,14 +199,79 @@ const std::optional<std::chrono::system_clock::time_point>& Task::getDueDate() c
     return due_date;
 }
 
-const std::string& Task::getDescription() const noexcept {
+const std::string& Task::getDescription() const {
+    ensureColdFields();
     return description;
 }
 
-const std::vector<std::string>& Task::getTags() const noexcept {
+const std::vector<std::string>& Task::getTags() const {
+    ensureColdFields();
     return tags;
 }
 
+bool Task::hasColdFieldsLoaded() const noexcept {
+    return !cold_source;
+}
+
+/**
+ * @brief Decode description, tags and completion time from the backing snapshot
+ *
+ * No-op for tasks that were created in memory or loaded from JSON. Not
+ * synchronized: parallel code must not touch the same task's cold fields
+ * from two threads (the bulk paths partition tasks between workers).
+ */
+void Task::ensureColdFields() const {
+    if (!cold_source) return;
+
+    TaskColdFields fields = cold_source->load(cold_offset, cold_length);
+    description = std::move(fields.description);
+    tags = std::move(fields.tags);
+    completed_at = fields.completed_at;
+    cold_source.reset();
+}
+
+// =========================
+// Content Hashing
+// =========================
+
+/**
+ * @brief Hash one field in the form it is persisted (timestamps in whole seconds)
+ * @param field Field to hash
+ * @return Field term, seeded by the field so equal values in different fields differ
+ */
+uint64_t Task::fieldHash(Field field) const {
+    // Enumerators index the schema table; keep the two in step
+    static_assert(TaskSchema::key(static_cast<size_t>(Field::Id)) == "id");
+    static_assert(TaskSchema::key(static_cast<size_t>(Field::Name)) == "name");
+    static_assert(TaskSchema::key(static_cast<size_t>(Field::Status)) == "status");
+    static_assert(TaskSchema::key(static_cast<size_t>(Field::Priority)) == "priority");
+    static_assert(TaskSchema::key(static_cast<size_t>(Field::CreatedAt)) == "created_at");
+    static_assert(TaskSchema::key(static_cast<size_t>(Field::Description)) == "description");
+    static_assert(TaskSchema::key(static_cast<size_t>(Field::Tags)) == "tags");
+    static_assert(TaskSchema::key(static_cast<size_t>(Field::CompletedAt)) == "completed_at");
+    static_assert(TaskSchema::key(static_cast<size_t>(Field::DueDate)) == "due_date");
+    return TaskSchema::fieldHash(*this, static_cast<size_t>(field));
+}
+
+void Task::retractField(Field field) {
+    if (content_hash) {
+        *content_hash -= fieldHash(field);
+    }
+}
+
+void Task::restoreField(Field field) {
+    if (content_hash) {
+        *content_hash += fieldHash(field);
+    }
+}
+
+uint64_t Task::contentHash() const {
+    if (!content_hash) {
+        content_hash = TaskSchema::contentHash(*this);
+    }
+    return *content_hash;
+}
+
 // =========================
 // Property Setters with Validation and Side Effects
 // =========================
@@ -219,7 +285,9 @@ void Task::setName(std::string_view name) {
     if (name.empty()) {
         throw std::invalid_argument("Task name cannot be empty");
     }
+    retractField(Field::Name);
     this->name = name;
+    restoreField(Field::Name);
 }
 
 /**
@@ -230,6 +298,9 @@ void Task::setName(std::string_view name) {
  * and clears it when status changes away from COMPLETED.
  */
 void Task::setStatus(TaskStatus status) {
+    ensureColdFields(); // completed_at is cold
+    retractField(Field::Status);
+    retractField(Field::CompletedAt);
     TaskStatus old_status = this->status;
     this->status = status;
 
@@ -240,18 +311,27 @@ void Task::setStatus(TaskStatus status) {
     else if (status != TaskStatus::COMPLETED) {
         completed_at.reset(); // Clear completion time if moving away from completed
     }
+    restoreField(Field::Status);
+    restoreField(Field::CompletedAt);
 }
 
 void Task::setPriority(TaskPriority priority) {
+    retractField(Field::Priority);
     this->priority = priority;
+    restoreField(Field::Priority);
 }
 
 void Task::setDescription(std::string_view description) {
+    ensureColdFields(); // A later lazy decode must not overwrite the new value
+    retractField(Field::Description);
     this->description = description;
+    restoreField(Field::Description);
 }
 
 void Task::setDueDate(const std::optional<std::chrono::system_clock::time_point>& due_date) {
+    retractField(Field::DueDate);
     this->due_date = due_date;
+    restoreField(Field::DueDate);
 }
 
 // ================
@@ -266,9 +346,12 @@ void Task::setDueDate(const std::optional<std::chrono::system_clock::time_point>
  * Prevents duplicate tags in the collection.
  */
 void Task::addTag(std::string_view tag) {
+    ensureColdFields();
     std::string tag_str{ tag };
     if (!tag_str.empty() && !hasTag(tag)) {
+        retractField(Field::Tags);
         tags.push_back(std::move(tag_str));
+        restoreField(Field::Tags);
     }
 }
 
@@ -279,9 +362,12 @@ void Task::addTag(std::string_view tag) {
  * Uses std::ranges::find for efficient tag lookup and removal.
  */
 void Task::removeTag(std::string_view tag) {
+    ensureColdFields();
     auto it = std::ranges::find(tags, tag);
     if (it != tags.end()) {
+        retractField(Field::Tags);
         tags.erase(it);
+        restoreField(Field::Tags);
     }
 }
 
@@ -291,6 +377,7 @@ void Task::removeTag(std::string_view tag) {
  * @return true if tag exists, false otherwise
  */
 bool Task::hasTag(std::string_view tag) const {
+    ensureColdFields();
     return std::ranges::find(tags, tag) != tags.end();
 }
 
@@ -345,29 +432,31 @@ std::string Task::getFormattedDueDate() const {
 
 /**
  * @brief Check if task is overdue
+ * @param context Evaluation instant shared by the whole command
  * @return true if task has due date in the past and is not completed
  *
  * A task is considered overdue if:
  * 1. It has a due date set
- * 2. Current time is past the due date
+ * 2. The context's instant is past the due date
  * 3. Task is not completed
  */
-bool Task::isOverdue() const {
+bool Task::isOverdue(const EvalContext& context) const {
     if (!due_date) return false;
-    return std::chrono::system_clock::now() > *due_date && status != TaskStatus::COMPLETED;
+    return context.now > *due_date && status != TaskStatus::COMPLETED;
 }
 
 /**
  * @brief Calculate days until due date
+ * @param context Evaluation instant shared by the whole command
  * @return Number of days (can be negative if overdue)
  *
+ * Counts local calendar days from the context's day to the due day.
  * Returns 0 if no due date is set.
  * Negative values indicate overdue tasks.
  */
-std::chrono::days Task::getDaysUntilDue() const {
+std::chrono::days Task::getDaysUntilDue(const EvalContext& context) const {
     if (!due_date) return std::chrono::days{ 0 };
-    auto now = std::chrono::system_clock::now();
-    return std::chrono::duration_cast<std::chrono::days>(*due_date - now);
+    return context.daysUntil(*due_date);
 }
 
 /**
@@ -390,6 +479,7 @@ void Task::markCompleted() {
  * - All tags
  */
 bool Task::matches(std::string_view query) const {
+    ensureColdFields();
     std::string query_lower = Utils::toLowerCase(query);
     std::string name_lower = Utils::toLowerCase(name);
     std::string desc_lower = Utils::toLowerCase(description);
@@ -413,31 +503,11 @@ bool Task::matches(std::string_view query) const {
  * @brief Convert task to JSON for persistence
  * @return JSON object representing the task
  *
- * Serializes all task properties including optional fields.
- * Uses Unix timestamp format for time points.
+ * Generated from the field table (TaskSchema). Optional timestamps are
+ * omitted when absent; all timestamps are Unix seconds.
  */
 nlohmann::json Task::toJson() const {
-    nlohmann::json j{
-        {"id", id},
-        {"name", name},
-        {"status", taskStatusToInt(status)},
-        {"priority", taskPriorityToInt(priority)},
-        {"created_at", std::chrono::duration_cast<std::chrono::seconds>(created_at.time_since_epoch()).count()},
-        {"description", description},
-        {"tags", tags}
-    };
-
-    // Add optional completion timestamp
-    if (completed_at) {
-        j["completed_at"] = std::chrono::duration_cast<std::chrono::seconds>(completed_at->time_since_epoch()).count();
-    }
-
-    // Add optional due date
-    if (due_date) {
-        j["due_date"] = std::chrono::duration_cast<std::chrono::seconds>(due_date->time_since_epoch()).count();
-    }
-
-    return j;
+    return TaskSchema::toJson(*this);
 }
 
 /**
@@ -446,45 +516,50 @@ nlohmann::json Task::toJson() const {
  * @return Task object reconstructed from JSON
  * @throws Various exceptions if JSON is malformed
  *
- * Deserializes task from JSON format with proper error handling.
- * Handles optional fields gracefully.
+ * Generated from the field table (TaskSchema): id, name, status and
+ * priority are required; other fields keep their defaults when missing.
  */
 Task Task::fromJson(const nlohmann::json& j) {
-    // Create basic task from required fields
-    Task task(
-        j.at("id").get<int>(),
-        j.at("name").get<std::string>(),
-        intToTaskStatus(j.at("status").get<int>()),
-        intToTaskPriority(j.at("priority").get<int>())
-    );
-
-    // Restore creation timestamp
-    if (j.contains("created_at")) {
-        auto seconds = std::chrono::seconds{ j.at("created_at").get<int64_t>() };
-        task.created_at = std::chrono::system_clock::time_point{ seconds };
-    }
-
-    // Restore optional completion timestamp
-    if (j.contains("completed_at")) {
-        auto seconds = std::chrono::seconds{ j.at("completed_at").get<int64_t>() };
-        task.completed_at = std::chrono::system_clock::time_point{ seconds };
-    }
-
-    // Restore optional due date
-    if (j.contains("due_date")) {
-        auto seconds = std::chrono::seconds{ j.at("due_date").get<int64_t>() };
-        task.due_date = std::chrono::system_clock::time_point{ seconds };
-    }
-
-    // Restore optional description and tags
-    if (j.contains("description")) {
-        task.description = j.at("description").get<std::string>();
-    }
+    return TaskSchema::fromJson(j);
+}
 
-    if (j.contains("tags")) {
-        task.tags = j.at("tags").get<std::vector<std::string>>();
-    }
+/**
+ * @brief Create task from validated fields
+ *
+ * Used by bulk import, where building a JSON object per task just to
+ * parse it again would dominate the cost.
+ */
+Task Task::fromFields(int id, std::string_view name, TaskStatus status, TaskPriority priority,
+    std::chrono::system_clock::time_point created_at,
+    const std::optional<std::chrono::system_clock::time_point>& completed_at,
+    const std::optional<std::chrono::system_clock::time_point>& due_date,
+    std::string description, std::vector<std::string> tags) {
+    Task task(id, name, status, priority);
+    task.created_at = created_at;
+    task.completed_at = completed_at;
+    task.due_date = due_date;
+    task.description = std::move(description);
+    task.tags = std::move(tags);
+    return task;
+}
 
+/**
+ * @brief Create task from hot fields with lazily decoded cold fields
+ *
+ * Used by the binary snapshot reader: only the fixed-size record and the
+ * name are decoded up front; the description, tags and completion time stay
+ * in the mapped file until a getter needs them.
+ */
+Task Task::fromHotFields(int id, std::string_view name, TaskStatus status, TaskPriority priority,
+    std::chrono::system_clock::time_point created_at,
+    const std::optional<std::chrono::system_clock::time_point>& due_date,
+    std::shared_ptr<const ColdFieldSource> source, uint64_t offset, uint32_t length) {
+    Task task(id, name, status, priority);
+    task.created_at = created_at;
+    task.due_date = due_date;
+    task.cold_source = std::move(source);
+    task.cold_offset = offset;
+    task.cold_length = length;
     return task;
 }
 
@@ -494,76 +569,113 @@ Task Task::fromJson(const nlohmann::json& j) {
 
 /**
  * @brief Get compact string representation for table display
+ * @param context Evaluation instant for the overdue indicator
  * @return Formatted string with essential task info
  *
  * Provides a single-line representation suitable for table rows.
  * Includes color coding and overdue indicators.
  */
-std::string Task::toString() const {
-    std::ostringstream oss;
+std::string Task::toString(const EvalContext& context) const {
+    std::string out;
+    out.reserve(96);
 
     // Get appropriate colors for visual feedback
     auto statusColor = Utils::getStatusColor(status);
     auto priorityColor = Utils::getPriorityColor(priority);
 
     // Add overdue warning indicator
-    std::string overdueIndicator = isOverdue() ? " ⚠️" : "";
+    std::string_view overdueIndicator = isOverdue(context) ? " ⚠️" : "";
 
     // Format with consistent column widths
-    oss << std::left << std::setw(4) << id
-        << std::setw(30) << (name + overdueIndicator)
-        << statusColor << std::setw(12) << getStatusString() << Utils::RESET
-        << priorityColor << std::setw(8) << getPriorityString() << Utils::RESET;
+    TextFormat::appendPadded(out, id, 4);
+    out += name;
+    out += overdueIndicator;
+    if (name.size() + overdueIndicator.size() < 30) out.append(30 - name.size() - overdueIndicator.size(), ' ');
+    out += statusColor;
+    TextFormat::appendPadded(out, getStatusString(), 12);
+    out += Utils::RESET;
+    out += priorityColor;
+    TextFormat::appendPadded(out, getPriorityString(), 8);
+    out += Utils::RESET;
 
     // Add due date if present
     if (due_date) {
-        oss << " (Due: " << getFormattedDueDate() << ")";
+        out += " (Due: ";
+        TextFormat::appendDate(out, *due_date);
+        out += ")";
     }
 
-    return oss.str();
+    return out;
 }
 
 /**
  * @brief Get detailed string representation for full task view
+ * @param context Evaluation instant for the overdue marker
  * @return Multi-line formatted string with all task details
  *
  * Provides comprehensive task information including all metadata.
  * Used for detailed task display commands.
  */
-std::string Task::toDetailedString() const {
-    std::ostringstream oss;
-
-    oss << Utils::BOLD << "Task #" << id << ": " << name << Utils::RESET << "\n";
-    oss << "Status: " << Utils::getStatusColor(status) << getStatusString() << Utils::RESET << "\n";
-    oss << "Priority: " << Utils::getPriorityColor(priority) << getPriorityString() << Utils::RESET << "\n";
-    oss << "Created: " << getFormattedCreatedAt() << "\n";
+std::string Task::toDetailedString(const EvalContext& context) const {
+    ensureColdFields();
+    std::string out;
+    out.reserve(256 + description.size());
+
+    out += Utils::BOLD;
+    out += "Task #";
+    TextFormat::appendInt(out, id);
+    out += ": ";
+    out += name;
+    out += Utils::RESET;
+    out += "\nStatus: ";
+    out += Utils::getStatusColor(status);
+    out += getStatusString();
+    out += Utils::RESET;
+    out += "\nPriority: ";
+    out += Utils::getPriorityColor(priority);
+    out += getPriorityString();
+    out += Utils::RESET;
+    out += "\nCreated: ";
+    TextFormat::appendDateTime(out, created_at);
+    out += "\n";
 
     if (completed_at) {
-        oss << "Completed: " << Utils::formatDateTime(*completed_at) << "\n";
+        out += "Completed: ";
+        TextFormat::appendDateTime(out, *completed_at);
+        out += "\n";
     }
 
     if (due_date) {
-        oss << "Due Date: " << getFormattedDueDate();
-        if (isOverdue()) {
-            oss << " " << Utils::RED << "(OVERDUE)" << Utils::RESET;
+        out += "Due Date: ";
+        TextFormat::appendDate(out, *due_date);
+        if (isOverdue(context)) {
+            out += " ";
+            out += Utils::RED;
+            out += "(OVERDUE)";
+            out += Utils::RESET;
         }
-        oss << "\n";
+        out += "\n";
     }
 
     if (!description.empty()) {
-        oss << "Description: " << description << "\n";
+        out += "Description: ";
+        out += description;
+        out += "\n";
     }
 
     if (!tags.empty()) {
-        oss << "Tags: ";
+        out += "Tags: ";
         for (size_t i = 0; i < tags.size(); ++i) {
-            oss << Utils::BLUE << "#" << tags[i] << Utils::RESET;
-            if (i < tags.size() - 1) oss << ", ";
+            out += Utils::BLUE;
+            out += "#";
+            out += tags[i];
+            out += Utils::RESET;
+            if (i < tags.size() - 1) out += ", ";
         }
-        oss << "\n";
+        out += "\n";
     }
 
-    return oss.str();
+    return out;
 }
 
 // ==================
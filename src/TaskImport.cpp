@@ -0,0 +1,467 @@
+/**
+ * @file TaskImport.cpp
+ * @brief Record readers, row validation and block-wise bulk loading
+ */
+
+#include "TaskImport.hpp"
+#include "Parallel.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    constexpr size_t kBlockRecords = 16384;     ///< Records validated together (and given one ID range)
+    constexpr size_t kMinRecordsPerWorker = 1024;
+
+    /**
+     * @struct Record
+     * @brief One input row and where it started
+     */
+    struct Record {
+        size_t line = 0;    ///< 1-based line number
+        std::string text;   ///< Row text (CSV rows may span lines)
+    };
+
+    /**
+     * @struct Row
+     * @brief Validated field values for one new task
+     */
+    struct Row {
+        std::string name;
+        std::string description;
+        TaskStatus status = TaskStatus::TODO;
+        TaskPriority priority = TaskPriority::LOW;
+        std::optional<TimePoint> created;
+        std::optional<TimePoint> completed;
+        std::optional<TimePoint> due;
+        std::vector<std::string> tags;
+    };
+
+    /**
+     * @class RecordReader
+     * @brief Splits a stream into non-blank records, joining quoted CSV line breaks
+     */
+    class RecordReader {
+    public:
+        RecordReader(std::istream& in, bool csv) : in_(in), csv_(csv) {}
+
+        bool next(Record& record) {
+            std::string line;
+            while (readLine(line)) {
+                if (line.find_first_not_of(" \t") == std::string::npos) {
+                    continue;
+                }
+                record.line = line_;
+                record.text = std::move(line);
+
+                // An odd number of quotes means a quoted field continues on the next line
+                while (csv_ && std::ranges::count(record.text, '"') % 2 == 1 && readLine(line)) {
+                    record.text += '\n';
+                    record.text += line;
+                }
+                return true;
+            }
+            return false;
+        }
+
+        [[nodiscard]] uint64_t bytes() const noexcept { return bytes_; }
+
+    private:
+        std::istream& in_;
+        bool csv_;
+        size_t line_ = 0;
+        uint64_t bytes_ = 0;
+
+        bool readLine(std::string& line) {
+            if (!std::getline(in_, line)) {
+                return false;
+            }
+            bytes_ += line.size() + 1;
+            if (++line_ == 1 && line.starts_with("\xEF\xBB\xBF")) {
+                line.erase(0, 3); // UTF-8 byte order mark
+            }
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            return true;
+        }
+    };
+
+    // ======================
+    // Field Parsing
+    // ======================
+
+    std::string_view trim(std::string_view text) {
+        auto begin = text.find_first_not_of(" \t");
+        if (begin == std::string_view::npos) return {};
+        auto end = text.find_last_not_of(" \t");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    // Epoch seconds, or any date Utils::parseDate() accepts
+    std::optional<TimePoint> parseWhen(std::string_view text, std::string_view field) {
+        text = trim(text);
+        if (text.empty()) {
+            return std::nullopt;
+        }
+        int64_t seconds = 0;
+        auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), seconds);
+        if (ec == std::errc{} && end == text.data() + text.size()) {
+            return TimePoint{ std::chrono::seconds{ seconds } };
+        }
+        if (auto date = Utils::parseDate(text)) {
+            return date;
+        }
+        throw std::invalid_argument(std::format("Invalid {}: {}", field, text));
+    }
+
+    void addTag(Row& row, std::string_view tag) {
+        tag = trim(tag);
+        if (!tag.empty() && std::ranges::find(row.tags, tag) == row.tags.end()) {
+            row.tags.emplace_back(tag);
+        }
+    }
+
+    void addTags(Row& row, std::string_view list) {
+        while (!list.empty()) {
+            auto end = list.find_first_of(",;");
+            addTag(row, list.substr(0, end));
+            list.remove_prefix(end == std::string_view::npos ? list.size() : end + 1);
+        }
+    }
+
+    // Apply the rules `todo add` and Task::setStatus() follow
+    void finish(Row& row) {
+        if (trim(row.name).empty()) {
+            throw std::invalid_argument("Missing task name");
+        }
+        if (row.status == TaskStatus::COMPLETED) {
+            if (!row.completed) row.completed = std::chrono::system_clock::now();
+        }
+        else {
+            row.completed.reset();
+        }
+    }
+
+    // ======================
+    // CSV
+    // ======================
+
+    /**
+     * @struct Columns
+     * @brief Header positions of the recognized CSV columns (-1 if absent)
+     */
+    struct Columns {
+        int name = -1, description = -1, status = -1, priority = -1;
+        int due = -1, tags = -1, created = -1, completed = -1;
+    };
+
+    // RFC 4180 fields: quotes around a field, doubled quotes inside it
+    std::vector<std::string> splitCsv(std::string_view record) {
+        std::vector<std::string> fields(1);
+        bool quoted = false;
+        for (size_t i = 0; i < record.size(); ++i) {
+            char c = record[i];
+            if (quoted) {
+                if (c == '"' && i + 1 < record.size() && record[i + 1] == '"') {
+                    fields.back() += '"';
+                    ++i;
+                }
+                else if (c == '"') {
+                    quoted = false;
+                }
+                else {
+                    fields.back() += c;
+                }
+            }
+            else if (c == '"') {
+                quoted = true;
+            }
+            else if (c == ',') {
+                fields.emplace_back();
+            }
+            else {
+                fields.back() += c;
+            }
+        }
+        if (quoted) {
+            throw std::invalid_argument("Unterminated quoted field");
+        }
+        return fields;
+    }
+
+    Columns readHeader(const std::vector<std::string>& header) {
+        Columns columns;
+        for (int i = 0; i < static_cast<int>(header.size()); ++i) {
+            auto name = Utils::toLowerCase(trim(header[i]));
+            if (name == "name" || name == "title") columns.name = i;
+            else if (name == "description" || name == "notes") columns.description = i;
+            else if (name == "status") columns.status = i;
+            else if (name == "priority") columns.priority = i;
+            else if (name == "due" || name == "due_date") columns.due = i;
+            else if (name == "tags") columns.tags = i;
+            else if (name == "created" || name == "created_at") columns.created = i;
+            else if (name == "completed" || name == "completed_at") columns.completed = i;
+        }
+        if (columns.name < 0) {
+            throw std::runtime_error("CSV header has no 'name' column");
+        }
+        return columns;
+    }
+
+    Row parseCsv(std::string_view record, const Columns& columns) {
+        auto fields = splitCsv(record);
+        auto field = [&](int column) -> std::string_view {
+            return column >= 0 && column < static_cast<int>(fields.size()) ? trim(fields[column]) : std::string_view{};
+        };
+
+        Row row;
+        row.name = field(columns.name);
+        row.description = field(columns.description);
+        if (auto status = field(columns.status); !status.empty()) row.status = Utils::parseTaskStatus(status);
+        if (auto priority = field(columns.priority); !priority.empty()) row.priority = Utils::parseTaskPriority(priority);
+        row.due = parseWhen(field(columns.due), "due date");
+        row.created = parseWhen(field(columns.created), "creation date");
+        row.completed = parseWhen(field(columns.completed), "completion date");
+        addTags(row, field(columns.tags));
+        finish(row);
+        return row;
+    }
+
+    // ======================
+    // NDJSON
+    // ======================
+
+    std::optional<TimePoint> jsonWhen(const nlohmann::json& object, std::initializer_list<const char*> keys, std::string_view field) {
+        for (const char* key : keys) {
+            if (!object.contains(key) || object[key].is_null()) continue;
+            const auto& value = object[key];
+            if (value.is_number_integer()) return TimePoint{ std::chrono::seconds{ value.get<int64_t>() } };
+            if (value.is_string()) return parseWhen(value.get_ref<const std::string&>(), field);
+            throw std::invalid_argument(std::format("Invalid {}: {}", field, value.dump()));
+        }
+        return std::nullopt;
+    }
+
+    Row parseNdjson(std::string_view record) {
+        auto object = nlohmann::json::parse(record);
+        if (!object.is_object()) {
+            throw std::invalid_argument("Not a JSON object");
+        }
+
+        Row row;
+        if (!object.contains("name") || !object["name"].is_string()) {
+            throw std::invalid_argument("Missing task name");
+        }
+        row.name = object["name"].get<std::string>();
+        if (object.contains("description") && object["description"].is_string()) {
+            row.description = object["description"].get<std::string>();
+        }
+        if (object.contains("status")) {
+            const auto& status = object["status"];
+            row.status = status.is_number_integer() ? intToTaskStatus(status.get<int>()) : Utils::parseTaskStatus(status.get<std::string>());
+        }
+        if (object.contains("priority")) {
+            const auto& priority = object["priority"];
+            row.priority = priority.is_number_integer() ? intToTaskPriority(priority.get<int>()) : Utils::parseTaskPriority(priority.get<std::string>());
+        }
+        row.due = jsonWhen(object, { "due_date", "due" }, "due date");
+        row.created = jsonWhen(object, { "created_at", "created" }, "creation date");
+        row.completed = jsonWhen(object, { "completed_at", "completed" }, "completion date");
+        if (object.contains("tags")) {
+            const auto& tags = object["tags"];
+            if (tags.is_array()) {
+                for (const auto& tag : tags) addTag(row, tag.get<std::string>());
+            }
+            else {
+                addTags(row, tags.get<std::string>());
+            }
+        }
+        finish(row);
+        return row;
+    }
+
+    // ======================
+    // todo.txt
+    // ======================
+
+    bool looksLikeDate(std::string_view token) {
+        return token.size() == 10 && token[4] == '-' && token[7] == '-' &&
+            std::ranges::all_of(token, [](char c) { return std::isdigit(static_cast<unsigned char>(c)) || c == '-'; });
+    }
+
+    TaskPriority todoTxtPriority(char letter) {
+        return letter == 'A' ? TaskPriority::HIGH : letter == 'B' ? TaskPriority::MEDIUM : TaskPriority::LOW;
+    }
+
+    Row parseTodoTxt(std::string_view record) {
+        std::vector<std::string_view> tokens;
+        for (auto rest = record; !rest.empty();) {
+            auto begin = rest.find_first_not_of(' ');
+            if (begin == std::string_view::npos) break;
+            rest.remove_prefix(begin);
+            auto end = rest.find(' ');
+            tokens.push_back(rest.substr(0, end));
+            rest.remove_prefix(end == std::string_view::npos ? rest.size() : end);
+        }
+
+        Row row;
+        size_t i = 0;
+        auto takeDate = [&](std::optional<TimePoint>& into, std::string_view field) {
+            if (i < tokens.size() && looksLikeDate(tokens[i])) into = parseWhen(tokens[i++], field);
+        };
+
+        // "x [completed] [created]" or "(A) [created]"
+        if (i < tokens.size() && tokens[i] == "x") {
+            row.status = TaskStatus::COMPLETED;
+            ++i;
+            takeDate(row.completed, "completion date");
+            takeDate(row.created, "creation date");
+        }
+        else {
+            if (i < tokens.size() && tokens[i].size() == 3 && tokens[i][0] == '(' && tokens[i][2] == ')' &&
+                tokens[i][1] >= 'A' && tokens[i][1] <= 'Z') {
+                row.priority = todoTxtPriority(tokens[i++][1]);
+            }
+            takeDate(row.created, "creation date");
+        }
+
+        for (; i < tokens.size(); ++i) {
+            auto token = tokens[i];
+            if (token.size() > 1 && (token[0] == '+' || token[0] == '@')) {
+                addTag(row, token.substr(1));
+            }
+            else if (token.starts_with("due:")) {
+                row.due = parseWhen(token.substr(4), "due date");
+            }
+            else if (token.starts_with("pri:") && token.size() == 5) {
+                row.priority = todoTxtPriority(token[4]);
+            }
+            else {
+                if (!row.name.empty()) row.name += ' ';
+                row.name += token;
+            }
+        }
+        finish(row);
+        return row;
+    }
+
+} // namespace
+
+namespace TaskImport {
+
+    std::optional<Format> parseFormat(std::string_view name) {
+        if (name == "csv") return Format::Csv;
+        if (name == "ndjson" || name == "jsonl") return Format::Ndjson;
+        if (name == "todotxt" || name == "todo.txt") return Format::TodoTxt;
+        return std::nullopt;
+    }
+
+    std::string_view formatName(Format format) noexcept {
+        switch (format) {
+        case Format::Csv: return "csv";
+        case Format::Ndjson: return "ndjson";
+        case Format::TodoTxt: return "todotxt";
+        }
+        return "csv";
+    }
+
+    std::optional<Format> detectFormat(const std::filesystem::path& file) {
+        auto extension = Utils::toLowerCase(file.extension().string());
+        if (extension == ".csv") return Format::Csv;
+        if (extension == ".ndjson" || extension == ".jsonl") return Format::Ndjson;
+        if (extension == ".txt") return Format::TodoTxt;
+        return std::nullopt;
+    }
+
+    double Report::rowsPerSecond() const noexcept {
+        return seconds > 0.0 ? static_cast<double>(rows) / seconds : 0.0;
+    }
+
+    Report importFile(Tasks& tasks, const std::filesystem::path& file, Format format) {
+        auto start = std::chrono::steady_clock::now();
+        std::ifstream in(file, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Cannot open " + file.string());
+        }
+
+        Report report;
+        RecordReader reader(in, format == Format::Csv);
+        Columns columns;
+        if (format == Format::Csv) {
+            Record header;
+            if (!reader.next(header)) {
+                throw std::runtime_error("CSV file has no header row");
+            }
+            columns = readHeader(splitCsv(header.text));
+        }
+
+        // IDs continue from the store's next ID; bulkLoad() claims them only once the tasks are written
+        std::vector<std::unique_ptr<Task>> imported;
+        int id = tasks.getNextId();
+        std::vector<Record> block;
+        block.reserve(kBlockRecords);
+        while (true) {
+            block.clear();
+            for (Record record; block.size() < kBlockRecords && reader.next(record);) {
+                block.push_back(std::move(record));
+            }
+            if (block.empty()) break;
+            report.rows += block.size();
+
+            // Validate the block in parallel; each worker writes only its own slots
+            std::vector<std::optional<Row>> rows(block.size());
+            std::vector<std::string> errors(block.size());
+            Parallel::forEachChunk(block.size(), Parallel::workerCount(block.size(), kMinRecordsPerWorker), [&](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    try {
+                        switch (format) {
+                        case Format::Csv: rows[i] = parseCsv(block[i].text, columns); break;
+                        case Format::Ndjson: rows[i] = parseNdjson(block[i].text); break;
+                        case Format::TodoTxt: rows[i] = parseTodoTxt(block[i].text); break;
+                        }
+                    }
+                    catch (const std::exception& e) {
+                        errors[i] = e.what();
+                    }
+                }
+                });
+
+            // Accepted rows get one contiguous ID range, in input order
+            auto now = std::chrono::system_clock::now();
+            for (size_t i = 0; i < block.size(); ++i) {
+                if (!rows[i]) {
+                    if (report.rejectedRows++ < MAX_REJECTIONS) {
+                        report.rejected.push_back({ block[i].line, std::move(errors[i]) });
+                    }
+                    continue;
+                }
+                auto& row = *rows[i];
+                imported.push_back(std::make_unique<Task>(Task::fromFields(id++, row.name, row.status, row.priority,
+                    row.created.value_or(now), row.completed, row.due, std::move(row.description), std::move(row.tags))));
+            }
+        }
+        report.bytes = reader.bytes();
+
+        if (!imported.empty()) {
+            report.firstId = imported.front()->getId();
+            report.lastId = imported.back()->getId();
+        }
+        report.imported = imported.size();
+
+        auto result = tasks.bulkLoad(std::move(imported), file.string());
+        if (!result.success) {
+            throw std::runtime_error(result.message);
+        }
+        report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return report;
+    }
+
+} // namespace TaskImport
@@ -0,0 +1,554 @@
+/**
+ * @file TaskJson.cpp
+ * @brief Schema-generated JSON emitter and parser for tasks and snapshots
+ */
+
+#include "TaskJson.hpp"
+#include "TaskSchema.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+    using TimePoint = std::chrono::system_clock::time_point;
+    using Kind = TaskSchema::Kind;
+
+    int64_t epochSeconds(TimePoint time) {
+        return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+    }
+
+    TimePoint fromSeconds(int64_t seconds) {
+        return TimePoint{ std::chrono::seconds{ seconds } };
+    }
+
+    /// nlohmann::json objects keep keys sorted, so dump() prints fields in this order
+    constexpr auto kKeyOrder = [] {
+        std::array<size_t, TaskSchema::FIELD_COUNT> order{};
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::ranges::sort(order, {}, [](size_t i) { return TaskSchema::key(i); });
+        return order;
+    }();
+
+    template<typename Visitor>
+    void forEachInKeyOrder(Visitor&& visit) {
+        [&]<size_t... P>(std::index_sequence<P...>) {
+            (visit(std::get<kKeyOrder[P]>(TaskSchema::fields)), ...);
+        }(std::make_index_sequence<TaskSchema::FIELD_COUNT>{});
+    }
+
+    // ======================
+    // Scanning
+    // ======================
+
+    /**
+     * @brief Find the next byte a JSON string cannot copy verbatim
+     * @return First quote, backslash, control character or non-ASCII byte (or end)
+     */
+    const char* findSpecial(const char* p, const char* end) {
+#if defined(__SSE2__)
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i space = _mm_set1_epi8(0x20);
+        for (; end - p >= 16; p += 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            // Signed compare: bytes >= 0x80 are negative, so one test catches control and non-ASCII bytes
+            __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                _mm_cmplt_epi8(chunk, space));
+            if (int mask = _mm_movemask_epi8(hits)) {
+                return p + std::countr_zero(static_cast<unsigned>(mask));
+            }
+        }
+#endif
+        for (; p < end; ++p) {
+            auto c = static_cast<unsigned char>(*p);
+            if (c == '"' || c == '\\' || c < 0x20 || c >= 0x80) return p;
+        }
+        return end;
+    }
+
+    /**
+     * @brief Measure the well-formed UTF-8 sequence at p (RFC 3629)
+     * @return Sequence length, or 0 if malformed, overlong, a surrogate or truncated
+     */
+    size_t utf8Sequence(const char* p, const char* end) {
+        auto trail = [&](size_t i, unsigned char low = 0x80, unsigned char high = 0xBF) {
+            return end - p > static_cast<std::ptrdiff_t>(i)
+                && static_cast<unsigned char>(p[i]) >= low && static_cast<unsigned char>(p[i]) <= high;
+        };
+        auto lead = static_cast<unsigned char>(*p);
+        if (lead >= 0xC2 && lead <= 0xDF) return trail(1) ? 2 : 0;
+        if (lead == 0xE0) return trail(1, 0xA0) && trail(2) ? 3 : 0;
+        if (lead == 0xED) return trail(1, 0x80, 0x9F) && trail(2) ? 3 : 0;
+        if (lead >= 0xE1 && lead <= 0xEF) return trail(1) && trail(2) ? 3 : 0;
+        if (lead == 0xF0) return trail(1, 0x90) && trail(2) && trail(3) ? 4 : 0;
+        if (lead >= 0xF1 && lead <= 0xF3) return trail(1) && trail(2) && trail(3) ? 4 : 0;
+        if (lead == 0xF4) return trail(1, 0x80, 0x8F) && trail(2) && trail(3) ? 4 : 0;
+        return 0;
+    }
+
+    // ======================
+    // Emitter
+    // ======================
+
+    void appendInt(std::string& out, int64_t value) {
+        char digits[24];
+        auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, end);
+    }
+
+    /**
+     * @brief Append a quoted string with dump()'s escapes
+     * @return false if the text is not valid UTF-8 (dump() would throw)
+     */
+    bool appendString(std::string& out, std::string_view text) {
+        out += '"';
+        const char* p = text.data();
+        const char* end = p + text.size();
+        while (p < end) {
+            const char* special = findSpecial(p, end);
+            out.append(p, special);
+            if (special == end) break;
+            p = special;
+
+            auto c = static_cast<unsigned char>(*p);
+            if (c >= 0x80) {
+                size_t length = utf8Sequence(p, end);
+                if (length == 0) return false;
+                out.append(p, length);
+                p += length;
+                continue;
+            }
+
+            out += '\\';
+            switch (c) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '\b': out += 'b'; break;
+            case '\t': out += 't'; break;
+            case '\n': out += 'n'; break;
+            case '\f': out += 'f'; break;
+            case '\r': out += 'r'; break;
+            default: {
+                constexpr char hex[] = "0123456789abcdef";
+                out += "u00";
+                out += hex[c >> 4];
+                out += hex[c & 0xF];
+            }
+            }
+            ++p;
+        }
+        out += '"';
+        return true;
+    }
+
+    /**
+     * @brief Append a task object (pretty: dump(4) layout with each line after the first prefixed)
+     * @return false if a string is not valid UTF-8
+     */
+    template<bool Pretty>
+    bool emitTask(std::string& out, const Task& task, std::string_view indent) {
+        (void)task.getTags(); // Decodes cold fields before reading members directly
+        bool valid = true;
+        bool first = true;
+        auto key = [&](std::string_view name) {
+            out += first ? "{" : ",";
+            first = false;
+            if constexpr (Pretty) {
+                out += '\n';
+                out += indent;
+                out += "    ";
+            }
+            out += '"';
+            out += name;
+            out += Pretty ? "\": " : "\":";
+        };
+
+        forEachInKeyOrder([&](const auto& field) {
+            const auto& value = task.*field.member;
+            using F = std::remove_cvref_t<decltype(field)>;
+            if constexpr (F::kind == Kind::OptionalTime) {
+                if (!value) return;
+                key(field.key);
+                appendInt(out, epochSeconds(*value));
+            }
+            else {
+                key(field.key);
+                if constexpr (F::kind == Kind::Integer) appendInt(out, value);
+                else if constexpr (F::kind == Kind::Text) valid = appendString(out, value) && valid;
+                else if constexpr (F::kind == Kind::Status) appendInt(out, taskStatusToInt(value));
+                else if constexpr (F::kind == Kind::Priority) appendInt(out, taskPriorityToInt(value));
+                else if constexpr (F::kind == Kind::Time) appendInt(out, epochSeconds(value));
+                else if (value.empty()) {
+                    out += "[]";
+                }
+                else {
+                    out += '[';
+                    for (size_t i = 0; i < value.size(); ++i) {
+                        if (i > 0) out += ',';
+                        if constexpr (Pretty) {
+                            out += '\n';
+                            out += indent;
+                            out += "        ";
+                        }
+                        valid = appendString(out, value[i]) && valid;
+                    }
+                    if constexpr (Pretty) {
+                        out += '\n';
+                        out += indent;
+                        out += "    ";
+                    }
+                    out += ']';
+                }
+            }
+            });
+
+        if constexpr (Pretty) {
+            out += '\n';
+            out += indent;
+        }
+        out += '}';
+        return valid;
+    }
+
+    // Generic path: prefix every line of dump(4) output (strings never contain raw newlines)
+    void appendIndented(std::string& out, std::string_view json, std::string_view indent) {
+        out += indent;
+        size_t start = 0;
+        for (size_t nl = json.find('\n'); nl != std::string_view::npos; nl = json.find('\n', start)) {
+            out.append(json, start, nl - start + 1);
+            out += indent;
+            start = nl + 1;
+        }
+        out.append(json, start);
+    }
+
+    // ======================
+    // Parser
+    // ======================
+
+    /// Thrown for input the fast path does not handle; the caller falls back to nlohmann
+    struct Unsupported {};
+
+    template<typename T>
+    T narrow(int64_t value) {
+        if (value < std::numeric_limits<T>::min() || value > std::numeric_limits<T>::max()) {
+            throw Unsupported{};
+        }
+        return static_cast<T>(value);
+    }
+
+    void appendUtf8(std::string& out, uint32_t codepoint) {
+        if (codepoint < 0x80) {
+            out += static_cast<char>(codepoint);
+        }
+        else if (codepoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codepoint >> 6));
+            out += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+        else if (codepoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codepoint >> 12));
+            out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xF0 | (codepoint >> 18));
+            out += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+    }
+
+    /**
+     * @class Reader
+     * @brief Cursor over JSON text that decodes values straight into their destinations
+     */
+    class Reader {
+    public:
+        explicit Reader(std::string_view text) : p_(text.data()), end_(text.data() + text.size()) {}
+
+        void skipSpace() noexcept {
+            while (p_ < end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) ++p_;
+        }
+
+        bool consume(char c) noexcept {
+            skipSpace();
+            if (p_ < end_ && *p_ == c) {
+                ++p_;
+                return true;
+            }
+            return false;
+        }
+
+        void expect(char c) {
+            if (!consume(c)) throw Unsupported{};
+        }
+
+        bool atEnd() noexcept {
+            skipSpace();
+            return p_ == end_;
+        }
+
+        // Integers only; fractions and exponents go to the generic path
+        int64_t integer() {
+            skipSpace();
+            const char* start = p_;
+            if (p_ < end_ && *p_ == '-') ++p_;
+            if (p_ == end_ || *p_ < '0' || *p_ > '9') throw Unsupported{};
+            if (*p_ == '0' && p_ + 1 < end_ && p_[1] >= '0' && p_[1] <= '9') throw Unsupported{}; // Leading zero
+
+            int64_t value = 0;
+            auto [next, ec] = std::from_chars(start, end_, value);
+            if (ec != std::errc{}) throw Unsupported{};
+            p_ = next;
+            if (p_ < end_ && (*p_ == '.' || *p_ == 'e' || *p_ == 'E')) throw Unsupported{};
+            return value;
+        }
+
+        void string(std::string& out) {
+            expect('"');
+            out.clear();
+            while (true) {
+                const char* special = findSpecial(p_, end_);
+                out.append(p_, special);
+                p_ = special;
+                if (p_ == end_) throw Unsupported{};
+
+                auto c = static_cast<unsigned char>(*p_);
+                if (c == '"') {
+                    ++p_;
+                    return;
+                }
+                if (c >= 0x80) {
+                    size_t length = utf8Sequence(p_, end_);
+                    if (length == 0) throw Unsupported{};
+                    out.append(p_, length);
+                    p_ += length;
+                    continue;
+                }
+                if (c < 0x20 || ++p_ == end_) throw Unsupported{};
+
+                switch (*p_++) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    uint32_t codepoint = hex4();
+                    if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+                        if (end_ - p_ < 2 || p_[0] != '\\' || p_[1] != 'u') throw Unsupported{};
+                        p_ += 2;
+                        uint32_t low = hex4();
+                        if (low < 0xDC00 || low > 0xDFFF) throw Unsupported{};
+                        codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF) {
+                        throw Unsupported{};
+                    }
+                    appendUtf8(out, codepoint);
+                    break;
+                }
+                default: throw Unsupported{};
+                }
+            }
+        }
+
+        // Skip a value the schema does not know, after checking it is valid JSON
+        void skipValue() {
+            skipSpace();
+            if (p_ == end_) throw Unsupported{};
+            const char* start = p_;
+            if (*p_ == '"') {
+                string(scratch_);
+            }
+            else if (*p_ == '{' || *p_ == '[') {
+                int depth = 0;
+                do {
+                    if (p_ == end_) throw Unsupported{};
+                    if (*p_ == '"') {
+                        string(scratch_);
+                        continue;
+                    }
+                    if (*p_ == '{' || *p_ == '[') ++depth;
+                    else if (*p_ == '}' || *p_ == ']') --depth;
+                    ++p_;
+                } while (depth > 0);
+            }
+            else {
+                while (p_ < end_ && !std::strchr(",}] \t\r\n", *p_)) ++p_;
+            }
+            if (!nlohmann::json::accept(std::string_view(start, static_cast<size_t>(p_ - start)))) {
+                throw Unsupported{};
+            }
+        }
+
+        Task task() {
+            Task task(0, "-"); // Placeholder identity; required fields are checked below
+            uint32_t seen = 0;
+            expect('{');
+            if (!consume('}')) {
+                do {
+                    string(key_);
+                    expect(':');
+                    bool known = false;
+                    TaskSchema::forEach([&](const auto& field, auto index) {
+                        if (known || field.key != key_) return;
+                        known = true;
+                        seen |= uint32_t{ 1 } << index;
+                        auto& value = task.*field.member;
+                        using F = std::remove_cvref_t<decltype(field)>;
+                        if constexpr (F::kind == Kind::Integer) value = narrow<int>(integer());
+                        else if constexpr (F::kind == Kind::Text) string(value);
+                        else if constexpr (F::kind == Kind::Status) value = intToTaskStatus(narrow<int>(integer()));
+                        else if constexpr (F::kind == Kind::Priority) value = intToTaskPriority(narrow<int>(integer()));
+                        else if constexpr (F::kind == Kind::Time) value = fromSeconds(integer());
+                        else if constexpr (F::kind == Kind::OptionalTime) value = fromSeconds(integer());
+                        else {
+                            value.clear();
+                            expect('[');
+                            if (!consume(']')) {
+                                do {
+                                    string(value.emplace_back());
+                                } while (consume(','));
+                                expect(']');
+                            }
+                        }
+                        });
+                    if (!known) skipValue();
+                } while (consume(','));
+                expect('}');
+            }
+
+            TaskSchema::forEach([&](const auto& field, auto index) {
+                if (field.required && !(seen & (uint32_t{ 1 } << index))) throw Unsupported{};
+                });
+            if (task.getName().empty()) throw Unsupported{};
+            return task;
+        }
+
+    private:
+        const char* p_;
+        const char* end_;
+        std::string key_;       ///< Reused key buffer
+        std::string scratch_;   ///< Reused buffer for skipped strings
+
+        uint32_t hex4() {
+            if (end_ - p_ < 4) throw Unsupported{};
+            uint32_t value = 0;
+            for (int i = 0; i < 4; ++i) {
+                char c = *p_++;
+                value <<= 4;
+                if (c >= '0' && c <= '9') value |= static_cast<uint32_t>(c - '0');
+                else if (c >= 'a' && c <= 'f') value |= static_cast<uint32_t>(c - 'a' + 10);
+                else if (c >= 'A' && c <= 'F') value |= static_cast<uint32_t>(c - 'A' + 10);
+                else throw Unsupported{};
+            }
+            return value;
+        }
+    };
+
+} // namespace
+
+namespace TaskJson {
+
+    void appendPretty(std::string& out, const Task& task, std::string_view indent) {
+        size_t mark = out.size();
+        out += indent;
+        if (!emitTask<true>(out, task, indent)) {
+            out.resize(mark);
+            appendIndented(out, task.toJson().dump(4), indent); // Throws the same error dump() always has
+        }
+    }
+
+    void appendCompact(std::string& out, const Task& task) {
+        size_t mark = out.size();
+        if (!emitTask<false>(out, task, {})) {
+            out.resize(mark);
+            out += task.toJson().dump();
+        }
+    }
+
+    std::string dumpCompact(const Task& task) {
+        std::string out;
+        appendCompact(out, task);
+        return out;
+    }
+
+    Task parseTask(std::string_view text) {
+        try {
+            Reader reader(text);
+            Task task = reader.task();
+            if (reader.atEnd()) return task;
+        }
+        catch (const Unsupported&) {}
+        catch (const std::exception&) {}
+        return Task::fromJson(nlohmann::json::parse(text));
+    }
+
+    std::vector<std::unique_ptr<Task>> parseSnapshot(std::string_view text, int& nextId) {
+        try {
+            Reader reader(text);
+            std::vector<std::unique_ptr<Task>> tasks;
+            int parsedNextId = nextId;
+            std::string key;
+            reader.expect('{');
+            if (!reader.consume('}')) {
+                do {
+                    reader.string(key);
+                    reader.expect(':');
+                    if (key == "nextId") {
+                        parsedNextId = narrow<int>(reader.integer());
+                    }
+                    else if (key == "tasks") {
+                        tasks.clear();
+                        reader.expect('[');
+                        if (!reader.consume(']')) {
+                            do {
+                                tasks.push_back(std::make_unique<Task>(reader.task()));
+                            } while (reader.consume(','));
+                            reader.expect(']');
+                        }
+                    }
+                    else {
+                        reader.skipValue();
+                    }
+                } while (reader.consume(','));
+                reader.expect('}');
+            }
+            if (reader.atEnd()) {
+                nextId = parsedNextId;
+                return tasks;
+            }
+        }
+        catch (const Unsupported&) {}
+        catch (const std::exception&) {}
+
+        // Generic path: also the one that reports errors for malformed input
+        auto j = nlohmann::json::parse(text);
+        if (j.contains("nextId")) {
+            nextId = j["nextId"];
+        }
+
+        std::vector<std::unique_ptr<Task>> tasks;
+        if (j.contains("tasks")) {
+            tasks.reserve(j["tasks"].size());
+            for (const auto& taskJson : j["tasks"]) {
+                tasks.push_back(std::make_unique<Task>(Task::fromJson(taskJson)));
+            }
+        }
+        return tasks;
+    }
+
+} // namespace TaskJson
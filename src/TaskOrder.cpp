@@ -0,0 +1,214 @@
+/**
+ * @file TaskOrder.cpp
+ * @brief Order-statistic treap behind TaskOrder
+ */
+
+#include "TaskOrder.hpp"
+#include <algorithm>
+#include <limits>
+
+TaskOrder::Key TaskOrder::keyOf(const Task& task) noexcept {
+    const auto& due = task.getDueDate();
+    return { -static_cast<int>(task.getPriority()),
+        due ? static_cast<int64_t>(due->time_since_epoch().count()) : std::numeric_limits<int64_t>::max(),
+        static_cast<int64_t>(task.getCreatedAt().time_since_epoch().count()),
+        task.getId() };
+}
+
+// ==================
+// Node Management
+// ==================
+
+uint32_t TaskOrder::nextWeight() noexcept {
+    seed_ ^= seed_ << 13;
+    seed_ ^= seed_ >> 7;
+    seed_ ^= seed_ << 17;
+    return static_cast<uint32_t>(seed_ >> 32);
+}
+
+uint32_t TaskOrder::allocate(Task* task, const Key& key) {
+    uint32_t slot;
+    if (!free_.empty()) {
+        slot = free_.back();
+        free_.pop_back();
+    }
+    else {
+        slot = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    nodes_[slot] = Node{ key, task, kNil, kNil, 1, nextWeight() };
+    return slot;
+}
+
+void TaskOrder::pull(uint32_t node) noexcept {
+    nodes_[node].size = 1 + nodes_[nodes_[node].left].size + nodes_[nodes_[node].right].size;
+}
+
+void TaskOrder::split(uint32_t node, const Key& key, uint32_t& less, uint32_t& rest) {
+    if (node == kNil) {
+        less = rest = kNil;
+        return;
+    }
+    if (nodes_[node].key < key) {
+        split(nodes_[node].right, key, nodes_[node].right, rest);
+        less = node;
+    }
+    else {
+        split(nodes_[node].left, key, less, nodes_[node].left);
+        rest = node;
+    }
+    pull(node);
+}
+
+uint32_t TaskOrder::merge(uint32_t left, uint32_t right) {
+    if (left == kNil) return right;
+    if (right == kNil) return left;
+    if (nodes_[left].weight > nodes_[right].weight) {
+        nodes_[left].right = merge(nodes_[left].right, right);
+        pull(left);
+        return left;
+    }
+    nodes_[right].left = merge(left, nodes_[right].left);
+    pull(right);
+    return right;
+}
+
+uint32_t TaskOrder::eraseKey(uint32_t node, const Key& key) {
+    if (node == kNil) return kNil;
+    if (key < nodes_[node].key) {
+        nodes_[node].left = eraseKey(nodes_[node].left, key);
+    }
+    else if (nodes_[node].key < key) {
+        nodes_[node].right = eraseKey(nodes_[node].right, key);
+    }
+    else {
+        const uint32_t joined = merge(nodes_[node].left, nodes_[node].right);
+        free_.push_back(node);
+        return joined;
+    }
+    pull(node);
+    return node;
+}
+
+// ==================
+// Public Interface
+// ==================
+
+void TaskOrder::rebuild(std::span<const std::unique_ptr<Task>> tasks) {
+    clear();
+    nodes_.reserve(tasks.size() + 1);
+    nodeOf_.reserve(tasks.size());
+
+    std::vector<std::pair<Key, Task*>> sorted;
+    sorted.reserve(tasks.size());
+    for (const auto& task : tasks) {
+        sorted.emplace_back(keyOf(*task), task.get());
+    }
+    std::ranges::sort(sorted, {}, &std::pair<Key, Task*>::first);
+
+    // Cartesian-tree construction: the right spine lives on a stack, so
+    // each node is pushed and popped once
+    std::vector<uint32_t> spine;
+    for (const auto& [key, task] : sorted) {
+        const uint32_t node = allocate(task, key);
+        nodeOf_.emplace(key.id, node);
+        uint32_t last = kNil;
+        while (!spine.empty() && nodes_[spine.back()].weight < nodes_[node].weight) {
+            last = spine.back();
+            spine.pop_back();
+        }
+        nodes_[node].left = last;
+        if (!spine.empty()) nodes_[spine.back()].right = node;
+        spine.push_back(node);
+    }
+    root_ = spine.empty() ? kNil : spine.front();
+
+    // Sizes bottom-up: a post-order walk without recursion
+    std::vector<std::pair<uint32_t, bool>> pending;
+    if (root_ != kNil) pending.emplace_back(root_, false);
+    while (!pending.empty()) {
+        auto [node, expanded] = pending.back();
+        pending.pop_back();
+        if (expanded) {
+            pull(node);
+            continue;
+        }
+        pending.emplace_back(node, true);
+        if (nodes_[node].left != kNil) pending.emplace_back(nodes_[node].left, false);
+        if (nodes_[node].right != kNil) pending.emplace_back(nodes_[node].right, false);
+    }
+}
+
+void TaskOrder::insert(Task* task) {
+    const Key key = keyOf(*task);
+    const uint32_t node = allocate(task, key);
+    nodeOf_[key.id] = node;
+
+    uint32_t less, rest;
+    split(root_, key, less, rest);
+    root_ = merge(merge(less, node), rest);
+}
+
+void TaskOrder::update(Task* task) {
+    auto it = nodeOf_.find(task->getId());
+    if (it == nodeOf_.end()) {
+        insert(task);
+        return;
+    }
+    Node& node = nodes_[it->second];
+    if (node.key == keyOf(*task)) {
+        node.task = task;
+        return;
+    }
+    erase(task->getId());
+    insert(task);
+}
+
+void TaskOrder::erase(int id) {
+    auto it = nodeOf_.find(id);
+    if (it == nodeOf_.end()) return;
+    root_ = eraseKey(root_, nodes_[it->second].key);
+    nodeOf_.erase(it);
+}
+
+void TaskOrder::clear() noexcept {
+    nodes_.resize(1);
+    free_.clear();
+    nodeOf_.clear();
+    root_ = kNil;
+}
+
+std::optional<size_t> TaskOrder::position(int id) const {
+    auto it = nodeOf_.find(id);
+    if (it == nodeOf_.end()) return std::nullopt;
+
+    const Key& key = nodes_[it->second].key;
+    size_t before = 0;
+    uint32_t node = root_;
+    while (node != kNil) {
+        if (key < nodes_[node].key) {
+            node = nodes_[node].left;
+        }
+        else {
+            const size_t leftSize = nodes_[nodes_[node].left].size;
+            if (!(nodes_[node].key < key)) return before + leftSize;
+            before += leftSize + 1;
+            node = nodes_[node].right;
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<Task*> TaskOrder::ordered() const {
+    std::vector<Task*> result;
+    result.reserve(nodeOf_.size());
+    forEach([&result](Task* task) {
+        result.push_back(task);
+        return true;
+    });
+    return result;
+}
+
+size_t TaskOrder::size() const noexcept {
+    return nodeOf_.size();
+}
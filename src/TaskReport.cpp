@@ -0,0 +1,307 @@
+/**
+ * @file TaskReport.cpp
+ * @brief Single-pass parallel hash aggregation behind TaskReport
+ */
+
+#include "TaskReport.hpp"
+#include "Parallel.hpp"
+#include "TextFormat.hpp"
+#include "TimeZone.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace TaskReport {
+
+    namespace {
+
+        constexpr size_t kMinTasksPerWorker = 16384;
+        constexpr int64_t kNoDueWeek = std::numeric_limits<int64_t>::max();
+        constexpr std::string_view kNone = "(none)";
+
+        template<typename Value>
+        struct Named {
+            std::string_view name;
+            Value value;
+        };
+
+        constexpr std::array<Named<Dimension>, 4> kDimensions{ {
+            { "tag", Dimension::Tag },
+            { "status", Dimension::Status },
+            { "priority", Dimension::Priority },
+            { "due_week", Dimension::DueWeek },
+        } };
+
+        constexpr std::array<Named<Metric>, 4> kMetrics{ {
+            { "count", Metric::Count },
+            { "overdue", Metric::Overdue },
+            { "completed", Metric::Completed },
+            { "avg_age", Metric::AvgAge },
+        } };
+
+        template<typename Value, size_t N>
+        std::optional<std::vector<Value>> parseList(std::string_view spec, const std::array<Named<Value>, N>& known) {
+            std::vector<Value> values;
+            for (const auto& part : Utils::split(spec, ',')) {
+                const std::string name = Utils::trim(part);
+                auto it = std::ranges::find(known, name, &Named<Value>::name);
+                if (it == known.end() || std::ranges::find(values, it->value) != values.end()) {
+                    return std::nullopt;
+                }
+                values.push_back(it->value);
+            }
+            if (values.empty()) {
+                return std::nullopt;
+            }
+            return values;
+        }
+
+        /// Monday of the ISO week holding an instant's local day, in days since 1970-01-01
+        [[nodiscard]] int64_t weekStart(std::chrono::system_clock::time_point instant) noexcept {
+            const int64_t seconds = std::chrono::floor<std::chrono::seconds>(instant).time_since_epoch().count();
+            const int64_t day = TimeZone::local().localDay(seconds);
+            const int64_t weekday = ((day % 7) + 7 + 3) % 7;   // 1970-01-01 was a Thursday; Monday = 0
+            return day - weekday;
+        }
+
+        /// ISO 8601 week label ("2025-W23"); the week belongs to the year holding its Thursday
+        [[nodiscard]] std::string weekLabel(int64_t monday) {
+            const int64_t thursday = monday + 3;
+            const int64_t year = TextFormat::civilFromDays(thursday).year;
+            const int64_t week = (thursday - TextFormat::daysFromCivil(year, 1, 1)) / 7 + 1;
+            std::string label;
+            TextFormat::appendInt(label, year);
+            label += week < 10 ? "-W0" : "-W";
+            TextFormat::appendInt(label, week);
+            return label;
+        }
+
+        void appendCode(std::string& key, int64_t code) {
+            char bytes[sizeof(code)];
+            std::memcpy(bytes, &code, sizeof(code));
+            key.append(bytes, sizeof(code));
+        }
+
+        [[nodiscard]] int64_t readCode(std::string_view key, size_t& pos) noexcept {
+            int64_t code;
+            std::memcpy(&code, key.data() + pos, sizeof(code));
+            pos += sizeof(code);
+            return code;
+        }
+
+        struct KeyHash {
+            using is_transparent = void;
+            size_t operator()(std::string_view key) const noexcept { return std::hash<std::string_view>{}(key); }
+        };
+
+        /// Packed group key -> totals; one per worker, merged at the end
+        using Table = std::unordered_map<std::string, Totals, KeyHash, std::equal_to<>>;
+
+        /**
+         * @brief Write a task's group keys into keys[0, count)
+         *
+         * Fixed-width codes for status, priority and due week; a tag is a
+         * presence byte plus the tag text and a terminator. A task with n
+         * tags yields n keys. Buffers are reused across tasks.
+         */
+        size_t buildKeys(const Task& task, const std::vector<Dimension>& groupBy, std::vector<std::string>& keys) {
+            if (keys.empty()) keys.emplace_back();
+            keys[0].clear();
+            size_t count = 1;
+
+            for (Dimension dimension : groupBy) {
+                switch (dimension) {
+                case Dimension::Status:
+                    for (size_t k = 0; k < count; ++k) appendCode(keys[k], static_cast<int64_t>(task.getStatus()));
+                    break;
+                case Dimension::Priority:
+                    for (size_t k = 0; k < count; ++k) appendCode(keys[k], static_cast<int64_t>(task.getPriority()));
+                    break;
+                case Dimension::DueWeek: {
+                    const auto& due = task.getDueDate();
+                    const int64_t week = due ? weekStart(*due) : kNoDueWeek;
+                    for (size_t k = 0; k < count; ++k) appendCode(keys[k], week);
+                    break;
+                }
+                case Dimension::Tag: {
+                    const auto& tags = task.getTags();
+                    if (tags.empty()) {
+                        for (size_t k = 0; k < count; ++k) keys[k] += '\1';
+                        break;
+                    }
+                    // Copies for the second and later tags, then each copy gets its tag
+                    if (keys.size() < count * tags.size()) keys.resize(count * tags.size());
+                    for (size_t t = 1; t < tags.size(); ++t) {
+                        for (size_t k = 0; k < count; ++k) keys[t * count + k] = keys[k];
+                    }
+                    for (size_t t = 0; t < tags.size(); ++t) {
+                        for (size_t k = 0; k < count; ++k) {
+                            auto& key = keys[t * count + k];
+                            key += '\0';
+                            key += tags[t];
+                            key += '\0';
+                        }
+                    }
+                    count *= tags.size();
+                    break;
+                }
+                }
+            }
+            return count;
+        }
+
+        /// A decoded group: sort codes per dimension plus display labels
+        struct Group {
+            std::vector<int64_t> codes;
+            Row row;
+        };
+
+        [[nodiscard]] Group decode(std::string_view key, const std::vector<Dimension>& groupBy) {
+            Group group;
+            size_t pos = 0;
+            for (Dimension dimension : groupBy) {
+                switch (dimension) {
+                case Dimension::Status: {
+                    const auto status = static_cast<TaskStatus>(readCode(key, pos));
+                    group.codes.push_back(static_cast<int64_t>(status));
+                    group.row.labels.push_back(Task(0, "temp", status, TaskPriority::LOW).getStatusString());
+                    break;
+                }
+                case Dimension::Priority: {
+                    const auto priority = static_cast<TaskPriority>(readCode(key, pos));
+                    group.codes.push_back(-static_cast<int64_t>(priority));  // High first, as in listings
+                    group.row.labels.push_back(Task(0, "temp", TaskStatus::TODO, priority).getPriorityString());
+                    break;
+                }
+                case Dimension::DueWeek: {
+                    const int64_t week = readCode(key, pos);
+                    group.codes.push_back(week);
+                    group.row.labels.push_back(week == kNoDueWeek ? std::string{ kNone } : weekLabel(week));
+                    break;
+                }
+                case Dimension::Tag: {
+                    const bool untagged = key[pos++] == '\1';
+                    group.codes.push_back(untagged ? 1 : 0);
+                    if (untagged) {
+                        group.row.labels.emplace_back(kNone);
+                        break;
+                    }
+                    const size_t end = key.find('\0', pos);
+                    group.row.labels.emplace_back(key.substr(pos, end - pos));
+                    pos = end + 1;
+                    break;
+                }
+                }
+            }
+            return group;
+        }
+
+    } // namespace
+
+    // ==================
+    // Totals
+    // ==================
+
+    void Totals::add(const Task& task, const EvalContext& context) noexcept {
+        counts.add(task, context);
+        ageSeconds += std::chrono::duration_cast<std::chrono::seconds>(context.now - task.getCreatedAt()).count();
+    }
+
+    Totals& Totals::operator+=(const Totals& other) noexcept {
+        counts += other.counts;
+        ageSeconds += other.ageSeconds;
+        return *this;
+    }
+
+    double Totals::averageAgeDays() const noexcept {
+        return counts.total == 0 ? 0.0 : static_cast<double>(ageSeconds) / 86400.0 / static_cast<double>(counts.total);
+    }
+
+    // ==================
+    // Names and Parsing
+    // ==================
+
+    std::optional<std::vector<Dimension>> parseDimensions(std::string_view spec) {
+        return parseList(spec, kDimensions);
+    }
+
+    std::optional<std::vector<Metric>> parseMetrics(std::string_view spec) {
+        return parseList(spec, kMetrics);
+    }
+
+    std::string_view dimensionNames() noexcept {
+        return "tag, status, priority, due_week";
+    }
+
+    std::string_view metricNames() noexcept {
+        return "count, overdue, completed, avg_age";
+    }
+
+    std::string_view dimensionName(Dimension dimension) noexcept {
+        return std::ranges::find(kDimensions, dimension, &Named<Dimension>::value)->name;
+    }
+
+    std::string_view metricName(Metric metric) noexcept {
+        return std::ranges::find(kMetrics, metric, &Named<Metric>::value)->name;
+    }
+
+    // ==================
+    // Aggregation
+    // ==================
+
+    std::vector<Row> aggregate(std::span<const Task* const> tasks, const std::vector<Dimension>& groupBy, const EvalContext& context) {
+        // One pass: each worker hashes its chunk into a private table
+        const size_t workers = Parallel::workerCount(tasks.size(), kMinTasksPerWorker);
+        std::vector<Table> tables(workers);
+        Parallel::forEachChunk(tasks.size(), workers, [&](size_t worker, size_t begin, size_t end) {
+            auto& table = tables[worker];
+            std::vector<std::string> keys;
+            for (size_t i = begin; i < end; ++i) {
+                const Task& task = *tasks[i];
+                const size_t count = buildKeys(task, groupBy, keys);
+                for (size_t k = 0; k < count; ++k) {
+                    auto it = table.find(std::string_view{ keys[k] });
+                    if (it == table.end()) {
+                        it = table.emplace(keys[k], Totals{}).first;
+                    }
+                    it->second.add(task, context);
+                }
+            }
+            });
+
+        for (size_t w = 1; w < tables.size(); ++w) {
+            for (auto& [key, totals] : tables[w]) {
+                tables[0][key] += totals;
+            }
+        }
+
+        std::vector<Group> groups;
+        if (!tables.empty()) {
+            groups.reserve(tables[0].size());
+            for (const auto& [key, totals] : tables[0]) {
+                auto& group = groups.emplace_back(decode(key, groupBy));
+                group.row.totals = totals;
+            }
+        }
+
+        // Codes order status, priority and weeks; tags tie on code and fall back to their text
+        std::ranges::sort(groups, [](const Group& a, const Group& b) {
+            for (size_t d = 0; d < a.codes.size(); ++d) {
+                if (a.codes[d] != b.codes[d]) return a.codes[d] < b.codes[d];
+                if (a.row.labels[d] != b.row.labels[d]) return a.row.labels[d] < b.row.labels[d];
+            }
+            return false;
+            });
+
+        std::vector<Row> rows;
+        rows.reserve(groups.size());
+        for (auto& group : groups) {
+            rows.push_back(std::move(group.row));
+        }
+        return rows;
+    }
+
+} // namespace TaskReport
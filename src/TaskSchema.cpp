@@ -0,0 +1,207 @@
+/**
+ * @file TaskSchema.cpp
+ * @brief Codecs generated from the Task field table
+ */
+
+#include "TaskSchema.hpp"
+#include "ByteOrder.hpp"
+#include "TextFormat.hpp"
+#include "utils.hpp"
+#include <stdexcept>
+
+namespace {
+
+    using TimePoint = std::chrono::system_clock::time_point;
+    using Kind = TaskSchema::Kind;
+
+    int64_t epochSeconds(TimePoint time) {
+        return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+    }
+
+    TimePoint fromSeconds(int64_t seconds) {
+        return TimePoint{ std::chrono::seconds{ seconds } };
+    }
+
+    std::string_view statusKey(TaskStatus status) {
+        switch (status) {
+        case TaskStatus::TODO: return "todo";
+        case TaskStatus::IN_PROGRESS: return "inprogress";
+        case TaskStatus::COMPLETED: return "completed";
+        }
+        return "todo";
+    }
+
+    std::string_view priorityKey(TaskPriority priority) {
+        switch (priority) {
+        case TaskPriority::LOW: return "low";
+        case TaskPriority::MEDIUM: return "medium";
+        case TaskPriority::HIGH: return "high";
+        }
+        return "low";
+    }
+
+    void appendCsvText(std::string& out, std::string_view text) {
+        if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+            out += text;
+            return;
+        }
+        out += '"';
+        for (char c : text) {
+            if (c == '"') out += '"';
+            out += c;
+        }
+        out += '"';
+    }
+
+} // namespace
+
+// ======================
+// JSON
+// ======================
+
+// Each visitor branches on F::kind with if constexpr, so every field compiles to its own branch only
+nlohmann::json TaskSchema::toJson(const Task& task) {
+    task.ensureColdFields();
+    nlohmann::json j = nlohmann::json::object();
+    forEach([&](const auto& field, auto) {
+        const auto& value = task.*field.member;
+        using F = std::remove_cvref_t<decltype(field)>;
+        if constexpr (F::kind == Kind::Status) j[field.key] = taskStatusToInt(value);
+        else if constexpr (F::kind == Kind::Priority) j[field.key] = taskPriorityToInt(value);
+        else if constexpr (F::kind == Kind::Time) j[field.key] = epochSeconds(value);
+        else if constexpr (F::kind == Kind::OptionalTime) { if (value) j[field.key] = epochSeconds(*value); }
+        else j[field.key] = value;
+        });
+    return j;
+}
+
+Task TaskSchema::fromJson(const nlohmann::json& j) {
+    Task task(0, "-"); // Placeholder identity; every required field is overwritten below
+    forEach([&](const auto& field, auto) {
+        auto it = j.find(field.key);
+        if (it == j.end()) {
+            if (field.required) (void)j.at(field.key); // Throws the usual out_of_range error
+            return;
+        }
+        auto& value = task.*field.member;
+        using F = std::remove_cvref_t<decltype(field)>;
+        if constexpr (F::kind == Kind::Integer) value = it->template get<int>();
+        else if constexpr (F::kind == Kind::Text) value = it->template get<std::string>();
+        else if constexpr (F::kind == Kind::Status) value = intToTaskStatus(it->template get<int>());
+        else if constexpr (F::kind == Kind::Priority) value = intToTaskPriority(it->template get<int>());
+        else if constexpr (F::kind == Kind::Time) value = fromSeconds(it->template get<int64_t>());
+        else if constexpr (F::kind == Kind::OptionalTime) value = fromSeconds(it->template get<int64_t>());
+        else value = it->template get<std::vector<std::string>>();
+        });
+    if (task.name.empty()) {
+        throw std::invalid_argument("Task name cannot be empty");
+    }
+    return task;
+}
+
+// ======================
+// Binary Encoding and Hashing
+// ======================
+
+void TaskSchema::encodeField(std::string& out, const Task& task, size_t index) {
+    forEach([&](const auto& field, auto i) {
+        if (i != index) return;
+        const auto& value = task.*field.member;
+        using F = std::remove_cvref_t<decltype(field)>;
+        if constexpr (F::kind == Kind::Integer) ByteOrder::putLE<int32_t>(out, value);
+        else if constexpr (F::kind == Kind::Text) out += value;
+        else if constexpr (F::kind == Kind::Status) out.push_back(static_cast<char>(taskStatusToInt(value)));
+        else if constexpr (F::kind == Kind::Priority) out.push_back(static_cast<char>(taskPriorityToInt(value)));
+        else if constexpr (F::kind == Kind::Time) ByteOrder::putLE<int64_t>(out, epochSeconds(value));
+        else if constexpr (F::kind == Kind::OptionalTime) {
+            // Absent timestamps encode as no bytes, so they never collide with any present value
+            if (value) ByteOrder::putLE<int64_t>(out, epochSeconds(*value));
+        }
+        else {
+            for (const auto& item : value) {
+                ByteOrder::putLE<uint32_t>(out, static_cast<uint32_t>(item.size()));
+                out += item;
+            }
+        }
+        });
+}
+
+uint64_t TaskSchema::fieldHash(const Task& task, size_t index) {
+    std::string bytes;
+    encodeField(bytes, task, index);
+    return Utils::hash64(bytes, static_cast<uint64_t>(index) + 1);
+}
+
+uint64_t TaskSchema::contentHash(const Task& task) {
+    task.ensureColdFields();
+    uint64_t hash = 0; // Wraps modulo 2^64 by design
+    for (size_t i = 0; i < FIELD_COUNT; ++i) {
+        hash += fieldHash(task, i);
+    }
+    return hash;
+}
+
+// ======================
+// Diff
+// ======================
+
+uint32_t TaskSchema::changedFields(const Task& a, const Task& b) {
+    a.ensureColdFields();
+    b.ensureColdFields();
+    uint32_t changed = 0;
+    forEach([&](const auto& field, auto i) {
+        const auto& left = a.*field.member;
+        const auto& right = b.*field.member;
+        using F = std::remove_cvref_t<decltype(field)>;
+        bool same;
+        if constexpr (F::kind == Kind::Time) {
+            same = epochSeconds(left) == epochSeconds(right);
+        }
+        else if constexpr (F::kind == Kind::OptionalTime) {
+            same = left.has_value() == right.has_value() && (!left || epochSeconds(*left) == epochSeconds(*right));
+        }
+        else {
+            same = left == right;
+        }
+        if (!same) changed |= uint32_t{ 1 } << i;
+        });
+    return changed;
+}
+
+// ======================
+// CSV
+// ======================
+
+std::string TaskSchema::csvHeader() {
+    std::string header;
+    forEach([&](const auto& field, auto i) {
+        if (i > 0) header += ',';
+        header += field.key;
+        });
+    header += '\n';
+    return header;
+}
+
+void TaskSchema::appendCsvRow(std::string& out, const Task& task) {
+    task.ensureColdFields();
+    forEach([&](const auto& field, auto i) {
+        if (i > 0) out += ',';
+        const auto& value = task.*field.member;
+        using F = std::remove_cvref_t<decltype(field)>;
+        if constexpr (F::kind == Kind::Integer) TextFormat::appendInt(out, value);
+        else if constexpr (F::kind == Kind::Text) appendCsvText(out, value);
+        else if constexpr (F::kind == Kind::Status) out += statusKey(value);
+        else if constexpr (F::kind == Kind::Priority) out += priorityKey(value);
+        else if constexpr (F::kind == Kind::Time) TextFormat::appendInt(out, epochSeconds(value));
+        else if constexpr (F::kind == Kind::OptionalTime) { if (value) TextFormat::appendInt(out, epochSeconds(*value)); }
+        else {
+            std::string joined;
+            for (const auto& item : value) {
+                if (!joined.empty()) joined += ';';
+                joined += item;
+            }
+            appendCsvText(out, joined);
+        }
+        });
+    out += '\n';
+}
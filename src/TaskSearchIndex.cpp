@@ -1,9 +1,31 @@
 #include "TaskSearchIndex.hpp"
 #include "utils.hpp"
+#include "Parallel.hpp"
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <deque>
 #include <unordered_set>
 
+namespace {
+
+    /**
+     * @brief One indexed suffix and the position of the task it came from
+     *
+     * Ordinals (rather than pointers) keep the sort deterministic and make
+     * each node's task list come out in collection order, matching what
+     * repeated addTask() calls would have produced.
+     */
+    struct TermPosting {
+        std::string_view term;
+        uint32_t ordinal;
+
+        bool operator==(const TermPosting&) const = default;
+        auto operator<=>(const TermPosting&) const = default;
+    };
+
+} // namespace
+
 void TaskSearchIndex::addTask(const Task& task) {
     // Index task name
     auto lowerName = Utils::toLowerCase(task.getName());
@@ -28,6 +50,92 @@ void TaskSearchIndex::addTask(const Task& task) {
     ++total_indexed_tasks_;
 }
 
+void TaskSearchIndex::build(std::span<const std::unique_ptr<Task>> tasks) {
+    clear();
+    if (tasks.empty()) return;
+
+    // Phase 1: tokenize disjoint chunks into (suffix, ordinal) postings.
+    // Lowercased fields live in per-worker arenas so postings can be views.
+    const size_t workers = Parallel::workerCount(tasks.size(), 2048);
+    std::vector<std::deque<std::string>> arenas(workers);
+    std::vector<std::vector<TermPosting>> partials(workers);
+
+    Parallel::forEachChunk(tasks.size(), workers, [&](size_t worker, size_t begin, size_t end) {
+        auto& arena = arenas[worker];
+        auto& out = partials[worker];
+
+        for (size_t i = begin; i < end; ++i) {
+            const Task& task = *tasks[i];
+            auto emit = [&](std::string_view field) {
+                if (field.empty()) return;
+                std::string_view lower = arena.emplace_back(Utils::toLowerCase(field));
+                for (size_t start = 0; start < lower.size(); ++start) {
+                    out.push_back({ lower.substr(start), static_cast<uint32_t>(i) });
+                }
+                };
+
+            // Same fields as addTask()
+            emit(task.getName());
+            emit(task.getDescription());
+            for (const auto& tag : task.getTags()) {
+                emit(tag);
+            }
+            emit(task.getStatusString());
+            emit(task.getPriorityString());
+        }
+        });
+
+    size_t total = 0;
+    for (const auto& partial : partials) total += partial.size();
+
+    std::vector<TermPosting> postings;
+    postings.reserve(total);
+    for (auto& partial : partials) {
+        postings.insert(postings.end(), partial.begin(), partial.end());
+        std::vector<TermPosting>{}.swap(partial);
+    }
+
+    // Phase 2: parallel sort by (term, ordinal) and drop repeated postings
+    Parallel::sort(postings);
+    postings.erase(std::unique(postings.begin(), postings.end()), postings.end());
+
+    // Phase 3: single pass over sorted terms. Consecutive terms share their
+    // longest common prefix with the current path, so only the diverging
+    // tail needs new nodes and every node's task list is written exactly once.
+    std::vector<TrieNode*> path{ root_.get() };
+    std::string_view previous;
+
+    for (size_t i = 0; i < postings.size();) {
+        std::string_view term = postings[i].term;
+        size_t groupEnd = i + 1;
+        while (groupEnd < postings.size() && postings[groupEnd].term == term) {
+            ++groupEnd;
+        }
+
+        size_t common = static_cast<size_t>(
+            std::mismatch(term.begin(), term.end(), previous.begin(), previous.end()).first - term.begin());
+        path.resize(common + 1);
+
+        for (size_t k = common; k < term.size(); ++k) {
+            auto& child = path.back()->children[term[k]];
+            if (!child) {
+                child = std::make_unique<TrieNode>();
+            }
+            path.push_back(child.get());
+        }
+
+        auto& taskRefs = path.back()->tasks;
+        taskRefs.reserve(taskRefs.size() + (groupEnd - i));
+        for (; i < groupEnd; ++i) {
+            taskRefs.emplace_back(std::cref(*tasks[postings[i].ordinal]));
+        }
+
+        previous = term;
+    }
+
+    total_indexed_tasks_ = tasks.size();
+}
+
 void TaskSearchIndex::removeTask(const Task& task) {
     // Remove from name index
     auto lowerName = Utils::toLowerCase(task.getName());
@@ -0,0 +1,266 @@
+/**
+ * @file TaskSort.cpp
+ * @brief Key packing and parallel LSD radix sort for TaskSort
+ */
+
+#include "TaskSort.hpp"
+#include "Parallel.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+
+namespace TaskSort {
+
+    namespace {
+
+        constexpr size_t kDigitBits = 11;
+        constexpr size_t kBuckets = size_t{ 1 } << kDigitBits;
+        constexpr size_t kMinItemsPerWorker = 65536;
+
+        struct FieldName {
+            std::string_view name;
+            Field field;
+        };
+
+        constexpr std::array<FieldName, 5> kFieldNames{ {
+            { "priority", Field::Priority },
+            { "due", Field::Due },
+            { "created", Field::Created },
+            { "status", Field::Status },
+            { "id", Field::Id },
+        } };
+
+        [[nodiscard]] std::optional<int64_t> fieldValue(const Task& task, Field field) noexcept {
+            switch (field) {
+            case Field::Priority: return static_cast<int64_t>(task.getPriority());
+            case Field::Status: return static_cast<int64_t>(task.getStatus());
+            case Field::Created: return static_cast<int64_t>(task.getCreatedAt().time_since_epoch().count());
+            case Field::Id: return task.getId();
+            case Field::Due:
+                if (const auto& due = task.getDueDate()) {
+                    return static_cast<int64_t>(due->time_since_epoch().count());
+                }
+                return std::nullopt;
+            }
+            return std::nullopt;
+        }
+
+        /// Observed range of one key, used to encode it in as few bits as possible
+        struct Range {
+            int64_t min = std::numeric_limits<int64_t>::max();
+            int64_t max = std::numeric_limits<int64_t>::min();
+            bool present = false;   ///< Some task has a value
+            bool absent = false;    ///< Some task has no value
+
+            void add(std::optional<int64_t> value) noexcept {
+                if (!value) {
+                    absent = true;
+                    return;
+                }
+                present = true;
+                min = std::min(min, *value);
+                max = std::max(max, *value);
+            }
+
+            void merge(const Range& other) noexcept {
+                min = std::min(min, other.min);
+                max = std::max(max, other.max);
+                present |= other.present;
+                absent |= other.absent;
+            }
+        };
+
+        /// Where one key lives in the packed integer and how its values map there
+        struct Slot {
+            Key key;
+            Range range;
+            size_t offset = 0;  ///< Lowest bit of the key
+            size_t width = 0;   ///< Bits used (0 when every task has the same value)
+            uint64_t span = 0;  ///< max - min
+
+            [[nodiscard]] uint64_t encode(std::optional<int64_t> value) const noexcept {
+                // Absent values take the code after the largest present one, so they sort last either way
+                if (!value) return range.present ? std::max(span, span + 1) : 0;
+                uint64_t fromMin = static_cast<uint64_t>(*value) - static_cast<uint64_t>(range.min);
+                return key.descending ? span - fromMin : fromMin;
+            }
+        };
+
+        template<size_t Words>
+        struct Record {
+            std::array<uint64_t, Words> key{};  ///< key[0] holds the least significant bits
+            uint32_t index = 0;                 ///< Position in the input
+        };
+
+        template<size_t Words>
+        void setBits(std::array<uint64_t, Words>& key, size_t offset, size_t width, uint64_t value) noexcept {
+            if (width == 0) return;
+            const size_t word = offset / 64;
+            const size_t bit = offset % 64;
+            key[word] |= value << bit;
+            if (bit + width > 64 && word + 1 < Words) {
+                key[word + 1] |= value >> (64 - bit);
+            }
+        }
+
+        template<size_t Words>
+        [[nodiscard]] size_t digitAt(const Record<Words>& record, size_t offset) noexcept {
+            const size_t word = offset / 64;
+            const size_t bit = offset % 64;
+            uint64_t value = record.key[word] >> bit;
+            if (bit + kDigitBits > 64 && word + 1 < Words) {
+                value |= record.key[word + 1] << (64 - bit);
+            }
+            return static_cast<size_t>(value & (kBuckets - 1));
+        }
+
+        template<size_t Words>
+        void radixSort(std::vector<Task*>& tasks, const std::vector<Slot>& slots,
+            const std::vector<std::optional<int64_t>>& values, size_t totalBits) {
+            const size_t count = tasks.size();
+            const size_t workers = Parallel::workerCount(count, kMinItemsPerWorker);
+
+            std::vector<Record<Words>> records(count);
+            Parallel::forEachChunk(count, workers, [&](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    auto& record = records[i];
+                    record.index = static_cast<uint32_t>(i);
+                    const auto* row = &values[i * slots.size()];
+                    for (size_t k = 0; k < slots.size(); ++k) {
+                        setBits(record.key, slots[k].offset, slots[k].width, slots[k].encode(row[k]));
+                    }
+                }
+                });
+
+            // One histogram per worker keeps scatter stable: worker w writes after workers < w in every bucket
+            std::vector<Record<Words>> scratch(count);
+            std::vector<std::array<size_t, kBuckets>> histograms(workers);
+            auto* source = &records;
+            auto* target = &scratch;
+            for (size_t shift = 0; shift < totalBits; shift += kDigitBits) {
+                Parallel::forEachChunk(count, workers, [&](size_t w, size_t begin, size_t end) {
+                    auto& histogram = histograms[w];
+                    histogram.fill(0);
+                    for (size_t i = begin; i < end; ++i) {
+                        ++histogram[digitAt((*source)[i], shift)];
+                    }
+                    });
+
+                size_t running = 0;
+                bool uniform = false;
+                for (size_t b = 0; b < kBuckets; ++b) {
+                    size_t bucketTotal = 0;
+                    for (auto& histogram : histograms) {
+                        bucketTotal += histogram[b];
+                        histogram[b] = running + bucketTotal - histogram[b];
+                    }
+                    uniform |= bucketTotal == count;
+                    running += bucketTotal;
+                }
+                if (uniform) continue;  // Every key shares this digit; the pass would not move anything
+
+                Parallel::forEachChunk(count, workers, [&](size_t w, size_t begin, size_t end) {
+                    auto& next = histograms[w];
+                    for (size_t i = begin; i < end; ++i) {
+                        (*target)[next[digitAt((*source)[i], shift)]++] = (*source)[i];
+                    }
+                    });
+                std::swap(source, target);
+            }
+
+            std::vector<Task*> sorted(count);
+            for (size_t i = 0; i < count; ++i) {
+                sorted[i] = tasks[(*source)[i].index];
+            }
+            tasks = std::move(sorted);
+        }
+
+    } // namespace
+
+    std::optional<Order> parseOrder(std::string_view spec) {
+        Order order;
+        for (const auto& part : Utils::split(spec, ',')) {
+            const std::string trimmed = Utils::trim(part);
+            std::string_view name = trimmed;
+            Key key;
+            if (name.starts_with('-') || name.starts_with('+')) {
+                key.descending = name.front() == '-';
+                name.remove_prefix(1);
+            }
+            auto known = std::ranges::find(kFieldNames, name, &FieldName::name);
+            if (known == kFieldNames.end()) {
+                return std::nullopt;
+            }
+            key.field = known->field;
+            if (std::ranges::find(order, key.field, &Key::field) != order.end()) {
+                return std::nullopt;
+            }
+            order.push_back(key);
+        }
+        if (order.empty()) {
+            return std::nullopt;
+        }
+        return order;
+    }
+
+    std::string_view fieldNames() noexcept {
+        return "priority, due, created, status, id";
+    }
+
+    void sort(std::vector<Task*>& tasks, const Order& order) {
+        if (tasks.size() < 2) return;
+
+        std::vector<Slot> slots(order.size());
+        for (size_t k = 0; k < order.size(); ++k) {
+            slots[k].key = order[k];
+        }
+        if (std::ranges::find(order, Field::Id, &Key::field) == order.end()) {
+            slots.emplace_back().key = Key{ Field::Id, false };
+        }
+
+        // Read each task once: extract its key values and measure every key's range,
+        // so each key takes only the bits it needs
+        const size_t workers = Parallel::workerCount(tasks.size(), kMinItemsPerWorker);
+        std::vector<std::optional<int64_t>> values(tasks.size() * slots.size());
+        std::vector<std::vector<Range>> partial(workers, std::vector<Range>(slots.size()));
+        Parallel::forEachChunk(tasks.size(), workers, [&](size_t w, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                auto* row = &values[i * slots.size()];
+                for (size_t k = 0; k < slots.size(); ++k) {
+                    row[k] = fieldValue(*tasks[i], slots[k].key.field);
+                    partial[w][k].add(row[k]);
+                }
+            }
+            });
+
+        // Least significant key at bit 0, so the first key in the order ends up on top
+        size_t totalBits = 0;
+        for (size_t k = slots.size(); k-- > 0;) {
+            auto& slot = slots[k];
+            for (const auto& ranges : partial) {
+                slot.range.merge(ranges[k]);
+            }
+            if (slot.range.present) {
+                slot.span = static_cast<uint64_t>(slot.range.max) - static_cast<uint64_t>(slot.range.min);
+            }
+            const uint64_t codes = slot.span + (slot.range.present && slot.range.absent ? 1 : 0);
+            slot.width = static_cast<size_t>(std::bit_width(codes));
+            if (codes < slot.span) slot.width = 64;  // Full int64 span plus "absent": absent shares the top code
+            slot.offset = totalBits;
+            totalBits += slot.width;
+        }
+
+        if (totalBits <= 64) {
+            radixSort<1>(tasks, slots, values, totalBits);
+        }
+        else if (totalBits <= 128) {
+            radixSort<2>(tasks, slots, values, totalBits);
+        }
+        else {
+            radixSort<3>(tasks, slots, values, totalBits);
+        }
+    }
+
+} // namespace TaskSort
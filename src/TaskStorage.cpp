@@ -0,0 +1,1148 @@
+/**
+ * @file TaskStorage.cpp
+ * @brief Snapshot serialization, binary hot/cold snapshots and vectored file output
+ */
+
+#include "TaskStorage.hpp"
+#include "BlockCodec.hpp"
+#include "ByteOrder.hpp"
+#include "Parallel.hpp"
+#include "TaskJson.hpp"
+#include "TextFormat.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+
+    // Indentation of a task object inside the top-level "tasks" array
+    constexpr std::string_view kElementIndent = "        ";
+
+    std::runtime_error ioError(std::string_view what, const std::filesystem::path& path) {
+        return std::runtime_error(std::string{ what } + " " + path.string() + ": " + std::strerror(errno));
+    }
+
+    // Make a rename or unlink in a directory survive a crash
+    void syncDirectory(const std::filesystem::path& file) {
+        auto directory = file.has_parent_path() ? file.parent_path() : std::filesystem::path{ "." };
+        int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            throw ioError("Could not open directory", directory);
+        }
+        if (::fsync(fd) != 0) {
+            int saved = errno;
+            ::close(fd);
+            errno = saved;
+            throw ioError("Could not sync directory", directory);
+        }
+        ::close(fd);
+    }
+
+    // ======================
+    // Binary Snapshot Encoding
+    // ======================
+
+    using ByteOrder::getLE;
+    using ByteOrder::putLE;
+
+    constexpr size_t kBinaryHeaderSize = 64;   ///< Fixed binary snapshot header size
+    constexpr size_t kHotRecordSize = 48;      ///< Fixed per-task hot record size
+    constexpr uint16_t kHasDueDate = 1;        ///< Hot record flag: due date present
+    constexpr uint8_t kHasCompletedAt = 1;     ///< Cold record flag: completion time present
+    constexpr uint64_t kIdsAscending = 1;      ///< Header flag: hot records sorted by id (enables binary search)
+    constexpr size_t kColdFixedSize = 8 + 1 + 8 + 4 + 4; ///< Checksum, flags, completed, description and tag count lengths
+
+    std::runtime_error corruptSnapshot(std::string_view what) {
+        return std::runtime_error("Corrupt binary snapshot: " + std::string{ what });
+    }
+
+    // Timestamps keep full clock resolution so binary round trips are lossless
+    int64_t toTicks(std::chrono::system_clock::time_point time) noexcept {
+        return static_cast<int64_t>(time.time_since_epoch().count());
+    }
+
+    std::chrono::system_clock::time_point fromTicks(int64_t ticks) noexcept {
+        return std::chrono::system_clock::time_point{ std::chrono::system_clock::duration{ ticks } };
+    }
+
+    void putString(std::string& out, std::string_view text) {
+        putLE(out, static_cast<uint32_t>(text.size()));
+        out.append(text);
+    }
+
+    /**
+     * @brief Append one task's cold record (checksum first, covering the rest)
+     */
+    void appendColdRecord(std::string& out, const Task& task) {
+        size_t start = out.size();
+        putLE(out, uint64_t{ 0 }); // checksum placeholder
+
+        const auto& completed = task.getCompletedAt();
+        out.push_back(static_cast<char>(completed ? kHasCompletedAt : 0));
+        putLE(out, completed ? toTicks(*completed) : int64_t{ 0 });
+        putString(out, task.getDescription());
+        putLE(out, static_cast<uint32_t>(task.getTags().size()));
+        for (const auto& tag : task.getTags()) {
+            putString(out, tag);
+        }
+
+        uint64_t checksum = Utils::hash64(std::string_view{ out }.substr(start + 8));
+        for (size_t i = 0; i < 8; ++i) {
+            out[start + i] = static_cast<char>((checksum >> (8 * i)) & 0xFF);
+        }
+    }
+
+    /**
+     * @class MappedFile
+     * @brief Read-only private mapping of a whole file
+     */
+    class MappedFile {
+    private:
+        void* base_ = nullptr;  ///< Mapping start
+        size_t size_ = 0;       ///< Mapping length
+
+    public:
+        /**
+         * @param path File to map
+         * @param minSize Smallest valid file size (must be non-zero)
+         * @throws std::runtime_error if the file is missing, too short or cannot be mapped
+         */
+        MappedFile(const std::filesystem::path& path, size_t minSize) {
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                throw ioError("Could not open file for reading:", path);
+            }
+
+            struct stat st {};
+            if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(minSize)) {
+                ::close(fd);
+                throw std::runtime_error(path.string() + ": file shorter than its header");
+            }
+
+            size_ = static_cast<size_t>(st.st_size);
+            base_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd); // The mapping keeps its own reference to the file
+            if (base_ == MAP_FAILED) {
+                base_ = nullptr;
+                throw ioError("Could not map file", path);
+            }
+        }
+
+        ~MappedFile() {
+            if (base_) ::munmap(base_, size_);
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] std::string_view bytes() const noexcept {
+            return { static_cast<const char*>(base_), size_ };
+        }
+    };
+
+    /**
+     * @class MappedSnapshot
+     * @brief Mapped binary snapshot that decodes cold records on demand
+     *
+     * Shared by every task loaded from the file; the mapping is released once
+     * the last task has decoded its cold fields (or been destroyed).
+     */
+    class MappedSnapshot final : public ColdFieldSource {
+    private:
+        MappedFile file_;  ///< Snapshot mapping
+
+    public:
+        explicit MappedSnapshot(const std::filesystem::path& path) : file_(path, kBinaryHeaderSize) {}
+
+        [[nodiscard]] std::string_view bytes() const noexcept {
+            return file_.bytes();
+        }
+
+        [[nodiscard]] TaskColdFields load(uint64_t offset, uint32_t length) const override {
+            std::string_view data = bytes();
+            if (offset > data.size() || length > data.size() - offset || length < kColdFixedSize) {
+                throw corruptSnapshot("cold record out of bounds");
+            }
+
+            std::string_view record = data.substr(offset, length);
+            if (Utils::hash64(record.substr(8)) != getLE<uint64_t>(record, 0)) {
+                throw corruptSnapshot("cold record checksum mismatch");
+            }
+
+            size_t pos = 8;
+            auto readString = [&]() {
+                if (record.size() - pos < 4) throw corruptSnapshot("truncated cold record");
+                auto size = getLE<uint32_t>(record, pos);
+                pos += 4;
+                if (record.size() - pos < size) throw corruptSnapshot("truncated cold record");
+                std::string text{ record.substr(pos, size) };
+                pos += size;
+                return text;
+                };
+
+            TaskColdFields fields;
+            auto flags = static_cast<uint8_t>(record[pos]);
+            auto completed = getLE<int64_t>(record, pos + 1);
+            pos += 9;
+            if (flags & kHasCompletedAt) fields.completed_at = fromTicks(completed);
+
+            fields.description = readString();
+            if (record.size() - pos < 4) throw corruptSnapshot("truncated cold record");
+            auto tagCount = getLE<uint32_t>(record, pos);
+            pos += 4;
+            if (tagCount > (record.size() - pos) / 4) throw corruptSnapshot("tag count out of bounds");
+            fields.tags.reserve(tagCount);
+            for (uint32_t i = 0; i < tagCount; ++i) {
+                fields.tags.push_back(readString());
+            }
+            return fields;
+        }
+    };
+
+    /**
+     * @brief Decode hot record index into a task whose cold fields stay mapped
+     */
+    Task decodeHotRecord(const std::shared_ptr<const MappedSnapshot>& mapping, uint32_t taskCount, uint64_t coldOffset,
+        size_t index) {
+        std::string_view data = mapping->bytes();
+        size_t pos = kBinaryHeaderSize + index * kHotRecordSize;
+        auto flags = getLE<uint16_t>(data, pos + 6);
+        auto nameOffset = getLE<uint64_t>(data, pos + 24);
+        auto nameLength = getLE<uint32_t>(data, pos + 32);
+        auto coldLength = getLE<uint32_t>(data, pos + 36);
+        auto coldRecord = getLE<uint64_t>(data, pos + 40);
+
+        if (nameOffset < kBinaryHeaderSize + uint64_t{ taskCount } * kHotRecordSize
+            || nameOffset > coldOffset || nameLength > coldOffset - nameOffset) {
+            throw corruptSnapshot("name out of bounds");
+        }
+        if (coldRecord < coldOffset || coldRecord > data.size() || coldLength > data.size() - coldRecord) {
+            throw corruptSnapshot("cold record out of bounds");
+        }
+
+        std::optional<std::chrono::system_clock::time_point> due;
+        if (flags & kHasDueDate) due = fromTicks(getLE<int64_t>(data, pos + 16));
+
+        return Task::fromHotFields(
+            getLE<int32_t>(data, pos),
+            data.substr(nameOffset, nameLength),
+            intToTaskStatus(static_cast<uint8_t>(data[pos + 4])),
+            intToTaskPriority(static_cast<uint8_t>(data[pos + 5])),
+            fromTicks(getLE<int64_t>(data, pos + 8)),
+            due, mapping, coldRecord, coldLength);
+    }
+
+    // ======================
+    // Offsets Sidecar
+    // ======================
+
+    constexpr std::string_view kOffsetsMagic = "TDX1";  ///< JSON offsets sidecar signature
+    constexpr uint32_t kOffsetsVersion = 1;             ///< Sidecar format version
+    constexpr size_t kOffsetsHeaderSize = 32;           ///< Magic, version, count, reserved, snapshot size, mtime
+    constexpr size_t kOffsetEntrySize = 16;             ///< id, length, offset
+
+    // Sidecars are only valid for the exact snapshot file they were written with
+    int64_t modificationTime(const struct stat& st) noexcept {
+        return static_cast<int64_t>(st.st_mtim.tv_sec) * 1'000'000'000 + st.st_mtim.tv_nsec;
+    }
+
+    /**
+     * @brief Write the id-sorted offsets sidecar for a freshly written JSON snapshot
+     */
+    void writeOffsetIndex(const std::filesystem::path& dataFile, std::vector<TaskStorage::RecordOffset> offsets) {
+        struct stat st {};
+        if (::stat(dataFile.c_str(), &st) != 0) {
+            throw ioError("Could not stat data file", dataFile);
+        }
+
+        std::ranges::sort(offsets, {}, &TaskStorage::RecordOffset::id);
+
+        std::string index{ kOffsetsMagic };
+        index.reserve(kOffsetsHeaderSize + offsets.size() * kOffsetEntrySize);
+        putLE(index, kOffsetsVersion);
+        putLE(index, static_cast<uint32_t>(offsets.size()));
+        putLE(index, uint32_t{ 0 }); // reserved
+        putLE(index, static_cast<uint64_t>(st.st_size));
+        putLE(index, modificationTime(st));
+        for (const auto& entry : offsets) {
+            putLE(index, static_cast<int32_t>(entry.id));
+            putLE(index, entry.length);
+            putLE(index, entry.offset);
+        }
+
+        std::string buffers[] = { std::move(index) };
+        TaskStorage::writeBuffers(TaskStorage::offsetIndexPath(dataFile), buffers);
+    }
+
+    /**
+     * @brief Find a task in a binary snapshot by binary search over hot records
+     */
+    std::optional<Task> findBinaryRecord(const std::filesystem::path& dataFile, int id) {
+        auto mapping = std::make_shared<const MappedSnapshot>(dataFile);
+        std::string_view data = mapping->bytes();
+        auto layout = TaskStorage::readBinaryLayout(data);
+        auto idAt = [&](size_t i) { return getLE<int32_t>(data, kBinaryHeaderSize + i * kHotRecordSize); };
+
+        // Point reads skip the O(n) hot checksum; the cold record carries its own
+        size_t low = 0, high = layout.taskCount;
+        if (getLE<uint64_t>(data, 56) & kIdsAscending) {
+            while (low < high) {
+                size_t mid = low + (high - low) / 2;
+                if (idAt(mid) < id) low = mid + 1;
+                else high = mid;
+            }
+            if (low < layout.taskCount && idAt(low) == id) {
+                return decodeHotRecord(mapping, layout.taskCount, layout.hotBytes, low);
+            }
+            return std::nullopt;
+        }
+
+        for (size_t i = 0; i < layout.taskCount; ++i) {
+            if (idAt(i) == id) return decodeHotRecord(mapping, layout.taskCount, layout.hotBytes, i);
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Find a task in a JSON snapshot through its offsets sidecar
+     * @return nullopt if the sidecar is missing or stale
+     */
+    std::optional<std::optional<Task>> findJsonRecord(const std::filesystem::path& dataFile, int id) {
+        auto indexFile = TaskStorage::offsetIndexPath(dataFile);
+        struct stat st {};
+        if (::stat(dataFile.c_str(), &st) != 0 || !std::filesystem::exists(indexFile)) {
+            return std::nullopt;
+        }
+
+        MappedFile index(indexFile, kOffsetsHeaderSize);
+        std::string_view data = index.bytes();
+        auto count = getLE<uint32_t>(data, 8);
+        if (!data.starts_with(kOffsetsMagic) || getLE<uint32_t>(data, 4) != kOffsetsVersion
+            || (data.size() - kOffsetsHeaderSize) / kOffsetEntrySize < count
+            || getLE<uint64_t>(data, 16) != static_cast<uint64_t>(st.st_size)
+            || getLE<int64_t>(data, 24) != modificationTime(st)) {
+            return std::nullopt; // Snapshot changed behind our back (or an older sidecar)
+        }
+
+        auto entryAt = [&](size_t i) { return kOffsetsHeaderSize + i * kOffsetEntrySize; };
+        size_t low = 0, high = count;
+        while (low < high) {
+            size_t mid = low + (high - low) / 2;
+            if (getLE<int32_t>(data, entryAt(mid)) < id) low = mid + 1;
+            else high = mid;
+        }
+        if (low == count || getLE<int32_t>(data, entryAt(low)) != id) {
+            return std::optional<Task>{};
+        }
+
+        auto length = getLE<uint32_t>(data, entryAt(low) + 4);
+        auto offset = getLE<uint64_t>(data, entryAt(low) + 8);
+        if (offset > static_cast<uint64_t>(st.st_size) || length > static_cast<uint64_t>(st.st_size) - offset) {
+            return std::nullopt;
+        }
+
+        std::string text(length, '\0');
+        std::ifstream file(dataFile, std::ios::binary);
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(text.data(), static_cast<std::streamsize>(length));
+        if (file.gcount() != static_cast<std::streamsize>(length)) {
+            return std::nullopt;
+        }
+        return std::optional<Task>{ TaskJson::parseTask(text) };
+    }
+
+    // ======================
+    // Archive Zone Maps
+    // ======================
+
+    constexpr size_t kBloomBitsPerKey = 10;  ///< ~1% false positives with three probes
+    constexpr uint64_t kBloomHashes = 3;     ///< Probes per key
+
+    // Trigrams are packed into 24-bit keys; a query can only match a segment containing all of its trigrams
+    void collectTrigrams(std::vector<uint32_t>& out, std::string_view lowered) {
+        for (size_t i = 0; i + 3 <= lowered.size(); ++i) {
+            out.push_back(static_cast<uint8_t>(lowered[i])
+                | static_cast<uint32_t>(static_cast<uint8_t>(lowered[i + 1])) << 8
+                | static_cast<uint32_t>(static_cast<uint8_t>(lowered[i + 2])) << 16);
+        }
+    }
+
+    // Double hashing: probe i is h1 + i * h2 over a power-of-two bit array
+    uint64_t bloomProbe(uint32_t key, uint64_t probe, uint64_t bitMask) noexcept {
+        uint64_t h = (key + 1) * 0x9E3779B97F4A7C15ULL;
+        h ^= h >> 29;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 32;
+        return (h + probe * ((h >> 17) | 1)) & bitMask;
+    }
+
+    TaskStorage::ArchiveZone summarizeSegment(std::span<const std::unique_ptr<Task>> tasks, uint64_t offset, uint64_t length) {
+        TaskStorage::ArchiveZone zone;
+        zone.offset = offset;
+        zone.length = length;
+        zone.count = static_cast<uint32_t>(tasks.size());
+        zone.minId = std::numeric_limits<int>::max();
+        zone.maxId = std::numeric_limits<int>::min();
+
+        std::vector<uint32_t> trigrams;
+        zone.ids.reserve(tasks.size());
+        for (const auto& task : tasks) {
+            zone.ids.push_back(task->getId());
+            zone.minId = std::min(zone.minId, task->getId());
+            zone.maxId = std::max(zone.maxId, task->getId());
+            ++zone.statusCounts[static_cast<int>(task->getStatus()) - 1];
+            ++zone.priorityCounts[static_cast<int>(task->getPriority()) - 1];
+
+            if (const auto& due = task->getDueDate()) {
+                zone.minDue = zone.minDue ? std::min(*zone.minDue, *due) : *due;
+                zone.maxDue = zone.maxDue ? std::max(*zone.maxDue, *due) : *due;
+                if (task->getStatus() != TaskStatus::COMPLETED) ++zone.openWithDue;
+            }
+
+            // Same fields and case folding as Task::matches
+            collectTrigrams(trigrams, Utils::toLowerCase(task->getName()));
+            collectTrigrams(trigrams, Utils::toLowerCase(task->getDescription()));
+            for (const auto& tag : task->getTags()) {
+                collectTrigrams(trigrams, Utils::toLowerCase(tag));
+            }
+        }
+
+        std::ranges::sort(zone.ids);
+        std::ranges::sort(trigrams);
+        auto [first, last] = std::ranges::unique(trigrams);
+        trigrams.erase(first, last);
+
+        size_t bits = std::bit_ceil(std::max<size_t>(64, trigrams.size() * kBloomBitsPerKey));
+        zone.bloom.assign(bits / 64, 0);
+        for (uint32_t key : trigrams) {
+            for (uint64_t probe = 0; probe < kBloomHashes; ++probe) {
+                uint64_t bit = bloomProbe(key, probe, bits - 1);
+                zone.bloom[bit >> 6] |= uint64_t{ 1 } << (bit & 63);
+            }
+        }
+        return zone;
+    }
+
+    // Zone records are framed as [u32 payload length][payload][u64 payload checksum]
+    void appendZone(std::string& out, const TaskStorage::ArchiveZone& zone) {
+        std::string payload;
+        putLE(payload, zone.offset);
+        putLE(payload, zone.length);
+        putLE(payload, zone.count);
+        putLE(payload, static_cast<int32_t>(zone.minId));
+        putLE(payload, static_cast<int32_t>(zone.maxId));
+        for (uint32_t n : zone.statusCounts) putLE(payload, n);
+        for (uint32_t n : zone.priorityCounts) putLE(payload, n);
+        putLE(payload, zone.openWithDue);
+        payload.push_back(static_cast<char>(zone.minDue ? 1 : 0));
+        putLE(payload, zone.minDue ? toTicks(*zone.minDue) : int64_t{ 0 });
+        putLE(payload, zone.maxDue ? toTicks(*zone.maxDue) : int64_t{ 0 });
+        for (int id : zone.ids) putLE(payload, static_cast<int32_t>(id));
+        putLE(payload, static_cast<uint32_t>(zone.bloom.size()));
+        for (uint64_t word : zone.bloom) putLE(payload, word);
+
+        putLE(out, static_cast<uint32_t>(payload.size()));
+        out += payload;
+        putLE(out, Utils::hash64(payload));
+    }
+
+    constexpr size_t kZoneFixedSize = 8 + 8 + 4 + 4 + 4 + 12 + 12 + 4 + 1 + 8 + 8; ///< Zone payload before the ID list
+
+    std::optional<TaskStorage::ArchiveZone> decodeZone(std::string_view payload) {
+        if (payload.size() < kZoneFixedSize) return std::nullopt;
+
+        TaskStorage::ArchiveZone zone;
+        size_t pos = 0;
+        auto next = [&]<typename T>(T& value) { value = getLE<T>(payload, pos); pos += sizeof(T); };
+
+        next(zone.offset);
+        next(zone.length);
+        next(zone.count);
+        int32_t id = 0;
+        next(id);
+        zone.minId = id;
+        next(id);
+        zone.maxId = id;
+        for (uint32_t& n : zone.statusCounts) next(n);
+        for (uint32_t& n : zone.priorityCounts) next(n);
+        next(zone.openWithDue);
+        bool hasDue = payload[pos++] != 0;
+        int64_t minDue = 0, maxDue = 0;
+        next(minDue);
+        next(maxDue);
+        if (hasDue) {
+            zone.minDue = fromTicks(minDue);
+            zone.maxDue = fromTicks(maxDue);
+        }
+
+        if ((payload.size() - pos) / 4 < uint64_t{ zone.count } + 1) return std::nullopt;
+        zone.ids.resize(zone.count);
+        for (int& value : zone.ids) {
+            next(id);
+            value = id;
+        }
+
+        uint32_t words = 0;
+        next(words);
+        if ((payload.size() - pos) / 8 != words || (words & (words - 1)) != 0) return std::nullopt;
+        zone.bloom.resize(words);
+        for (uint64_t& word : zone.bloom) next(word);
+        return zone;
+    }
+
+} // namespace
+
+namespace TaskStorage {
+
+    std::string_view formatName(SnapshotFormat format) noexcept {
+        switch (format) {
+        case SnapshotFormat::Json: return "json";
+        case SnapshotFormat::Compressed: return "compressed";
+        case SnapshotFormat::Binary: return "binary";
+        }
+        return "unknown";
+    }
+
+    std::optional<SnapshotFormat> parseFormat(std::string_view name) {
+        if (name == "json") return SnapshotFormat::Json;
+        if (name == "compressed") return SnapshotFormat::Compressed;
+        if (name == "binary") return SnapshotFormat::Binary;
+        return std::nullopt;
+    }
+
+    std::string readFile(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open data file for reading");
+        }
+
+        std::string contents(std::filesystem::file_size(path), '\0');
+        file.read(contents.data(), static_cast<std::streamsize>(contents.size()));
+        contents.resize(static_cast<size_t>(file.gcount()));
+        return contents;
+    }
+
+    std::string readSnapshotText(const std::filesystem::path& path, SnapshotFormat& detected) {
+        std::string contents = readFile(path);
+        if (BlockCodec::isContainer(contents)) {
+            detected = SnapshotFormat::Compressed;
+            return BlockCodec::decompress(contents);
+        }
+
+        detected = SnapshotFormat::Json;
+        return contents;
+    }
+
+    SnapshotFormat detectFormat(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        char magic[4] = {};
+        file.read(magic, sizeof(magic));
+        std::string_view signature{ magic, static_cast<size_t>(file.gcount()) };
+
+        if (signature == BINARY_MAGIC) return SnapshotFormat::Binary;
+        if (BlockCodec::isContainer(signature)) return SnapshotFormat::Compressed;
+        return SnapshotFormat::Json;
+    }
+
+    std::vector<std::unique_ptr<Task>> loadSnapshot(const std::filesystem::path& path, int& nextId, SnapshotFormat& detected) {
+        // Binary snapshots decode hot fields only; description and tags stay mapped until used
+        if (detectFormat(path) == SnapshotFormat::Binary) {
+            detected = SnapshotFormat::Binary;
+            return loadBinarySnapshot(path, nextId);
+        }
+
+        // Compressed snapshots are detected by signature and decoded in parallel
+        return TaskJson::parseSnapshot(readSnapshotText(path, detected), nextId);
+    }
+
+    // ======================
+    // Binary Snapshot
+    // ======================
+
+    std::vector<std::string> serializeBinarySnapshot(int nextId, std::span<const std::unique_ptr<Task>> tasks) {
+        const size_t count = tasks.size();
+        const size_t workers = Parallel::workerCount(count, 1024);
+
+        // Pass 1: each worker packs names and cold records for its chunk
+        struct Placement {
+            uint64_t name = 0;      ///< Name offset within the worker's heap
+            uint64_t cold = 0;      ///< Cold record offset within the worker's section
+            uint32_t coldSize = 0;  ///< Cold record length
+        };
+        std::vector<Placement> placements(count);
+        std::vector<std::string> names(workers);
+        std::vector<std::string> colds(workers);
+        std::vector<size_t> chunkStart(workers, count);
+
+        Parallel::forEachChunk(count, workers, [&](size_t worker, size_t begin, size_t end) {
+            chunkStart[worker] = begin;
+            for (size_t i = begin; i < end; ++i) {
+                placements[i].name = names[worker].size();
+                names[worker] += tasks[i]->getName();
+                placements[i].cold = colds[worker].size();
+                appendColdRecord(colds[worker], *tasks[i]);
+                placements[i].coldSize = static_cast<uint32_t>(colds[worker].size() - placements[i].cold);
+            }
+            });
+
+        // Section offsets are only known once every chunk's size is
+        const uint64_t namesOffset = kBinaryHeaderSize + count * kHotRecordSize;
+        std::vector<uint64_t> nameBase(workers), coldBase(workers);
+        uint64_t namesSize = 0, coldSize = 0;
+        for (size_t w = 0; w < workers; ++w) {
+            nameBase[w] = namesOffset + namesSize;
+            namesSize += names[w].size();
+        }
+        const uint64_t coldOffset = namesOffset + namesSize;
+        for (size_t w = 0; w < workers; ++w) {
+            coldBase[w] = coldOffset + coldSize;
+            coldSize += colds[w].size();
+        }
+
+        // Pass 2: fixed-size hot records with absolute offsets, then the name heap
+        std::string hot;
+        hot.reserve(static_cast<size_t>(coldOffset - kBinaryHeaderSize));
+        bool idsAscending = true;
+        size_t worker = 0;
+        for (size_t i = 0; i < count; ++i) {
+            while (worker + 1 < workers && i >= chunkStart[worker + 1]) ++worker;
+            const Task& task = *tasks[i];
+            const auto& due = task.getDueDate();
+            if (i > 0 && tasks[i - 1]->getId() >= task.getId()) idsAscending = false;
+
+            putLE(hot, static_cast<int32_t>(task.getId()));
+            hot.push_back(static_cast<char>(static_cast<int>(task.getStatus())));
+            hot.push_back(static_cast<char>(static_cast<int>(task.getPriority())));
+            putLE(hot, static_cast<uint16_t>(due ? kHasDueDate : 0));
+            putLE(hot, toTicks(task.getCreatedAt()));
+            putLE(hot, due ? toTicks(*due) : int64_t{ 0 });
+            putLE(hot, nameBase[worker] + placements[i].name);
+            putLE(hot, static_cast<uint32_t>(task.getName().size()));
+            putLE(hot, placements[i].coldSize);
+            putLE(hot, coldBase[worker] + placements[i].cold);
+        }
+        for (auto& chunk : names) {
+            hot += chunk;
+        }
+
+        std::string header{ BINARY_MAGIC };
+        putLE(header, BINARY_VERSION);
+        putLE(header, static_cast<int32_t>(nextId));
+        putLE(header, static_cast<uint32_t>(count));
+        putLE(header, namesOffset);
+        putLE(header, namesSize);
+        putLE(header, coldOffset);
+        putLE(header, coldSize);
+        putLE(header, Utils::hash64(hot));
+        putLE(header, idsAscending ? kIdsAscending : uint64_t{ 0 });
+
+        std::vector<std::string> buffers;
+        buffers.reserve(workers + 2);
+        buffers.push_back(std::move(header));
+        buffers.push_back(std::move(hot));
+        for (auto& chunk : colds) {
+            buffers.push_back(std::move(chunk));
+        }
+        return buffers;
+    }
+
+    BinaryLayout readBinaryLayout(std::string_view data) {
+        if (data.size() < kBinaryHeaderSize || !data.starts_with(BINARY_MAGIC)) {
+            throw corruptSnapshot("missing header");
+        }
+        if (getLE<uint32_t>(data, 4) != BINARY_VERSION) {
+            throw corruptSnapshot("unsupported version");
+        }
+
+        BinaryLayout layout;
+        layout.taskCount = getLE<uint32_t>(data, 12);
+        auto namesOffset = getLE<uint64_t>(data, 16);
+        auto namesSize = getLE<uint64_t>(data, 24);
+        auto coldOffset = getLE<uint64_t>(data, 32);
+        layout.coldBytes = getLE<uint64_t>(data, 40);
+        layout.hotBytes = coldOffset;
+
+        if (namesOffset != kBinaryHeaderSize + uint64_t{ layout.taskCount } * kHotRecordSize
+            || coldOffset != namesOffset + namesSize
+            || coldOffset > data.size() || layout.coldBytes != data.size() - coldOffset) {
+            throw corruptSnapshot("section sizes do not match file");
+        }
+        return layout;
+    }
+
+    std::vector<std::unique_ptr<Task>> loadBinarySnapshot(const std::filesystem::path& path, int& nextId) {
+        auto mapping = std::make_shared<const MappedSnapshot>(path);
+        std::string_view data = mapping->bytes();
+        BinaryLayout layout = readBinaryLayout(data);
+
+        // Only the hot section is checksummed and read here; cold pages are never touched
+        std::string_view hot = data.substr(kBinaryHeaderSize, layout.hotBytes - kBinaryHeaderSize);
+        if (Utils::hash64(hot) != getLE<uint64_t>(data, 48)) {
+            throw corruptSnapshot("hot section checksum mismatch");
+        }
+        nextId = getLE<int32_t>(data, 8);
+
+        std::vector<std::unique_ptr<Task>> tasks;
+        tasks.reserve(layout.taskCount);
+        for (size_t i = 0; i < layout.taskCount; ++i) {
+            tasks.push_back(std::make_unique<Task>(decodeHotRecord(mapping, layout.taskCount, layout.hotBytes, i)));
+        }
+        return tasks;
+    }
+
+    std::filesystem::path archivePath(const std::filesystem::path& dataFile) {
+        auto archive = dataFile;
+        archive.replace_filename(dataFile.stem().string() + ".archive.jsonl");
+        return archive;
+    }
+
+    bool ArchiveZone::mayContainText(std::string_view query) const {
+        std::string lowered = Utils::toLowerCase(query);
+        std::vector<uint32_t> trigrams;
+        collectTrigrams(trigrams, lowered);
+        if (trigrams.empty() || bloom.empty()) {
+            return true; // Queries shorter than a trigram cannot be ruled out
+        }
+
+        const uint64_t bitMask = bloom.size() * 64 - 1;
+        return std::ranges::all_of(trigrams, [&](uint32_t key) {
+            for (uint64_t probe = 0; probe < kBloomHashes; ++probe) {
+                uint64_t bit = bloomProbe(key, probe, bitMask);
+                if (!(bloom[bit >> 6] & (uint64_t{ 1 } << (bit & 63)))) return false;
+            }
+            return true;
+            });
+    }
+
+    bool ArchiveZone::containsId(int id) const noexcept {
+        return id >= minId && id <= maxId && std::ranges::binary_search(ids, id);
+    }
+
+    std::filesystem::path archiveZonesPath(const std::filesystem::path& archive) {
+        auto zones = archive;
+        zones.replace_extension(".zones");
+        return zones;
+    }
+
+    void appendArchive(const std::filesystem::path& path, std::span<const std::unique_ptr<Task>> tasks) {
+        const uint64_t base = std::filesystem::exists(path) ? std::filesystem::file_size(path) : 0;
+
+        std::string lines;
+        std::string zones;
+        for (size_t begin = 0; begin < tasks.size(); begin += ARCHIVE_SEGMENT_TASKS) {
+            auto segment = tasks.subspan(begin, std::min(ARCHIVE_SEGMENT_TASKS, tasks.size() - begin));
+            size_t start = lines.size();
+            for (const auto& task : segment) {
+                TaskJson::appendCompact(lines, *task);
+                lines += '\n';
+            }
+            appendZone(zones, summarizeSegment(segment, base + start, lines.size() - start));
+        }
+
+        // Archived tasks are removed from the hot file next, so they must be durable first.
+        // A crash before the zone maps land only leaves those bytes uncovered (always scanned).
+        appendDurably(path, lines, "archive");
+        appendDurably(archiveZonesPath(path), zones, "archive zone map");
+    }
+
+    std::vector<ArchiveZone> readArchiveZones(const std::filesystem::path& path) {
+        std::vector<ArchiveZone> zones;
+        auto zonesFile = archiveZonesPath(path);
+        if (!std::filesystem::exists(zonesFile) || !std::filesystem::exists(path)) {
+            return zones;
+        }
+
+        const uint64_t archiveSize = std::filesystem::file_size(path);
+        std::string data = readFile(zonesFile);
+        std::string_view view{ data };
+        uint64_t covered = 0;
+        size_t pos = 0;
+        while (view.size() - pos >= 4) {
+            auto length = getLE<uint32_t>(view, pos);
+            if (view.size() - pos - 4 < uint64_t{ length } + 8) break;
+
+            std::string_view payload = view.substr(pos + 4, length);
+            if (Utils::hash64(payload) != getLE<uint64_t>(view, pos + 4 + length)) break;
+
+            auto zone = decodeZone(payload);
+            if (!zone || zone->offset < covered || zone->length > archiveSize - std::min(zone->offset, archiveSize)
+                || zone->offset > archiveSize) {
+                break;
+            }
+
+            covered = zone->offset + zone->length;
+            zones.push_back(std::move(*zone));
+            pos += 4 + length + 8;
+        }
+        return zones;
+    }
+
+    size_t forEachArchivedTask(const std::filesystem::path& path, const std::function<void(Task&&)>& visit,
+        const std::function<bool(const ArchiveZone&)>& zoneFilter) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            return 0; // No archive yet
+        }
+
+        size_t count = 0;
+        size_t lineNumber = 0;
+        std::string line;
+
+        // Visit the lines in [begin, end); an empty end means "to end of file"
+        auto visitLines = [&](uint64_t begin, std::optional<uint64_t> end) {
+            file.clear();
+            file.seekg(static_cast<std::streamoff>(begin));
+            uint64_t position = begin;
+            while ((!end || position < *end) && std::getline(file, line)) {
+                position += line.size() + 1;
+                ++lineNumber;
+                if (line.empty()) continue;
+
+                std::optional<Task> task;
+                try {
+                    task.emplace(TaskJson::parseTask(line));
+                }
+                catch (const std::exception& e) {
+                    throw std::runtime_error(std::format("{}:{}: {}", path.string(), lineNumber, e.what()));
+                }
+
+                visit(std::move(*task));
+                ++count;
+            }
+            };
+
+        // Zone maps only matter when the caller can rule segments out
+        uint64_t covered = 0;
+        if (zoneFilter) {
+            for (const auto& zone : readArchiveZones(path)) {
+                if (zone.offset > covered) {
+                    visitLines(covered, zone.offset);
+                }
+                if (zoneFilter(zone)) {
+                    visitLines(zone.offset, zone.offset + zone.length);
+                }
+                else {
+                    lineNumber += zone.count;
+                }
+                covered = zone.offset + zone.length;
+            }
+        }
+        visitLines(covered, std::nullopt);
+
+        return count;
+    }
+
+    std::filesystem::path offsetIndexPath(const std::filesystem::path& dataFile) {
+        auto index = dataFile;
+        index.replace_filename(dataFile.stem().string() + ".offsets");
+        return index;
+    }
+
+    RecordLookup lookupSnapshotTask(const std::filesystem::path& dataFile, int id) {
+        RecordLookup lookup;
+        if (!std::filesystem::exists(dataFile)) {
+            lookup.indexed = true; // Empty store
+            return lookup;
+        }
+
+        switch (detectFormat(dataFile)) {
+        case SnapshotFormat::Binary:
+            lookup.indexed = true;
+            lookup.task = findBinaryRecord(dataFile, id);
+            break;
+        case SnapshotFormat::Json:
+            if (auto found = findJsonRecord(dataFile, id)) {
+                lookup.indexed = true;
+                lookup.task = std::move(*found);
+            }
+            break;
+        case SnapshotFormat::Compressed:
+            break; // Blocks split records arbitrarily; callers fall back to a full load
+        }
+        return lookup;
+    }
+
+    void appendDurably(const std::filesystem::path& path, std::string_view bytes, std::string_view what) {
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throw ioError(std::format("Could not open {}", what), path);
+        }
+
+        size_t written = 0;
+        while (written < bytes.size()) {
+            ssize_t n = ::write(fd, bytes.data() + written, bytes.size() - written);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                int saved = errno;
+                ::close(fd);
+                errno = saved;
+                throw ioError(std::format("Could not append to {}", what), path);
+            }
+            written += static_cast<size_t>(n);
+        }
+
+        if (::fsync(fd) != 0 || ::close(fd) != 0) {
+            throw ioError(std::format("Could not sync {}", what), path);
+        }
+    }
+
+    // ======================
+    // Sharding
+    // ======================
+
+    size_t ShardLayout::shardOf(int id) const noexcept {
+        if (files.size() <= 1 || id < 1) {
+            return 0;
+        }
+        if (scheme == Scheme::Hash) {
+            // Fibonacci hashing spreads consecutive IDs across shards
+            uint64_t mixed = static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ull;
+            return static_cast<size_t>((mixed >> 32) % files.size());
+        }
+        return std::min(static_cast<size_t>((id - 1) / std::max(rangeSize, 1)), files.size() - 1);
+    }
+
+    std::string_view schemeName(ShardLayout::Scheme scheme) noexcept {
+        return scheme == ShardLayout::Scheme::Hash ? "hash" : "range";
+    }
+
+    std::optional<ShardLayout::Scheme> parseScheme(std::string_view name) {
+        if (name == "range") return ShardLayout::Scheme::Range;
+        if (name == "hash") return ShardLayout::Scheme::Hash;
+        return std::nullopt;
+    }
+
+    std::filesystem::path shardManifestPath(const std::filesystem::path& dataFile) {
+        auto manifest = dataFile;
+        manifest.replace_filename(dataFile.stem().string() + ".shards.json");
+        return manifest;
+    }
+
+    bool storeExists(const std::filesystem::path& dataFile) {
+        // Same sibling names LsmStore uses for the log and its run manifest
+        auto sibling = [&dataFile](std::string_view suffix) {
+            auto path = dataFile;
+            path.replace_filename(dataFile.stem().string() + std::string{ suffix });
+            return path;
+            };
+        return std::filesystem::exists(dataFile) || std::filesystem::exists(shardManifestPath(dataFile)) ||
+            std::filesystem::exists(sibling(".journal")) || std::filesystem::exists(sibling(".lsm.json"));
+    }
+
+    std::optional<ShardLayout> readShardLayout(const std::filesystem::path& dataFile) {
+        auto manifestFile = shardManifestPath(dataFile);
+        if (!std::filesystem::exists(manifestFile)) {
+            return std::nullopt;
+        }
+
+        try {
+            auto j = nlohmann::json::parse(readFile(manifestFile));
+            ShardLayout layout;
+            auto scheme = parseScheme(j.at("scheme").get<std::string>());
+            if (!scheme) {
+                throw std::runtime_error("unknown scheme");
+            }
+            layout.scheme = *scheme;
+            layout.rangeSize = std::max(j.value("rangeSize", 1), 1);
+            layout.generation = j.value("generation", uint32_t{ 0 });
+            for (const auto& file : j.at("shards")) {
+                layout.files.push_back(manifestFile.parent_path() / file.get<std::string>());
+            }
+            if (layout.files.empty()) {
+                throw std::runtime_error("no shards");
+            }
+            return layout;
+        }
+        catch (const std::exception& e) {
+            throw std::runtime_error(std::format("Corrupt shard manifest {}: {}", manifestFile.string(), e.what()));
+        }
+    }
+
+    ShardLayout planShards(const std::filesystem::path& dataFile, ShardLayout::Scheme scheme, size_t count,
+        int rangeSize, uint32_t generation) {
+        ShardLayout layout;
+        layout.scheme = scheme;
+        layout.rangeSize = std::max(rangeSize, 1);
+        layout.generation = generation;
+        for (size_t i = 0; i < count; ++i) {
+            auto file = dataFile;
+            file.replace_filename(std::format("{}.shard-{}.{:03}{}", dataFile.stem().string(), generation, i,
+                dataFile.extension().string()));
+            layout.files.push_back(std::move(file));
+        }
+        return layout;
+    }
+
+    void writeShardLayout(const std::filesystem::path& dataFile, const ShardLayout& layout) {
+        nlohmann::json shards = nlohmann::json::array();
+        for (const auto& file : layout.files) {
+            shards.push_back(file.filename().string());
+        }
+
+        nlohmann::json j{
+            {"version", 1},
+            {"scheme", schemeName(layout.scheme)},
+            {"rangeSize", layout.rangeSize},
+            {"generation", layout.generation},
+            {"shards", shards}
+        };
+
+        std::string buffers[] = { j.dump(4) };
+        writeBuffers(shardManifestPath(dataFile), buffers);
+    }
+
+    std::vector<std::string> serializeSnapshot(int nextId, std::span<const std::unique_ptr<Task>> tasks,
+        std::vector<RecordOffset>* offsets) {
+        std::vector<std::string> buffers;
+        std::string header = "{\n    \"nextId\": ";
+        TextFormat::appendInt(header, nextId);
+        header += ",\n    \"tasks\": ";
+
+        if (tasks.empty()) {
+            buffers.push_back(std::move(header) + "[]\n}");
+            return buffers;
+        }
+
+        header += "[\n";
+        uint64_t position = header.size();
+        buffers.push_back(std::move(header));
+
+        // Task JSON construction dominates save time, so it is chunked across cores
+        const size_t workers = Parallel::workerCount(tasks.size(), 1024);
+        std::vector<std::string> chunks(workers);
+        std::vector<size_t> chunkStart(workers, tasks.size());
+        if (offsets) offsets->assign(tasks.size(), {});
+
+        Parallel::forEachChunk(tasks.size(), workers, [&](size_t worker, size_t begin, size_t end) {
+            std::string& out = chunks[worker];
+            chunkStart[worker] = begin;
+            for (size_t i = begin; i < end; ++i) {
+                if (i > 0) {
+                    out += ",\n"; // Separator belongs to the chunk that owns the following element
+                }
+                size_t start = out.size();
+                TaskJson::appendPretty(out, *tasks[i], kElementIndent);
+                if (offsets) {
+                    // Chunk-relative for now; rebased below once chunk sizes are known
+                    (*offsets)[i] = { tasks[i]->getId(), static_cast<uint32_t>(out.size() - start), start };
+                }
+            }
+            });
+
+        for (size_t w = 0; w < workers; ++w) {
+            if (offsets) {
+                size_t end = w + 1 < workers ? chunkStart[w + 1] : tasks.size();
+                for (size_t i = chunkStart[w]; i < end; ++i) (*offsets)[i].offset += position;
+            }
+            position += chunks[w].size();
+            buffers.push_back(std::move(chunks[w]));
+        }
+        buffers.emplace_back("\n    ]\n}");
+        return buffers;
+    }
+
+    void writeSnapshot(const std::filesystem::path& path, int nextId, std::span<const std::unique_ptr<Task>> tasks,
+        SnapshotFormat format) {
+        if (format != SnapshotFormat::Json) {
+            std::filesystem::remove(offsetIndexPath(path)); // Only JSON snapshots use the sidecar
+        }
+
+        if (format == SnapshotFormat::Binary) {
+            writeBuffers(path, serializeBinarySnapshot(nextId, tasks));
+            return;
+        }
+
+        std::vector<RecordOffset> offsets;
+        auto buffers = serializeSnapshot(nextId, tasks, format == SnapshotFormat::Json ? &offsets : nullptr);
+
+        if (format == SnapshotFormat::Json) {
+            writeBuffers(path, buffers);
+            writeOffsetIndex(path, std::move(offsets));
+            return;
+        }
+
+        // Blocks are fixed-size slices of the document, so join the chunks first
+        std::string raw;
+        size_t total = 0;
+        for (const auto& buffer : buffers) total += buffer.size();
+        raw.reserve(total);
+        for (const auto& buffer : buffers) raw += buffer;
+
+        writeBuffers(path, BlockCodec::compress(raw));
+    }
+
+    void removeSnapshot(const std::filesystem::path& path) {
+        std::filesystem::remove(path);
+        std::filesystem::remove(offsetIndexPath(path));
+    }
+
+    void writeBuffers(const std::filesystem::path& path, std::span<const std::string> buffers) {
+        // Lazily loaded tasks may still map the current file, so never truncate it in place
+        auto temporary = path;
+        temporary += ".tmp";
+
+        int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throw ioError("Could not open data file for writing:", temporary);
+        }
+
+        std::vector<iovec> iov;
+        iov.reserve(buffers.size());
+        for (const auto& buffer : buffers) {
+            if (!buffer.empty()) {
+                iov.push_back({ const_cast<char*>(buffer.data()), buffer.size() });
+            }
+        }
+
+        // writev may stop early (signals, pipe/disk limits); resume from where it left off
+        size_t next = 0;
+        while (next < iov.size()) {
+            int batch = static_cast<int>(std::min<size_t>(iov.size() - next, IOV_MAX));
+            ssize_t written = ::writev(fd, iov.data() + next, batch);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                int saved = errno;
+                ::close(fd);
+                errno = saved;
+                throw ioError("Could not write data file", temporary);
+            }
+
+            auto remaining = static_cast<size_t>(written);
+            while (next < iov.size() && remaining >= iov[next].iov_len) {
+                remaining -= iov[next].iov_len;
+                ++next;
+            }
+            if (remaining > 0) {
+                iov[next].iov_base = static_cast<char*>(iov[next].iov_base) + remaining;
+                iov[next].iov_len -= remaining;
+            }
+        }
+
+        // Contents must be on disk before the rename publishes them, and the rename before callers drop older copies
+        if (::fsync(fd) != 0) {
+            int saved = errno;
+            ::close(fd);
+            errno = saved;
+            throw ioError("Could not sync data file", temporary);
+        }
+        if (::close(fd) != 0) {
+            throw ioError("Could not close data file", temporary);
+        }
+        std::filesystem::rename(temporary, path);
+        syncDirectory(path);
+    }
+
+} // namespace TaskStorage
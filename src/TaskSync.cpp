@@ -0,0 +1,286 @@
+/**
+ * @file TaskSync.cpp
+ * @brief Ancestor tracking, change detection and field-level merging
+ */
+
+#include "TaskSync.hpp"
+#include "ContentIndex.hpp"
+#include "TaskStorage.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+    using Json = nlohmann::json;
+
+    /**
+     * @struct PeerState
+     * @brief What the last sync with one peer recorded
+     */
+    struct PeerState {
+        uint64_t generation = 0;    ///< Number of syncs so far
+        std::string base;           ///< Ancestor snapshot, relative to the local data file
+        uint64_t localSeq = 0;      ///< Local change feed position after the last sync
+        uint64_t remoteSeq = 0;     ///< Peer change feed position after the last sync
+    };
+
+    // Peers are identified by absolute path, so relative spellings of one file agree
+    std::string peerKey(const std::filesystem::path& file) {
+        return std::filesystem::weakly_canonical(std::filesystem::absolute(file)).string();
+    }
+
+    Json readState(const std::filesystem::path& path) {
+        if (!std::filesystem::exists(path)) {
+            return Json{ {"version", 1}, {"peers", Json::object()} };
+        }
+        try {
+            return Json::parse(TaskStorage::readFile(path));
+        }
+        catch (const std::exception& e) {
+            throw std::runtime_error(std::format("Corrupt sync state {}: {}", path.string(), e.what()));
+        }
+    }
+
+    // Latest change time per task and field, taken from change feed events after `since`
+    using FieldTimes = std::unordered_map<int, std::unordered_map<std::string, int64_t>>;
+
+    FieldTimes fieldTimes(const Tasks& tasks, uint64_t since, const std::unordered_set<int>& ids) {
+        FieldTimes times;
+        tasks.readChanges(since, [&](std::string_view line) {
+            auto event = Json::parse(line);
+            int id = event.at("id").get<int>();
+            if (!ids.contains(id)) return;
+
+            int64_t time = event.value("time", int64_t{ 0 });
+            const auto& fields = event.at("after").is_object() ? event.at("after") : event.at("before");
+            auto& latest = times[id];
+            for (const auto& [key, value] : fields.items()) {
+                latest[key] = std::max(latest[key], time);
+            }
+            });
+        return times;
+    }
+
+    // Completion time only makes sense together with the status it belongs to
+    std::string groupOf(const std::string& key) {
+        return key == "completed_at" ? "status" : key;
+    }
+
+    Json groupValue(const Json* task, const std::string& group) {
+        Json value = Json::object();
+        if (task) {
+            for (const auto& [key, field] : task->items()) {
+                if (groupOf(key) == group) value[key] = field;
+            }
+        }
+        return value;
+    }
+
+    int64_t groupTime(const FieldTimes& times, int id, const std::string& group) {
+        int64_t latest = 0;
+        if (auto task = times.find(id); task != times.end()) {
+            for (const auto& [key, time] : task->second) {
+                if (groupOf(key) == group) latest = std::max(latest, time);
+            }
+        }
+        return latest;
+    }
+
+    // Field-level three-way merge of a task both sides hold (base is null on a first sync)
+    Json mergeFields(int id, const Json* base, const Json& local, const Json& remote,
+        const FieldTimes& localTimes, const FieldTimes& remoteTimes, size_t& conflicts) {
+        std::set<std::string> groups;
+        for (const auto* task : { base, &local, &remote }) {
+            if (!task) continue;
+            for (const auto& [key, value] : task->items()) groups.insert(groupOf(key));
+        }
+
+        Json merged = Json::object();
+        for (const auto& group : groups) {
+            auto was = groupValue(base, group);
+            auto mine = groupValue(&local, group);
+            auto theirs = groupValue(&remote, group);
+
+            const Json* chosen = &mine;
+            if (mine == theirs || (base && theirs == was)) {
+                chosen = &mine;
+            }
+            else if (base && mine == was) {
+                chosen = &theirs;
+            }
+            else {
+                // Both changed it: last writer wins; equal times fall back to the greater value
+                ++conflicts;
+                auto mineTime = groupTime(localTimes, id, group);
+                auto theirTime = groupTime(remoteTimes, id, group);
+                bool takeTheirs = mineTime != theirTime ? theirTime > mineTime : theirs.dump() > mine.dump();
+                chosen = takeTheirs ? &theirs : &mine;
+            }
+            merged.update(*chosen);
+        }
+        return merged;
+    }
+
+} // namespace
+
+namespace TaskSync {
+
+    std::filesystem::path statePath(const std::filesystem::path& dataFile) {
+        auto state = dataFile;
+        state.replace_filename(dataFile.stem().string() + ".sync.json");
+        return state;
+    }
+
+    Report synchronize(Tasks& local, const std::filesystem::path& localFile,
+        Tasks& remote, const std::filesystem::path& remoteFile) {
+        Report report;
+        const auto stateFile = statePath(localFile);
+        const auto key = peerKey(remoteFile);
+        if (key == peerKey(localFile)) {
+            throw std::runtime_error("Cannot sync a data file with itself");
+        }
+
+        auto state = readState(stateFile);
+        auto& peers = state["peers"];
+        PeerState peer;
+        bool known = peers.contains(key);
+        if (known) {
+            const auto& entry = peers.at(key);
+            peer = { entry.value("generation", uint64_t{ 0 }), entry.value("base", std::string{}),
+                     entry.value("local_seq", uint64_t{ 0 }), entry.value("remote_seq", uint64_t{ 0 }) };
+        }
+
+        // The common ancestor: the merged state the previous sync left on both sides
+        auto baseFile = localFile;
+        baseFile.replace_filename(!peer.base.empty() ? peer.base
+            : std::format("{}.sync-{:016x}.base", localFile.stem().string(), Utils::hash64(key)));
+        std::vector<std::unique_ptr<Task>> baseTasks;
+        report.firstSync = !known || !std::filesystem::exists(baseFile);
+        if (!report.firstSync) {
+            int baseNextId = 1;
+            TaskStorage::SnapshotFormat format{};
+            baseTasks = TaskStorage::loadSnapshot(baseFile, baseNextId, format);
+        }
+
+        // Tasks whose content hash moved on either side since the ancestor
+        auto localIndex = local.contentIndex();
+        auto remoteIndex = remote.contentIndex();
+        std::vector<int> ids;
+        if (report.firstSync) {
+            auto comparison = ContentIndex::compare(localIndex, remoteIndex);
+            ids = std::move(comparison.ids);
+            report.rangesCompared = comparison.rangesCompared;
+        }
+        else {
+            std::vector<ContentIndex::Entry> entries;
+            entries.reserve(baseTasks.size());
+            for (const auto& task : baseTasks) {
+                entries.push_back({ task->getId(), task->contentHash() });
+            }
+            ContentIndex baseIndex(std::move(entries));
+            auto localChanges = ContentIndex::compare(baseIndex, localIndex);
+            auto remoteChanges = ContentIndex::compare(baseIndex, remoteIndex);
+            std::ranges::set_union(localChanges.ids, remoteChanges.ids, std::back_inserter(ids));
+            report.rangesCompared = localChanges.rangesCompared + remoteChanges.rangesCompared;
+        }
+        report.changed = ids.size();
+
+        auto localFound = local.findTasks(ids);
+        auto remoteFound = remote.findTasks(ids);
+        std::vector<const Task*> baseFound(ids.size(), nullptr);
+        {
+            std::unordered_map<int, size_t> wanted;
+            for (size_t i = 0; i < ids.size(); ++i) wanted.emplace(ids[i], i);
+            for (const auto& task : baseTasks) {
+                if (auto it = wanted.find(task->getId()); it != wanted.end()) baseFound[it->second] = task.get();
+            }
+        }
+
+        std::unordered_set<int> idSet(ids.begin(), ids.end());
+        auto localTimes = fieldTimes(local, peer.localSeq, idSet);
+        auto remoteTimes = fieldTimes(remote, peer.remoteSeq, idSet);
+
+        std::vector<Task> localPuts, remotePuts;
+        std::vector<int> localDeletes, remoteDeletes;
+        int nextFree = std::max(local.getNextId(), remote.getNextId());
+
+        for (size_t i = 0; i < ids.size(); ++i) {
+            int id = ids[i];
+            std::optional<Json> base, mine, theirs;
+            if (baseFound[i]) base = baseFound[i]->toJson();
+            if (localFound[i]) mine = localFound[i]->toJson();
+            if (remoteFound[i]) theirs = remoteFound[i]->toJson();
+
+            if (!mine && !theirs) {
+                continue; // Deleted on both sides
+            }
+
+            // Present on one side only: a deletion to propagate, or a task to copy
+            if (!mine || !theirs) {
+                const Json& present = mine ? *mine : *theirs;
+                if (base && present == *base) {
+                    (mine ? localDeletes : remoteDeletes).push_back(id);
+                }
+                else {
+                    if (base) ++report.conflicts; // Edited on one side, deleted on the other: the edit wins
+                    (mine ? remotePuts : localPuts).push_back(Task::fromJson(present));
+                }
+                continue;
+            }
+
+            if (*mine == *theirs) {
+                continue; // Same change made on both sides
+            }
+
+            // Both sides created this ID independently: keep ours, renumber theirs
+            if (!base && !report.firstSync) {
+                auto moved = *theirs;
+                moved["id"] = nextFree++;
+                localPuts.push_back(Task::fromJson(moved));
+                remotePuts.push_back(Task::fromJson(moved));
+                remotePuts.push_back(Task::fromJson(*mine));
+                ++report.remapped;
+                continue;
+            }
+
+            auto merged = mergeFields(id, base ? &*base : nullptr, *mine, *theirs, localTimes, remoteTimes, report.conflicts);
+            if (merged != *mine) localPuts.push_back(Task::fromJson(merged));
+            if (merged != *theirs) remotePuts.push_back(Task::fromJson(merged));
+        }
+
+        report.toLocal = localPuts.size();
+        report.toRemote = remotePuts.size();
+        report.deletedLocal = localDeletes.size();
+        report.deletedRemote = remoteDeletes.size();
+
+        // Only the tasks that differ are written, as one logged batch per store
+        for (auto [store, puts, deletes] : { std::tuple{ &local, &localPuts, &localDeletes }, std::tuple{ &remote, &remotePuts, &remoteDeletes } }) {
+            if (puts->empty() && deletes->empty()) continue;
+            auto result = store->applyBatch(std::move(*puts), *deletes);
+            if (!result.success) {
+                throw std::runtime_error(result.message);
+            }
+        }
+
+        // Both sides now agree; their shared state becomes the next ancestor
+        local.exportSnapshot(baseFile, TaskStorage::SnapshotFormat::Binary);
+        report.generation = peer.generation + 1;
+        peers[key] = {
+            {"generation", report.generation},
+            {"base", baseFile.filename().string()},
+            {"local_seq", local.lastChange()},
+            {"remote_seq", remote.lastChange()}
+        };
+        std::string buffers[] = { state.dump(4) };
+        TaskStorage::writeBuffers(stateFile, buffers);
+        return report;
+    }
+
+} // namespace TaskSync
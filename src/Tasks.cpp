@@ -1,16 +1,49 @@
 #include "Tasks.hpp"
 #include "TaskSearchIndex.hpp"
+#include "TaskStorage.hpp"
+#include "TaskFilters.hpp"
+#include "BlockCodec.hpp"
+#include "Parallel.hpp"
+#include "TextFormat.hpp"
 #include "utils.hpp"
-#include <fstream>
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
 #include <ranges>
+#include <chrono>
 #include <format>
+#include <iterator>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace {
+
+    // Map fused counters onto the statistics shown to the user
+    TaskStats statsFrom(const TaskFilters::TaskCounts& counts) noexcept {
+        TaskStats stats{};
+        stats.total = counts.total;
+        stats.todo = counts.status(TaskStatus::TODO);
+        stats.inProgress = counts.status(TaskStatus::IN_PROGRESS);
+        stats.completed = counts.status(TaskStatus::COMPLETED);
+        stats.lowPriority = counts.priority(TaskPriority::LOW);
+        stats.mediumPriority = counts.priority(TaskPriority::MEDIUM);
+        stats.highPriority = counts.priority(TaskPriority::HIGH);
+        stats.overdue = counts.overdue;
+        return stats;
+    }
+
+} // namespace
 
 // Constructor: Initialize task manager with data file path and load existing tasks
-Tasks::Tasks(std::filesystem::path dataFile) : nextId(1), dataFile(std::move(dataFile)) {
-    loadFromFile();
+Tasks::Tasks(std::filesystem::path dataFile, LoadMode mode)
+    : nextId(1), dataFile(std::move(dataFile)), context_(EvalContext::current()), layout_(TaskStorage::readShardLayout(this->dataFile)),
+    archiveFile(TaskStorage::archivePath(this->dataFile)), feed_(this->dataFile) {
+    openShards();
+    if (mode == LoadMode::Full) {
+        loadFromFile();
+    }
 }
 
 // Add a basic task with minimal information (name, status, priority)
@@ -18,14 +51,22 @@ TaskResult Tasks::addTask(std::string_view name, TaskStatus status, TaskPriority
     try {
         // Create new task with auto-incremented ID
         auto task = std::make_unique<Task>(nextId++, name, status, priority);
+
+        // Persist to the write-ahead log before it becomes visible
+        const Task* written[] = { task.get() };
+        shardFor(task->getId()).store.write(written);
+        auto added = task->toJson();
         tasks.push_back(std::move(task));
+        if (!order_dirty_) order_.insert(tasks.back().get());
+
+        if (auto event = ChangeFeed::diff(nullptr, &added)) {
+            publish({ &*event, 1 });
+        }
 
         // Mark cached data as outdated for lazy recomputation
         index_dirty_ = true; // Mark search index as dirty - Phase 2 optimization
         stats_dirty_ = true; // Mark statistics as dirty - Phase 2 optimization
 
-        // Persist changes to file immediately
-        saveToFile();
         return TaskResult::successResult("Task added successfully!");
     }
     catch (const std::exception& e) {
@@ -54,13 +95,20 @@ TaskResult Tasks::addTask(std::string_view name, std::string_view description,
             task->addTag(tag);
         }
 
+        const Task* written[] = { task.get() };
+        shardFor(task->getId()).store.write(written);
+        auto added = task->toJson();
         tasks.push_back(std::move(task));
+        if (!order_dirty_) order_.insert(tasks.back().get());
+
+        if (auto event = ChangeFeed::diff(nullptr, &added)) {
+            publish({ &*event, 1 });
+        }
 
         // Invalidate cached data for consistency
         index_dirty_ = true; // Mark search index as dirty - Phase 2 optimization
         stats_dirty_ = true; // Mark statistics as dirty - Phase 2 optimization
 
-        saveToFile();
         return TaskResult::successResult("Task added successfully!");
     }
     catch (const std::exception& e) {
@@ -77,13 +125,27 @@ TaskResult Tasks::removeTask(int id) {
         });
 
     if (it != tasks.end()) {
+        auto removed = (*it)->toJson();
+
+        // A tombstone hides the snapshot's copy until the next checkpoint
+        try {
+            const int deletes[] = { id };
+            shardFor(id).store.write({}, deletes);
+        }
+        catch (const std::exception& e) {
+            return TaskResult::errorResult(std::format("Failed to remove task: {}", e.what()));
+        }
         tasks.erase(it);
+        if (!order_dirty_) order_.erase(id);
 
         // Update cached data flags
         index_dirty_ = true; // Mark search index as dirty - Phase 2 optimization
         stats_dirty_ = true; // Mark statistics as dirty - Phase 2 optimization
 
-        saveToFile();
+        if (auto event = ChangeFeed::diff(&removed, nullptr)) {
+            publish({ &*event, 1 });
+        }
+
         return TaskResult::successResult("Task removed successfully!");
     }
 
@@ -98,13 +160,22 @@ TaskResult Tasks::removeAllTasks() {
 
     // Store count for user feedback before clearing
     size_t removedCount = tasks.size();
+    std::vector<ChangeFeed::Event> events;
+    events.reserve(removedCount);
+    for (const auto& task : tasks) {
+        auto removed = task->toJson();
+        events.push_back(*ChangeFeed::diff(&removed, nullptr));
+    }
     tasks.clear();
+    order_.clear();
+    order_dirty_ = false;
 
     // Invalidate all cached data
     index_dirty_ = true; // Mark search index as dirty
     stats_dirty_ = true; // Mark statistics as dirty
 
     saveToFile();
+    publish(events);
 
     return TaskResult::successResult(std::format("All {} tasks removed successfully!", removedCount));
 }
@@ -113,16 +184,27 @@ TaskResult Tasks::removeAllTasks() {
 TaskResult Tasks::updateTask(int id, std::string_view name, TaskStatus status, TaskPriority priority) {
     if (auto task = findTask(id)) {
         try {
-            // Update all modifiable fields
-            task->setName(name);
-            task->setStatus(status);
-            task->setPriority(priority);
+            auto before = task->toJson();
+
+            // Update all modifiable fields on a copy and log it first, so a failed write leaves memory untouched
+            Task updated = *task;
+            updated.setName(name);
+            updated.setStatus(status);
+            updated.setPriority(priority);
+
+            const Task* written[] = { &updated };
+            shardFor(id).store.write(written);
+            *task = std::move(updated);
+            if (!order_dirty_) order_.update(task);
 
             // Mark cached data as stale
             index_dirty_ = true; // Mark search index as dirty - Phase 2 optimization
             stats_dirty_ = true; // Mark statistics as dirty - Phase 2 optimization
 
-            saveToFile();
+            auto after = task->toJson();
+            if (auto event = ChangeFeed::diff(&before, &after)) {
+                publish({ &*event, 1 });
+            }
             return TaskResult::successResult("Task updated successfully!");
         }
         catch (const std::exception& e) {
@@ -133,6 +215,77 @@ TaskResult Tasks::updateTask(int id, std::string_view name, TaskStatus status, T
     return TaskResult::errorResult(std::format("Task with ID {} not found!", id));
 }
 
+// Store merged task states and deletions: one log write per shard, one feed append
+TaskResult Tasks::applyBatch(std::vector<Task> puts, std::span<const int> deletes) {
+    std::unordered_map<int, size_t> slots;
+    slots.reserve(tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        slots.emplace(tasks[i]->getId(), i);
+    }
+
+    std::vector<int> removed;
+    std::ranges::copy_if(deletes, std::back_inserter(removed), [&](int id) { return slots.contains(id); });
+
+    // Persist first, so memory never holds changes the store does not
+    try {
+        std::vector<std::vector<const Task*>> shardPuts(shards_.size());
+        std::vector<std::vector<int>> shardDeletes(shards_.size());
+        for (const auto& task : puts) {
+            shardPuts[layout_ ? layout_->shardOf(task.getId()) : 0].push_back(&task);
+        }
+        for (int id : removed) {
+            shardDeletes[layout_ ? layout_->shardOf(id) : 0].push_back(id);
+        }
+        for (size_t i = 0; i < shards_.size(); ++i) {
+            if (!shardPuts[i].empty() || !shardDeletes[i].empty()) {
+                shards_[i].store.write(shardPuts[i], shardDeletes[i]);
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        return TaskResult::errorResult(std::format("Failed to write tasks: {}", e.what()));
+    }
+
+    std::vector<ChangeFeed::Event> events;
+    for (int id : removed) {
+        auto& task = tasks[slots.at(id)];
+        auto before = task->toJson();
+        if (auto event = ChangeFeed::diff(&before, nullptr)) {
+            events.push_back(std::move(*event));
+        }
+        task.reset();
+        slots.erase(id);
+    }
+    for (auto& task : puts) {
+        int id = task.getId();
+        auto after = task.toJson();
+        nextId = std::max(nextId, id + 1);
+        if (auto slot = slots.find(id); slot != slots.end()) {
+            auto before = tasks[slot->second]->toJson();
+            if (auto event = ChangeFeed::diff(&before, &after)) {
+                events.push_back(std::move(*event));
+            }
+            *tasks[slot->second] = std::move(task);
+        }
+        else {
+            if (auto event = ChangeFeed::diff(nullptr, &after)) {
+                events.push_back(std::move(*event));
+            }
+            slots.emplace(id, tasks.size());
+            tasks.push_back(std::make_unique<Task>(std::move(task)));
+        }
+    }
+    std::erase_if(tasks, [](const auto& task) { return !task; });
+
+    index_dirty_ = true;
+    stats_dirty_ = true;
+    order_dirty_ = true;
+    std::ranges::sort(events, {}, &ChangeFeed::Event::id);
+    publish(events);
+
+    return TaskResult::successResult(std::format("{} task(s) written, {} removed", puts.size(), removed.size()));
+}
+
 // Find a task by ID (mutable version for modification)
 Task* Tasks::findTask(int id) noexcept {
     auto it = std::ranges::find_if(tasks, [id](const auto& task) {
@@ -142,8 +295,90 @@ Task* Tasks::findTask(int id) noexcept {
     return (it != tasks.end()) ? it->get() : nullptr;
 }
 
+// Bulk path: one snapshot rewrite per shard and one feed event, however many tasks arrive
+TaskResult Tasks::bulkLoad(std::vector<std::unique_ptr<Task>> imported, std::string_view source) {
+    if (imported.empty()) {
+        return TaskResult::successResult("No tasks to import");
+    }
+
+    const int first = imported.front()->getId();
+    const int last = imported.back()->getId();
+    const size_t count = imported.size();
+    if (first != nextId || last - first + 1 != static_cast<int>(count)) {
+        return TaskResult::errorResult(std::format("Imported IDs must run from #{} without gaps", nextId));
+    }
+
+    // Claim the IDs with the write: the snapshots record nextId
+    nextId = last + 1;
+    tasks.reserve(tasks.size() + count);
+    std::ranges::move(imported, std::back_inserter(tasks));
+    index_dirty_ = true;
+    stats_dirty_ = true;
+    order_dirty_ = true;
+
+    try {
+        writeShards();
+    }
+    catch (const std::exception& e) {
+        // Imported IDs start past every existing task, so they are easy to take back out
+        std::erase_if(tasks, [first](const auto& task) { return task->getId() >= first; });
+        nextId = first;
+        return TaskResult::errorResult(std::format("Failed to write imported tasks: {}", e.what()));
+    }
+
+    ChangeFeed::Event event{ "import", first, nullptr,
+        {{"first_id", first}, {"last_id", last}, {"count", count}, {"source", source}} };
+    publish({ &event, 1 });
+    return TaskResult::successResult(std::format("Imported {} task(s) (#{}-#{})", count, first, last));
+}
+
+// Batch lookup: one pass over the tasks instead of one scan per ID
+std::vector<const Task*> Tasks::findTasks(std::span<const int> ids) const {
+    std::unordered_map<int, size_t> wanted;
+    wanted.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        wanted.emplace(ids[i], i);
+    }
+
+    std::vector<const Task*> found(ids.size(), nullptr);
+    for (const auto& task : tasks) {
+        if (auto it = wanted.find(task->getId()); it != wanted.end()) {
+            found[it->second] = task.get();
+        }
+    }
+    return found;
+}
+
+// Find a task, reading just its record from disk when the container is deferred
+Task* Tasks::loadTask(int id) {
+    // Callers may modify the task and save(); keep its prior state so save() can report what changed
+    auto remember = [this](Task* task) {
+        if (task) originals_.try_emplace(task->getId(), task->toJson());
+        return task;
+        };
+
+    if (auto task = findTask(id); task || loaded_) {
+        return remember(task);
+    }
+
+    auto lookup = shardFor(id).store.lookup(id);
+    if (!lookup.indexed) {
+        // No offset table applies: drop any fetched records and load the whole store
+        tasks.clear();
+        loadFromFile();
+        return remember(findTask(id));
+    }
+    if (!lookup.task) {
+        return nullptr;
+    }
+
+    tasks.push_back(std::make_unique<Task>(std::move(*lookup.task)));
+    if (!order_dirty_) order_.insert(tasks.back().get());
+    return remember(tasks.back().get());
+}
+
 // Basic text search through all tasks - simple string matching
-std::vector<Task*> Tasks::searchTasks(std::string_view query) const {
+std::vector<Task*> Tasks::searchTasks(std::string_view query, bool includeArchive) const {
     std::vector<Task*> results;
     results.reserve(std::min(tasks.size(), size_t{ 100 })); // Reserve reasonable capacity - Phase 1 optimization
 
@@ -154,6 +389,13 @@ std::vector<Task*> Tasks::searchTasks(std::string_view query) const {
         }
     }
 
+    // Archived tasks are streamed and only matches are kept
+    if (includeArchive) {
+        auto archived = scanArchive([query](const Task& task) { return task.matches(query); },
+            [query](const TaskStorage::ArchiveZone& zone) { return zone.mayContainText(query); });
+        results.insert(results.end(), archived.begin(), archived.end());
+    }
+
     return results;
 }
 
@@ -204,9 +446,9 @@ std::vector<Task*> Tasks::getTasksByTag(std::string_view tag) const {
 std::vector<Task*> Tasks::getOverdueTasks() const {
     std::vector<Task*> results;
 
-    // Filter tasks where due date has passed current time
-    for (const auto& task : tasks | std::views::filter([](const auto& t) {
-        return t->isOverdue();
+    // Filter tasks whose due date has passed at the evaluation instant
+    for (const auto& task : tasks | std::views::filter([this](const auto& t) {
+        return t->isOverdue(context_);
         })) {
         results.push_back(task.get());
     }
@@ -214,6 +456,40 @@ std::vector<Task*> Tasks::getOverdueTasks() const {
     return results;
 }
 
+// Walk the display order, keeping the first matches that fit the window
+std::vector<Task*> Tasks::topTasks(const std::function<bool(const Task&)>& predicate, size_t limit, size_t& matched) const {
+    if (sort_order_) {
+        std::vector<Task*> results;
+        for (const auto& task : tasks) {
+            if (predicate(*task)) {
+                results.push_back(task.get());
+            }
+        }
+        matched = results.size();
+        TaskSort::sort(results, *sort_order_);
+        results.resize(std::min(limit, results.size()));
+        return results;
+    }
+
+    rebuildOrder();
+
+    std::vector<Task*> results;
+    results.reserve(std::min(limit, tasks.size()));
+    matched = 0;
+    order_.forEach([&](Task* task) {
+        if (predicate(*task) && ++matched <= limit) {
+            results.push_back(task);
+        }
+        return true;
+        });
+    return results;
+}
+
+std::optional<size_t> Tasks::positionOf(int id) const {
+    rebuildOrder();
+    return order_.position(id);
+}
+
 // Compute and cache task statistics for performance optimization
 TaskStats Tasks::getStatistics() const {
     // Lazy evaluation of statistics - return cached results if available
@@ -221,42 +497,514 @@ TaskStats Tasks::getStatistics() const {
         return *cached_stats_;
     }
 
-    TaskStats stats{};
+    // One fused pass: column blocks compared with SIMD, counted with popcounts
+    TaskStats stats = statsFrom(TaskFilters::countTasks(tasks, context_));
 
-    // Single-pass computation through all tasks for efficiency
+    // Cache the computed results for subsequent calls
+    cached_stats_ = stats;
+    stats_dirty_ = false;
+
+    return stats;
+}
+
+// Move old completed tasks out of the hot file into the append-only archive
+TaskResult Tasks::archiveCompletedTasks(std::chrono::days olderThan) {
+    auto cutoff = std::chrono::system_clock::now() - olderThan;
+    auto isCold = [cutoff](const std::unique_ptr<Task>& task) {
+        if (task->getStatus() != TaskStatus::COMPLETED) return false;
+        // Legacy records may lack a completion time; fall back to creation time
+        const auto& finished = task->getCompletedAt() ? *task->getCompletedAt() : task->getCreatedAt();
+        return finished < cutoff;
+        };
+
+    // Keep hot tasks in their original order and gather cold ones at the end
+    auto coldBegin = std::stable_partition(tasks.begin(), tasks.end(), [&](const auto& task) {
+        return !isCold(task);
+        });
+    size_t coldCount = static_cast<size_t>(tasks.end() - coldBegin);
+
+    if (coldCount == 0) {
+        return TaskResult::successResult("No completed tasks old enough to archive");
+    }
+
+    try {
+        TaskStorage::appendArchive(archiveFile, std::span<const std::unique_ptr<Task>>(tasks).last(coldCount));
+    }
+    catch (const std::exception& e) {
+        return TaskResult::errorResult(std::format("Failed to archive tasks: {}", e.what()));
+    }
+
+    // Archived tasks leave the hot set; the feed reports them with their last state
+    std::vector<ChangeFeed::Event> events;
+    events.reserve(coldCount);
+    for (auto it = coldBegin; it != tasks.end(); ++it) {
+        auto archived = (*it)->toJson();
+        auto event = *ChangeFeed::diff(&archived, nullptr);
+        event.type = "archive";
+        events.push_back(std::move(event));
+    }
+
+    tasks.erase(coldBegin, tasks.end());
+    index_dirty_ = true;
+    stats_dirty_ = true;
+    order_dirty_ = true;
+
+    saveToFile();
+    publish(events);
+    return TaskResult::successResult(std::format("Archived {} completed task(s) to {}", coldCount, archiveFile.string()));
+}
+
+// Stream archive records, materializing only the ones the caller wants
+std::vector<Task*> Tasks::scanArchive(const std::function<bool(const Task&)>& predicate,
+    const std::function<bool(const TaskStorage::ArchiveZone&)>& zoneFilter) const {
+    std::vector<Task*> results;
+    if (!std::filesystem::exists(archiveFile)) {
+        return results;
+    }
+
+    // A task present in both tiers (interrupted archive run) is owned by the hot file
+    std::unordered_set<int> hotIds;
+    hotIds.reserve(tasks.size());
+    for (const auto& task : tasks) {
+        hotIds.insert(task->getId());
+    }
+
+    TaskStorage::forEachArchivedTask(archiveFile, [&](Task&& task) {
+        if (hotIds.contains(task.getId()) || !predicate(task)) return;
+        archived_.push_back(std::make_unique<Task>(std::move(task)));
+        results.push_back(archived_.back().get());
+        }, zoneFilter);
+
+    return results;
+}
+
+// Archive statistics are counted while streaming; nothing is kept in memory
+TaskStats Tasks::getArchiveStatistics() const {
+    if (!std::filesystem::exists(archiveFile)) {
+        return TaskStats{};
+    }
+
+    std::unordered_set<int> hotIds;
+    std::vector<int> sortedHotIds;
+    hotIds.reserve(tasks.size());
+    sortedHotIds.reserve(tasks.size());
     for (const auto& task : tasks) {
-        ++stats.total;
+        hotIds.insert(task->getId());
+        sortedHotIds.push_back(task->getId());
+    }
+    std::ranges::sort(sortedHotIds);
 
-        // Count tasks by status
-        switch (task->getStatus()) {
-        case TaskStatus::TODO: ++stats.todo; break;
-        case TaskStatus::IN_PROGRESS: ++stats.inProgress; break;
-        case TaskStatus::COMPLETED: ++stats.completed; break;
+    const auto now = context_.now;
+    TaskFilters::TaskCounts counts;
+    TaskStorage::forEachArchivedTask(archiveFile, [&](Task&& task) {
+        if (!hotIds.contains(task.getId())) {
+            counts.add(task, context_);
         }
+        }, [&](const TaskStorage::ArchiveZone& zone) {
+            // Zone counters are exact unless a task is shadowed by the hot set or may be overdue now
+            auto first = std::ranges::lower_bound(sortedHotIds, zone.minId);
+            auto last = std::ranges::upper_bound(sortedHotIds, zone.maxId);
+            bool shadowed = std::any_of(first, last, [&](int id) { return zone.containsId(id); });
+            bool mayBeOverdue = zone.openWithDue > 0 && zone.minDue && *zone.minDue < now;
+            if (shadowed || mayBeOverdue) {
+                return true;
+            }
+
+            counts.total += zone.count;
+            for (size_t i = 0; i < counts.by_status.size(); ++i) counts.by_status[i] += zone.statusCounts[i];
+            for (size_t i = 0; i < counts.by_priority.size(); ++i) counts.by_priority[i] += zone.priorityCounts[i];
+            return false;
+        });
+
+    return statsFrom(counts);
+}
 
-        // Count tasks by priority
-        switch (task->getPriority()) {
-        case TaskPriority::LOW: ++stats.lowPriority; break;
-        case TaskPriority::MEDIUM: ++stats.mediumPriority; break;
-        case TaskPriority::HIGH: ++stats.highPriority; break;
+// Simple wrapper for file saving
+void Tasks::save() {
+    if (loaded_) {
+        saveToFile();
+    }
+    else {
+        // Deferred containers only hold the records they fetched; log those in their shards instead of rewriting snapshots
+        try {
+            std::vector<std::vector<const Task*>> changed(shards_.size());
+            for (const auto& task : tasks) {
+                changed[layout_ ? layout_->shardOf(task->getId()) : 0].push_back(task.get());
+            }
+            for (size_t i = 0; i < shards_.size(); ++i) {
+                shards_[i].store.write(changed[i]);
+            }
+        }
+        catch (const std::exception& e) {
+            std::cout << Utils::RED << "Error saving data: " << e.what() << Utils::RESET << std::endl;
+            return;
         }
+    }
 
-        // Count overdue tasks
-        if (task->isOverdue()) {
-            ++stats.overdue;
+    // Report what changed in the tasks handed out since the last save
+    std::vector<ChangeFeed::Event> events;
+    for (const auto& [id, before] : originals_) {
+        Task* task = findTask(id);
+        // Handed-out tasks may have been re-prioritized or re-dated in place
+        if (!order_dirty_ && task) {
+            order_.update(task);
+        }
+        else if (!order_dirty_) {
+            order_.erase(id);
+        }
+        auto after = task ? task->toJson() : nlohmann::json{};
+        if (auto event = ChangeFeed::diff(&before, task ? &after : nullptr)) {
+            events.push_back(std::move(*event));
         }
     }
+    originals_.clear();
+    std::ranges::sort(events, {}, &ChangeFeed::Event::id);
+    publish(events);
+}
 
-    // Cache the computed results for subsequent calls
-    cached_stats_ = stats;
-    stats_dirty_ = false;
+// Append events to the change feed; the store itself is already durable, so failures only warn
+void Tasks::publish(std::span<const ChangeFeed::Event> events) {
+    try {
+        feed_.append(events);
+    }
+    catch (const std::exception& e) {
+        std::cout << Utils::YELLOW << "Warning: change feed not updated: " << e.what() << Utils::RESET << std::endl;
+    }
+}
 
-    return stats;
+uint64_t Tasks::readChanges(uint64_t since, const std::function<void(std::string_view)>& visit) const {
+    return feed_.readSince(since, visit);
 }
 
-// Simple wrapper for file saving
-void Tasks::save() const {
-    saveToFile();
+// Tasks are hashed in parallel chunks; each worker touches only its own tasks' caches
+ContentIndex Tasks::contentIndex() const {
+    std::vector<ContentIndex::Entry> entries(tasks.size());
+    Parallel::forEachChunk(tasks.size(), Parallel::workerCount(tasks.size(), 4096), [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            entries[i] = { tasks[i]->getId(), tasks[i]->contentHash() };
+        }
+        });
+    return ContentIndex(std::move(entries));
+}
+
+uint64_t Tasks::lastChange() const {
+    return feed_.lastSequence();
+}
+
+// Apply feed events to memory: adds carry the whole task, other events only the fields that changed
+std::optional<size_t> Tasks::applyChanges(uint64_t& since) {
+    std::vector<nlohmann::json> events;
+    uint64_t last = since;
+    try {
+        last = feed_.readSince(since, [&](std::string_view line) {
+            events.push_back(nlohmann::json::parse(line));
+            });
+        if (events.empty()) {
+            return 0;
+        }
+
+        std::unordered_map<int, size_t> slots;
+        slots.reserve(tasks.size() + events.size());
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            slots.emplace(tasks[i]->getId(), i);
+        }
+
+        // Check the whole batch first: a batch that needs a reload must leave memory untouched
+        std::unordered_map<int, bool> present;  // IDs the batch adds or removes -> live afterwards
+        for (const auto& event : events) {
+            const auto& type = event.at("type").get_ref<const std::string&>();
+            int id = event.at("id").get<int>();
+            if (type == "import") {
+                return std::nullopt; // Bulk loads are summarized, not replayable task by task
+            }
+            if (type == "add") {
+                present[id] = true;
+                continue;
+            }
+            auto known = present.find(id);
+            if (!(known != present.end() ? known->second : slots.contains(id))) {
+                return std::nullopt; // Memory is missing a task the feed knows about
+            }
+            if (type == "remove" || type == "archive") {
+                present[id] = false;
+            }
+        }
+
+        for (const auto& event : events) {
+            const auto& type = event.at("type").get_ref<const std::string&>();
+            int id = event.at("id").get<int>();
+            auto slot = slots.find(id);
+
+            if (type == "add") {
+                auto task = std::make_unique<Task>(Task::fromJson(event.at("after")));
+                Task* added = task.get();
+                if (slot != slots.end()) {
+                    tasks[slot->second] = std::move(task);
+                }
+                else {
+                    slots.emplace(id, tasks.size());
+                    tasks.push_back(std::move(task));
+                }
+                // update() finds the replaced task by ID and its stored key, so the old node goes too
+                if (!order_dirty_) order_.update(added);
+                nextId = std::max(nextId, id + 1);
+                continue;
+            }
+
+            if (type == "remove" || type == "archive") {
+                if (!order_dirty_) order_.erase(id);
+                tasks[slot->second].reset();
+                slots.erase(slot);
+                continue;
+            }
+
+            // Patch the changed fields; a null value means the field was dropped
+            auto json = tasks[slot->second]->toJson();
+            for (const auto& [key, value] : event.at("after").items()) {
+                if (value.is_null()) {
+                    json.erase(key);
+                }
+                else {
+                    json[key] = value;
+                }
+            }
+            *tasks[slot->second] = Task::fromJson(json);
+            if (!order_dirty_) order_.update(tasks[slot->second].get());
+        }
+    }
+    catch (const std::exception&) {
+        // A malformed event can stop the batch part way: drop removed slots so reload() sees only live tasks
+        std::erase_if(tasks, [](const auto& task) { return !task; });
+        order_dirty_ = true;
+        index_dirty_ = true;
+        stats_dirty_ = true;
+        return std::nullopt;
+    }
+
+    // The display order was kept current event by event; only imports and reloads rebuild it
+    std::erase_if(tasks, [](const auto& task) { return !task; });
+    index_dirty_ = true;
+    stats_dirty_ = true;
+    since = last;
+    return events.size();
+}
+
+// Reload from scratch, then count differences by ID and content hash
+size_t Tasks::reload(uint64_t& since) {
+    std::unordered_map<int, uint64_t> before;
+    before.reserve(tasks.size());
+    for (const auto& task : tasks) {
+        before.emplace(task->getId(), task->contentHash());
+    }
+
+    // Read the feed position first: events racing with the load are then applied again, which is harmless
+    feed_ = ChangeFeed(dataFile);
+    since = feed_.lastSequence();
+
+    tasks.clear();
+    archived_.clear();
+    originals_.clear();
+    nextId = 1;
+    load_failed_ = false;
+    replay_report_ = {};
+    layout_ = TaskStorage::readShardLayout(dataFile);
+    openShards();
+    loadFromFile();
+    index_dirty_ = true;
+    stats_dirty_ = true;
+    order_dirty_ = true;
+
+    size_t changed = 0;
+    for (const auto& task : tasks) {
+        auto it = before.find(task->getId());
+        if (it == before.end()) {
+            ++changed;
+            continue;
+        }
+        if (it->second != task->contentHash()) {
+            ++changed;
+        }
+        before.erase(it);
+    }
+    return changed + before.size();
+}
+
+// Major compaction: rewrite the snapshot so runs, the log and their tombstones can be dropped
+TaskResult Tasks::compact() {
+    size_t runs = 0;
+    size_t logged = 0;
+    size_t touched = 0;
+    for (const auto& shard : shards_) {
+        runs += shard.store.runs().size();
+        logged += shard.store.memtableSize();
+        touched += shard.store.empty() ? 0 : 1;
+    }
+    if (touched == 0) {
+        return TaskResult::successResult("Nothing to compact: the snapshot already holds every change");
+    }
+
+    // Shards without pending changes are already up to date and are left alone
+    try {
+        writeShards([this](size_t i) { return !shards_[i].store.empty(); });
+    }
+    catch (const std::exception& e) {
+        return TaskResult::errorResult(std::format("Failed to compact: {}", e.what()));
+    }
+
+    LsmStore::Stats stats;
+    for (const auto& shard : shards_) {
+        stats += shard.store.stats();
+    }
+    return TaskResult::successResult(std::format("Folded {} run(s) and {} logged change(s) into {} snapshot(s) (write amplification {:.2f}x)",
+        runs, logged, touched, stats.writeAmplification()));
+}
+
+void Tasks::setCheckpointPolicy(const LsmStore::CheckpointPolicy& policy) noexcept {
+    checkpoint_policy_ = policy;
+}
+
+void Tasks::setEvalContext(const EvalContext& context) noexcept {
+    context_ = context;
+    stats_dirty_ = true;
+}
+
+const EvalContext& Tasks::getEvalContext() const noexcept {
+    return context_;
+}
+
+void Tasks::setSortOrder(std::optional<TaskSort::Order> order) {
+    sort_order_ = std::move(order);
+}
+
+const LsmStore::ReplayReport& Tasks::getReplayReport() const noexcept {
+    return replay_report_;
+}
+
+// Bound the next startup's replay by checkpointing shards whose backlog crossed a limit
+std::optional<TaskResult> Tasks::checkpointIfNeeded() {
+    // Estimate replay time from this run's own measurement once it covers enough data
+    double bytesPerSecond = LsmStore::DEFAULT_REPLAY_BYTES_PER_SECOND;
+    if (replay_report_.bytes >= (1u << 20) && replay_report_.seconds > 0) {
+        bytesPerSecond = static_cast<double>(replay_report_.bytes) / replay_report_.seconds;
+    }
+
+    std::vector<bool> due(shards_.size(), false);
+    std::vector<std::string> reasons;
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        if (auto reason = shards_[i].store.checkpointReason(checkpoint_policy_, bytesPerSecond)) {
+            due[i] = true;
+            reasons.push_back(shards_.size() > 1 ? std::format("shard {}: {}", i, *reason) : *reason);
+        }
+    }
+    if (reasons.empty()) {
+        return std::nullopt;
+    }
+
+    if (!loaded_) {
+        // Fetched records were already logged by save(); reload everything from the tiers
+        tasks.clear();
+        loadFromFile();
+    }
+    if (load_failed_) {
+        return TaskResult::errorResult("Checkpoint skipped: the store did not load cleanly");
+    }
+
+    try {
+        writeShards([&due](size_t i) { return due[i]; });
+    }
+    catch (const std::exception& e) {
+        return TaskResult::errorResult(std::format("Checkpoint failed: {}", e.what()));
+    }
+
+    std::string joined;
+    for (const auto& reason : reasons) {
+        joined += joined.empty() ? reason : "; " + reason;
+    }
+    return TaskResult::successResult(std::format("Checkpointed {} snapshot(s): {}", reasons.size(), joined));
+}
+
+// Move every task into a new set of shard files, then retire the old ones
+TaskResult Tasks::reshard(size_t count, TaskStorage::ShardLayout::Scheme scheme) {
+    if (count == 0) {
+        return TaskResult::errorResult("Shard count must be at least 1");
+    }
+    if (count == 1 && !layout_) {
+        return TaskResult::successResult("Data file is already unsharded");
+    }
+
+    auto oldShards = std::move(shards_);
+    uint32_t generation = layout_ ? layout_->generation + 1 : 1;
+    if (count > 1) {
+        // Ranges split the IDs issued so far evenly; new IDs land in the last shard
+        int rangeSize = static_cast<int>((std::max(nextId - 1, 1) + count - 1) / count);
+        layout_ = TaskStorage::planShards(dataFile, scheme, count, rangeSize, generation);
+    }
+    else {
+        layout_.reset();
+    }
+    openShards();
+
+    try {
+        // Leftovers from an interrupted reshard must not be replayed over the new snapshots
+        for (auto& shard : shards_) {
+            shard.store.discard();
+        }
+        writeShards();
+
+        if (layout_) {
+            TaskStorage::writeShardLayout(dataFile, *layout_);
+        }
+        else {
+            std::filesystem::remove(TaskStorage::shardManifestPath(dataFile));
+        }
+    }
+    catch (const std::exception& e) {
+        return TaskResult::errorResult(std::format("Failed to reshard: {}", e.what()));
+    }
+
+    // The new layout is live; the old files are now unreachable
+    for (auto& shard : oldShards) {
+        shard.store.discard();
+        TaskStorage::removeSnapshot(shard.file);
+    }
+
+    if (!layout_) {
+        return TaskResult::successResult(std::format("Merged {} task(s) back into {}", tasks.size(), dataFile.string()));
+    }
+    return TaskResult::successResult(std::format("Split {} task(s) across {} shard(s) by {}", tasks.size(), count,
+        TaskStorage::schemeName(scheme)));
+}
+
+// Switch the on-disk encoding and rewrite the data file immediately
+TaskResult Tasks::setSnapshotFormat(TaskStorage::SnapshotFormat format) {
+    if (format == snapshot_format_) {
+        return TaskResult::successResult(std::format("Data file is already stored as {}", TaskStorage::formatName(format)));
+    }
+
+    const auto previous = std::exchange(snapshot_format_, format);
+    try {
+        writeShards();
+    }
+    catch (const std::exception& e) {
+        snapshot_format_ = previous;
+        return TaskResult::errorResult(std::format("Failed to convert data file: {}", e.what()));
+    }
+    return TaskResult::successResult(std::format("Data file converted to {}", TaskStorage::formatName(format)));
+}
+
+// A standalone copy: no shard manifest, change tiers or feed are written for it
+void Tasks::exportSnapshot(const std::filesystem::path& path, TaskStorage::SnapshotFormat format) const {
+    TaskStorage::writeSnapshot(path, nextId, tasks, format);
+}
+
+void Tasks::forEachTask(const std::function<void(const Task&)>& visit) const {
+    for (const auto& task : tasks) {
+        visit(*task);
+    }
+}
+
+TaskStorage::SnapshotFormat Tasks::getSnapshotFormat() const noexcept {
+    return snapshot_format_;
 }
 
 // Display all tasks in a formatted table
@@ -291,9 +1039,14 @@ void Tasks::showAllTasks() const {
 }
 
 // Display detailed information for a specific task
-void Tasks::showTaskDetails(int id) const {
-    if (auto task = findTask(id)) {
-        std::cout << task->toDetailedString() << std::endl;
+void Tasks::showTaskDetails(int id) {
+    if (auto task = loadTask(id)) {
+        std::cout << task->toDetailedString(context_) << std::endl;
+    }
+    else if (auto archived = scanArchive([id](const Task& t) { return t.getId() == id; },
+        [id](const TaskStorage::ArchiveZone& zone) { return zone.containsId(id); }); !archived.empty()) {
+        std::cout << archived.front()->toDetailedString(context_);
+        std::cout << Utils::DIM << "(archived)" << Utils::RESET << std::endl;
     }
     else {
         std::cout << Utils::RED << "Task with ID " << id << " not found!" << Utils::RESET << std::endl;
@@ -304,6 +1057,12 @@ void Tasks::showTaskDetails(int id) const {
 void Tasks::showFilteredTasks(TaskStatus status) const {
     auto filteredTasks = getTasksByStatus(status);
 
+    // Completed listings also cover the cold archive, read lazily
+    if (status == TaskStatus::COMPLETED) {
+        auto archived = scanArchive([](const Task&) { return true; });
+        filteredTasks.insert(filteredTasks.end(), archived.begin(), archived.end());
+    }
+
     if (filteredTasks.empty()) {
         // Create a temporary task just to get the status string
         Task temp(0, "temp", status, TaskPriority::LOW);
@@ -312,6 +1071,10 @@ void Tasks::showFilteredTasks(TaskStatus status) const {
         return;
     }
 
+    if (sort_order_) {
+        TaskSort::sort(filteredTasks, *sort_order_);
+    }
+
     // Create a temporary task just to get the status string
     Task temp(0, "temp", status, TaskPriority::LOW);
     displayTaskList(filteredTasks, std::format("Tasks with status: {}", temp.getStatusString()));
@@ -328,6 +1091,10 @@ void Tasks::showFilteredTasks(TaskPriority priority) const {
         return;
     }
 
+    if (sort_order_) {
+        TaskSort::sort(filteredTasks, *sort_order_);
+    }
+
     // Create a temporary task just to get the priority string
     Task temp(0, "temp", TaskStatus::TODO, priority);
     displayTaskList(filteredTasks, std::format("Tasks with priority: {}", temp.getPriorityString()));
@@ -342,12 +1109,22 @@ void Tasks::showOverdueTasks() const {
         return;
     }
 
+    if (sort_order_) {
+        TaskSort::sort(overdueTasks, *sort_order_);
+    }
+
     displayTaskList(overdueTasks, "Overdue Tasks");
 }
 
 // Display task statistics in a formatted table
-void Tasks::showStatistics() const {
+void Tasks::showStatistics(bool includeArchive) const {
     auto stats = getStatistics();
+    size_t archivedCount = 0;
+    if (includeArchive) {
+        auto archiveStats = getArchiveStatistics();
+        archivedCount = archiveStats.total;
+        stats += archiveStats;
+    }
 
     std::cout << Utils::BOLD << "[STATS] Task Statistics" << Utils::RESET << std::endl;
     std::cout << "==================" << std::endl;
@@ -373,21 +1150,21 @@ void Tasks::showStatistics() const {
     // Data rows
     // Row 1: To-Do | High priority  
     std::cout << "| To-Do: " << Utils::RED << stats.todo << Utils::RESET;
-    std::cout << std::string(leftColWidth - 8 - std::to_string(stats.todo).length(), ' ') << "|";
+    std::cout << std::string(leftColWidth - 8 - TextFormat::digitCount(stats.todo), ' ') << "|";
     std::cout << " High: " << Utils::RED << stats.highPriority << Utils::RESET;
-    std::cout << std::string(rightColWidth - 7 - std::to_string(stats.highPriority).length(), ' ') << "|" << std::endl;
+    std::cout << std::string(rightColWidth - 7 - TextFormat::digitCount(stats.highPriority), ' ') << "|" << std::endl;
 
     // Row 2: In Progress | Medium priority
     std::cout << "| In Progress: " << Utils::YELLOW << stats.inProgress << Utils::RESET;
-    std::cout << std::string(leftColWidth - 14 - std::to_string(stats.inProgress).length(), ' ') << "|";
+    std::cout << std::string(leftColWidth - 14 - TextFormat::digitCount(stats.inProgress), ' ') << "|";
     std::cout << " Medium: " << Utils::YELLOW << stats.mediumPriority << Utils::RESET;
-    std::cout << std::string(rightColWidth - 9 - std::to_string(stats.mediumPriority).length(), ' ') << "|" << std::endl;
+    std::cout << std::string(rightColWidth - 9 - TextFormat::digitCount(stats.mediumPriority), ' ') << "|" << std::endl;
 
     // Row 3: Completed | Low priority
     std::cout << "| Completed: " << Utils::GREEN << stats.completed << Utils::RESET;
-    std::cout << std::string(leftColWidth - 12 - std::to_string(stats.completed).length(), ' ') << "|";
+    std::cout << std::string(leftColWidth - 12 - TextFormat::digitCount(stats.completed), ' ') << "|";
     std::cout << " Low: " << Utils::BLUE << stats.lowPriority << Utils::RESET;
-    std::cout << std::string(rightColWidth - 6 - std::to_string(stats.lowPriority).length(), ' ') << "|" << std::endl;
+    std::cout << std::string(rightColWidth - 6 - TextFormat::digitCount(stats.lowPriority), ' ') << "|" << std::endl;
 
     // Table footer
     std::cout << "+" << std::string(leftColWidth, '-');
@@ -396,6 +1173,9 @@ void Tasks::showStatistics() const {
     // Total tasks summary
     std::cout << std::endl;
     std::cout << Utils::CYAN << "📋 Total tasks: " << stats.total << Utils::RESET << std::endl;
+    if (includeArchive) {
+        std::cout << Utils::DIM << "🗄️  Including " << archivedCount << " archived task(s)" << Utils::RESET << std::endl;
+    }
 
     // Overdue tasks warning (if any)
     if (stats.overdue > 0) {
@@ -403,89 +1183,361 @@ void Tasks::showStatistics() const {
     }
 }
 
-// Load tasks from JSON file on disk
-void Tasks::loadFromFile() {
-    // Create directory structure if data file doesn't exist
-    if (!std::filesystem::exists(dataFile)) {
-        std::filesystem::create_directories(dataFile.parent_path());
+// Display grouped metrics as a table sized to its contents
+void Tasks::showReport(const std::vector<TaskReport::Dimension>& groupBy,
+    const std::vector<TaskReport::Metric>& metrics, bool includeArchive) const {
+    std::vector<const Task*> selected;
+    selected.reserve(tasks.size());
+    for (const auto& task : tasks) {
+        selected.push_back(task.get());
+    }
+    if (includeArchive) {
+        auto archived = scanArchive([](const Task&) { return true; });
+        selected.insert(selected.end(), archived.begin(), archived.end());
+    }
+
+    auto rows = TaskReport::aggregate(selected, groupBy, context_);
+    if (rows.empty()) {
+        std::cout << Utils::YELLOW << "No tasks found!" << Utils::RESET << std::endl;
         return;
     }
 
-    try {
-        std::ifstream file(dataFile);
-        if (!file.is_open()) {
-            throw std::runtime_error("Could not open data file for reading");
+    // Format every metric cell first so columns can be sized to fit
+    std::vector<std::vector<std::string>> cells(rows.size());
+    for (size_t r = 0; r < rows.size(); ++r) {
+        const auto& totals = rows[r].totals;
+        for (auto metric : metrics) {
+            std::string cell;
+            switch (metric) {
+            case TaskReport::Metric::Count: TextFormat::appendInt(cell, static_cast<long long>(totals.counts.total)); break;
+            case TaskReport::Metric::Overdue: TextFormat::appendInt(cell, static_cast<long long>(totals.counts.overdue)); break;
+            case TaskReport::Metric::Completed: TextFormat::appendInt(cell, static_cast<long long>(totals.counts.status(TaskStatus::COMPLETED))); break;
+            case TaskReport::Metric::AvgAge: cell = std::format("{:.1f}d", totals.averageAgeDays()); break;
+            }
+            cells[r].push_back(std::move(cell));
+        }
+    }
+
+    std::vector<size_t> widths;
+    for (auto dimension : groupBy) {
+        widths.push_back(TaskReport::dimensionName(dimension).size());
+    }
+    for (auto metric : metrics) {
+        widths.push_back(TaskReport::metricName(metric).size());
+    }
+    for (size_t r = 0; r < rows.size(); ++r) {
+        for (size_t d = 0; d < groupBy.size(); ++d) {
+            widths[d] = std::max(widths[d], rows[r].labels[d].size());
+        }
+        for (size_t m = 0; m < metrics.size(); ++m) {
+            widths[groupBy.size() + m] = std::max(widths[groupBy.size() + m], cells[r][m].size());
         }
+    }
+
+    std::string separator;
+    for (size_t width : widths) {
+        separator += "+-";
+        separator.append(width, '-');
+        separator += '-';
+    }
+    separator += '+';
+
+    std::string title = "[REPORT] Tasks by ";
+    for (size_t d = 0; d < groupBy.size(); ++d) {
+        if (d > 0) title += " x ";
+        title += TaskReport::dimensionName(groupBy[d]);
+    }
+    std::cout << Utils::BOLD << title << Utils::RESET << std::endl;
+    std::cout << std::endl;
+
+    std::string header = "| ";
+    header += Utils::BOLD;
+    for (size_t c = 0; c < widths.size(); ++c) {
+        if (c > 0) header += " | ";
+        auto name = c < groupBy.size() ? TaskReport::dimensionName(groupBy[c]) : TaskReport::metricName(metrics[c - groupBy.size()]);
+        TextFormat::appendPadded(header, name, widths[c]);
+    }
+    header += " |";
+    header += Utils::RESET;
+    std::cout << separator << '\n' << header << '\n' << separator << '\n';
+
+    // Build the body in one buffer: a grouped report can run to thousands of rows
+    std::string body;
+    for (size_t r = 0; r < rows.size(); ++r) {
+        body += "| ";
+        for (size_t d = 0; d < groupBy.size(); ++d) {
+            if (d > 0) body += " | ";
+            TextFormat::appendPadded(body, rows[r].labels[d], widths[d]);
+        }
+        for (size_t m = 0; m < metrics.size(); ++m) {
+            body += " | ";
+            TextFormat::appendPadded(body, cells[r][m], widths[groupBy.size() + m]);
+        }
+        body += " |\n";
+    }
+    std::cout << body << separator << std::endl;
+
+    std::cout << Utils::CYAN << "📊 Groups: " << rows.size() << " (tasks: " << selected.size() << ")" << Utils::RESET << std::endl;
+    if (includeArchive) {
+        std::cout << Utils::DIM << "🗄️  Including archived tasks" << Utils::RESET << std::endl;
+    }
+}
 
-        nlohmann::json j;
-        file >> j;
+// Display on-disk format, compression ratio and decode throughput
+void Tasks::showStorageInfo() const {
+    std::cout << Utils::BOLD << "[STORAGE] Data File" << Utils::RESET << std::endl;
+    std::cout << "==================" << std::endl;
+    std::cout << "Path:        " << dataFile.string() << std::endl;
+    std::cout << "Format:      " << TaskStorage::formatName(snapshot_format_) << std::endl;
+
+    // Log-structured tiers: changes not yet folded into the snapshots, and lifetime I/O
+    size_t runCount = 0;
+    size_t logged = 0;
+    uint64_t runBytes = 0;
+    size_t runTombstones = 0;
+    LsmStore::Stats lsm;
+    for (const auto& shard : shards_) {
+        for (const auto& run : shard.store.runs()) {
+            runBytes += run.bytes;
+            runTombstones += run.tombstones;
+        }
+        runCount += shard.store.runs().size();
+        logged += shard.store.memtableSize();
+        lsm += shard.store.stats();
+    }
+    std::cout << "Memtable:    " << logged << " record(s) in the log (flush at " << LsmStore::MEMTABLE_LIMIT << " per shard)" << std::endl;
+    std::cout << "Runs:        " << runCount << " (" << runBytes << " bytes, " << runTombstones << " tombstone(s))" << std::endl;
+    std::cout << "Compaction:  " << lsm.flushes << " flush(es), " << lsm.compactions << " run merge(s), "
+        << lsm.checkpoints << " checkpoint(s), " << lsm.tombstonesDropped << " tombstone(s) dropped" << std::endl;
+    std::cout << "Write amp:   " << std::fixed << std::setprecision(2) << lsm.writeAmplification() << "x ("
+        << lsm.logicalBytes << " logical bytes -> " << lsm.walBytes << " log + " << lsm.flushBytes << " flush + "
+        << lsm.compactionBytes << " merge + " << lsm.checkpointBytes << " snapshot)" << std::endl;
+    std::cout << std::defaultfloat;
+
+    if (std::filesystem::exists(archiveFile)) {
+        auto zones = TaskStorage::readArchiveZones(archiveFile);
+        uint64_t covered = 0;
+        size_t archivedTasks = 0;
+        for (const auto& zone : zones) {
+            covered += zone.length;
+            archivedTasks += zone.count;
+        }
+        auto archiveSize = std::filesystem::file_size(archiveFile);
+        std::cout << "Archive:     " << archivedTasks << " task(s) in " << zones.size() << " zone-mapped segment(s), "
+            << archiveSize - covered << " of " << archiveSize << " bytes unindexed" << std::endl;
+    }
 
-        // Restore next ID counter if present
-        if (j.contains("nextId")) {
-            nextId = j["nextId"];
+    // Sharded stores have no single file to analyse; summarize each shard instead
+    if (layout_) {
+        std::cout << "Shards:      " << shards_.size() << " by " << TaskStorage::schemeName(layout_->scheme);
+        if (layout_->scheme == TaskStorage::ShardLayout::Scheme::Range) {
+            std::cout << " (" << layout_->rangeSize << " IDs each)";
         }
+        std::cout << std::endl;
 
-        // Load all tasks from JSON array
-        if (j.contains("tasks")) {
-            for (const auto& taskJson : j["tasks"]) {
-                tasks.push_back(std::make_unique<Task>(Task::fromJson(taskJson)));
+        for (size_t i = 0; i < shards_.size(); ++i) {
+            const auto& shard = shards_[i];
+            std::cout << "  [" << i << "] " << shard.file.filename().string() << ": ";
+            if (std::filesystem::exists(shard.file)) {
+                std::cout << std::filesystem::file_size(shard.file) << " bytes";
+            }
+            else {
+                std::cout << "not written";
             }
+            std::cout << ", " << shard.store.memtableSize() << " logged, " << shard.store.runs().size() << " run(s)" << std::endl;
         }
+        return;
     }
-    catch (const std::exception& e) {
-        std::cout << Utils::RED << "Error loading data: " << e.what() << Utils::RESET << std::endl;
+
+    if (!std::filesystem::exists(dataFile)) {
+        std::cout << Utils::YELLOW << "Data file has not been written yet" << Utils::RESET << std::endl;
+        return;
+    }
+
+    std::string contents = TaskStorage::readFile(dataFile);
+    std::cout << "Stored size: " << contents.size() << " bytes" << std::endl;
+
+    if (contents.starts_with(TaskStorage::BINARY_MAGIC)) {
+        auto layout = TaskStorage::readBinaryLayout(contents);
+        double hotShare = contents.empty() ? 0.0 : 100.0 * layout.hotBytes / contents.size();
+        std::cout << "Tasks:       " << layout.taskCount << std::endl;
+        std::cout << "Hot section: " << layout.hotBytes << " bytes (" << std::fixed << std::setprecision(1)
+            << hotShare << "% of file, read by list/stats)" << std::endl;
+        std::cout << "Cold section: " << layout.coldBytes << " bytes (description, tags, completion; decoded on demand)"
+            << std::endl;
+        std::cout << std::defaultfloat;
+        return;
     }
+
+    if (!BlockCodec::isContainer(contents)) {
+        return;
+    }
+
+    auto info = BlockCodec::readInfo(contents);
+    double ratio = contents.empty() ? 0.0 : static_cast<double>(info.rawSize) / contents.size();
+    std::cout << "Raw size:    " << info.rawSize << " bytes" << std::endl;
+    std::cout << "Blocks:      " << info.blocks.size() << " x " << info.blockSize << " bytes" << std::endl;
+    std::cout << "Ratio:       " << std::fixed << std::setprecision(2) << ratio << ":1" << std::endl;
+
+    // Time a full parallel decode and a single random-access block read
+    auto start = std::chrono::steady_clock::now();
+    auto raw = BlockCodec::decompress(contents);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double mbPerSecond = elapsed > 0 ? (raw.size() / (1024.0 * 1024.0)) / elapsed : 0.0;
+    std::cout << "Decode:      " << std::setprecision(1) << mbPerSecond << " MB/s ("
+        << std::setprecision(3) << elapsed * 1000.0 << " ms)" << std::endl;
+
+    if (!info.blocks.empty()) {
+        size_t middle = info.blocks.size() / 2;
+        start = std::chrono::steady_clock::now();
+        auto block = BlockCodec::decompressBlockAt(contents, info, middle);
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Block read:  #" << middle << " in " << elapsed * 1000.0 << " ms" << std::endl;
+    }
+    std::cout << std::defaultfloat;
 }
 
-// Save all tasks to JSON file on disk
-void Tasks::saveToFile() const {
-    try {
-        // Ensure directory exists
+// Open the change tiers of every shard (just the data file when unsharded)
+void Tasks::openShards() {
+    shards_.clear();
+    if (!layout_) {
+        shards_.push_back({ dataFile, LsmStore(dataFile) });
+        return;
+    }
+
+    shards_.reserve(layout_->files.size());
+    for (const auto& file : layout_->files) {
+        shards_.push_back({ file, LsmStore(file) });
+    }
+}
+
+Tasks::Shard& Tasks::shardFor(int id) const {
+    return shards_[layout_ ? layout_->shardOf(id) : 0];
+}
+
+// Load tasks from every shard snapshot and replay their change tiers
+void Tasks::loadFromFile() {
+    loaded_ = true;
+    order_dirty_ = true;
+
+    // Create directory structure if data file doesn't exist
+    if (dataFile.has_parent_path() && !std::filesystem::exists(dataFile.parent_path())) {
         std::filesystem::create_directories(dataFile.parent_path());
+    }
 
-        // Build JSON structure with metadata and task array
-        nlohmann::json j{
-            {"nextId", nextId},
-            {"tasks", nlohmann::json::array()}
-        };
+    try {
+        // Shards are independent files, so they are decoded and replayed concurrently
+        std::vector<std::vector<std::unique_ptr<Task>>> parts(shards_.size());
+        std::vector<int> nextIds(shards_.size(), 1);
+        std::vector<std::optional<TaskStorage::SnapshotFormat>> formats(shards_.size());
+        std::vector<LsmStore::ReplayReport> replays(shards_.size());
+
+        Parallel::forEachChunk(shards_.size(), Parallel::workerCount(shards_.size(), 1), [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                // A shard with no snapshot yet still has every task in its log and runs
+                if (std::filesystem::exists(shards_[i].file)) {
+                    TaskStorage::SnapshotFormat format = TaskStorage::SnapshotFormat::Json;
+                    parts[i] = TaskStorage::loadSnapshot(shards_[i].file, nextIds[i], format);
+                    formats[i] = format;
+                }
+
+                // Newer changes from sorted runs and the write-ahead log win over the snapshot
+                replays[i] = shards_[i].store.replay(parts[i], nextIds[i]);
+            }
+            });
 
-        // Convert all tasks to JSON format
-        for (const auto& task : tasks) {
-            j["tasks"].push_back(task->toJson());
+        size_t total = 0;
+        for (const auto& part : parts) {
+            total += part.size();
         }
-
-        std::ofstream file(dataFile);
-        if (!file.is_open()) {
-            throw std::runtime_error("Could not open data file for writing");
+        tasks.reserve(total);
+
+        for (size_t i = 0; i < shards_.size(); ++i) {
+            std::ranges::move(parts[i], std::back_inserter(tasks));
+            nextId = std::max(nextId, nextIds[i]);
+            replay_report_ += replays[i];
+            if (formats[i]) {
+                snapshot_format_ = *formats[i];
+            }
         }
+    }
+    catch (const std::exception& e) {
+        load_failed_ = true;
+        std::cout << Utils::RED << "Error loading data: " << e.what() << Utils::RESET << std::endl;
+    }
+}
 
-        // Write with 4-space indentation for readability
-        file << j.dump(4);
+// Save all tasks to disk, folding every shard's change tiers into its snapshot
+void Tasks::saveToFile() {
+    try {
+        writeShards();
     }
     catch (const std::exception& e) {
         std::cout << Utils::RED << "Error saving data: " << e.what() << Utils::RESET << std::endl;
     }
 }
 
-// Helper method to get tasks sorted by priority and status
-std::vector<Task*> Tasks::getSortedTasks() const {
-    std::vector<Task*> sortedTasks;
+// Rewrite shard snapshots; this is the major compaction for their change tiers
+void Tasks::writeShards(const std::function<bool(size_t)>& include) {
+    // Ensure directory exists (a bare file name lives in the working directory)
+    if (dataFile.has_parent_path()) {
+        std::filesystem::create_directories(dataFile.parent_path());
+    }
 
-    // Convert unique_ptr to raw pointers for sorting
-    for (const auto& task : tasks) {
-        sortedTasks.push_back(task.get());
+    // Group tasks by shard without disturbing their order within a shard
+    std::vector<size_t> bounds(shards_.size() + 1, 0);
+    if (layout_) {
+        std::ranges::stable_sort(tasks, {}, [this](const auto& task) { return layout_->shardOf(task->getId()); });
+        for (const auto& task : tasks) {
+            ++bounds[layout_->shardOf(task->getId()) + 1];
+        }
+        std::partial_sum(bounds.begin(), bounds.end(), bounds.begin());
+    }
+    else {
+        bounds[1] = tasks.size();
     }
 
-    // Sort using Task's operator< for consistent ordering
-    std::ranges::sort(sortedTasks, [](const Task* a, const Task* b) {
-        return *a < *b;  // Use Task's operator<
+    std::span<const std::unique_ptr<Task>> all(tasks);
+    Parallel::forEachChunk(shards_.size(), Parallel::workerCount(shards_.size(), 1), [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            auto& shard = shards_[i];
+            if (include && !include(i)) {
+                continue;
+            }
+
+            // Tasks are serialized in parallel chunks and written with writev();
+            // output is byte-identical to dumping the whole document with dump(4)
+            TaskStorage::writeSnapshot(shard.file, nextId, all.subspan(bounds[i], bounds[i + 1] - bounds[i]), snapshot_format_);
+            shard.store.checkpointed(std::filesystem::file_size(shard.file));
+        }
         });
+}
+
+// Tasks in display order, read from the persistent order index
+std::vector<Task*> Tasks::getSortedTasks() const {
+    if (sort_order_) {
+        std::vector<Task*> sortedTasks;
+        sortedTasks.reserve(tasks.size());
+        for (const auto& task : tasks) {
+            sortedTasks.push_back(task.get());
+        }
+        TaskSort::sort(sortedTasks, *sort_order_);
+        return sortedTasks;
+    }
 
-    return sortedTasks;
+    rebuildOrder();
+    return order_.ordered();
+}
+
+// Rebuild the display order after bulk changes; single-task edits keep it current
+void Tasks::rebuildOrder() const {
+    if (!order_dirty_) return;
+    order_.rebuild(tasks);
+    order_dirty_ = false;
 }
 
 // Helper method to display a list of tasks with a title
-void Tasks::displayTaskList(const std::vector<Task*>& taskList, std::string_view title) const {
+void Tasks::displayTaskList(const std::vector<Task*>& taskList, std::string_view title, size_t total) const {
     if (!title.empty()) {
         std::cout << Utils::BOLD << title << Utils::RESET << std::endl;
         std::cout << std::endl;
@@ -509,7 +1561,11 @@ void Tasks::displayTaskList(const std::vector<Task*>& taskList, std::string_view
     // Table footer
     printTableSeparator(idWidth, nameWidth, statusWidth, priorityWidth, dueDateWidth);
 
-    std::cout << Utils::CYAN << "📊 Count: " << taskList.size() << Utils::RESET << std::endl;
+    std::cout << Utils::CYAN << "📊 Count: " << taskList.size();
+    if (total > taskList.size()) {
+        std::cout << " of " << total;
+    }
+    std::cout << Utils::RESET << std::endl;
 }
 
 // Const version of findTask for read-only operations
@@ -538,12 +1594,8 @@ const Task* Tasks::findTask(int id) const noexcept {
 void Tasks::rebuildSearchIndex() const {
     if (!index_dirty_) return;
 
-    search_index_.clear();
-
-    // Add all tasks to the search index for faster searching
-    for (const auto& task : tasks) {
-        search_index_.addTask(*task);
-    }
+    // Bulk build: parallel tokenize + sort instead of per-task trie inserts
+    search_index_.build(tasks);
 
     index_dirty_ = false;
 }
@@ -607,12 +1659,20 @@ void Tasks::printTableHeader(int idWidth, int nameWidth, int statusWidth, int pr
     printTableSeparator(idWidth, nameWidth, statusWidth, priorityWidth, dueDateWidth);
 
     // Header row with bold formatting and proper column alignment
-    std::cout << "| " << Utils::BOLD << std::left << std::setw(idWidth) << "ID";
-    std::cout << " | " << std::left << std::setw(nameWidth) << "Task Name";
-    std::cout << " | " << std::left << std::setw(statusWidth) << "Status";
-    std::cout << " | " << std::left << std::setw(priorityWidth) << "Priority";
-    std::cout << " | " << std::left << std::setw(dueDateWidth) << "Due Date";
-    std::cout << " |" << Utils::RESET << std::endl;
+    std::string header = "| ";
+    header += Utils::BOLD;
+    TextFormat::appendPadded(header, "ID", static_cast<size_t>(idWidth));
+    header += " | ";
+    TextFormat::appendPadded(header, "Task Name", static_cast<size_t>(nameWidth));
+    header += " | ";
+    TextFormat::appendPadded(header, "Status", static_cast<size_t>(statusWidth));
+    header += " | ";
+    TextFormat::appendPadded(header, "Priority", static_cast<size_t>(priorityWidth));
+    header += " | ";
+    TextFormat::appendPadded(header, "Due Date", static_cast<size_t>(dueDateWidth));
+    header += " |";
+    header += Utils::RESET;
+    std::cout << header << std::endl;
 
     // Header separator
     printTableSeparator(idWidth, nameWidth, statusWidth, priorityWidth, dueDateWidth);
@@ -627,7 +1687,7 @@ std::string Tasks::formatTaskName(const Task* task, int maxWidth) const {
         taskName.substr(0, maxWidth - 3) + "..." : taskName;
 
     // Add visual overdue indicator [!]
-    if (task->isOverdue()) {
+    if (task->isOverdue(context_)) {
         displayName += " [!]";
         // Re-check length after adding indicator and truncate if needed
         if (displayName.length() > static_cast<size_t>(maxWidth)) {
@@ -642,19 +1702,31 @@ std::string Tasks::formatTaskName(const Task* task, int maxWidth) const {
 void Tasks::printTaskRow(const Task* task, int idWidth, int nameWidth, int statusWidth, int priorityWidth, int dueDateWidth) const {
     // Prepare formatted data for each column
     std::string displayName = formatTaskName(task, nameWidth);
-    std::string statusStr = task->getStatusString();
-    std::string priorityStr = task->getPriorityString();
-    std::string dueDateStr = task->getDueDate() ? Utils::formatDate(*task->getDueDate()) : "";
 
     // Get appropriate colors for status and priority visualization
     std::string_view statusColor = Utils::getStatusColor(task->getStatus());
     std::string_view priorityColor = Utils::getPriorityColor(task->getPriority());
 
-    // Display row with proper alignment and colors
-    std::cout << "| " << std::left << std::setw(idWidth) << task->getId();
-    std::cout << " | " << std::left << std::setw(nameWidth) << displayName;
-    std::cout << " | " << statusColor << std::left << std::setw(statusWidth) << statusStr << Utils::RESET;
-    std::cout << " | " << priorityColor << std::left << std::setw(priorityWidth) << priorityStr << Utils::RESET;
-    std::cout << " | " << std::left << std::setw(dueDateWidth) << dueDateStr;
-    std::cout << " |" << std::endl;
+    // Build the whole row, then write it with a single stream insertion
+    std::string row;
+    row.reserve(static_cast<size_t>(idWidth + nameWidth + statusWidth + priorityWidth + dueDateWidth) + 48);
+    row += "| ";
+    TextFormat::appendPadded(row, task->getId(), static_cast<size_t>(idWidth));
+    row += " | ";
+    TextFormat::appendPadded(row, displayName, static_cast<size_t>(nameWidth));
+    row += " | ";
+    row += statusColor;
+    TextFormat::appendPadded(row, task->getStatusString(), static_cast<size_t>(statusWidth));
+    row += Utils::RESET;
+    row += " | ";
+    row += priorityColor;
+    TextFormat::appendPadded(row, task->getPriorityString(), static_cast<size_t>(priorityWidth));
+    row += Utils::RESET;
+    row += " | ";
+    const size_t dueStart = row.size();
+    if (task->getDueDate()) TextFormat::appendDate(row, *task->getDueDate());
+    const size_t dueLength = row.size() - dueStart;
+    if (dueLength < static_cast<size_t>(dueDateWidth)) row.append(static_cast<size_t>(dueDateWidth) - dueLength, ' ');
+    row += " |\n";
+    std::cout << row;
 }
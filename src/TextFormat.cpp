@@ -0,0 +1,109 @@
+/**
+ * @file TextFormat.cpp
+ * @brief Implementation of locale-free number and date formatting
+ */
+
+#include "TextFormat.hpp"
+#include "TimeZone.hpp"
+#include <charconv>
+
+namespace TextFormat {
+
+    namespace {
+
+        constexpr int64_t kSecondsPerDay = 86400;
+
+    } // anonymous namespace
+
+    int32_t utcOffset(int64_t epochSeconds) {
+        return TimeZone::local().offsetAt(epochSeconds);
+    }
+
+    size_t digitCount(long long value) noexcept {
+        size_t count = value < 0 ? 2 : 1;
+        auto magnitude = value < 0 ? 0ull - static_cast<unsigned long long>(value)
+                                   : static_cast<unsigned long long>(value);
+        while (magnitude >= 10) {
+            magnitude /= 10;
+            ++count;
+        }
+        return count;
+    }
+
+    void appendInt(std::string& out, long long value) {
+        char buffer[24];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, result.ptr);
+    }
+
+    void appendPadded(std::string& out, std::string_view text, size_t width) {
+        out.append(text);
+        if (text.size() < width) out.append(width - text.size(), ' ');
+    }
+
+    void appendPadded(std::string& out, long long value, size_t width) {
+        const size_t start = out.size();
+        appendInt(out, value);
+        const size_t written = out.size() - start;
+        if (written < width) out.append(width - written, ' ');
+    }
+
+    namespace {
+
+        /// Write a value in [0, 99] as two digits
+        char* writeTwoDigits(char* out, unsigned value) noexcept {
+            out[0] = static_cast<char>('0' + value / 10);
+            out[1] = static_cast<char>('0' + value % 10);
+            return out + 2;
+        }
+
+        /// Split an instant into local calendar day and second of day
+        struct LocalTime {
+            CivilDate date;
+            unsigned secondOfDay;
+        };
+
+        LocalTime toLocal(const std::chrono::system_clock::time_point& timePoint) {
+            const int64_t epochSeconds = std::chrono::system_clock::to_time_t(timePoint);
+            const int64_t local = epochSeconds + utcOffset(epochSeconds);
+            const int64_t day = floorDiv(local, kSecondsPerDay);
+            return { civilFromDays(day), static_cast<unsigned>(local - day * kSecondsPerDay) };
+        }
+
+        /// Write YYYY-MM-DD; the buffer needs room for a 20-digit signed year
+        char* writeCivil(char* out, const CivilDate& date) noexcept {
+            if (date.year >= 1000 && date.year <= 9999) {
+                const auto year = static_cast<unsigned>(date.year);
+                out = writeTwoDigits(out, year / 100);
+                out = writeTwoDigits(out, year % 100);
+            } else {
+                out = std::to_chars(out, out + 24, date.year).ptr;
+            }
+            *out++ = '-';
+            out = writeTwoDigits(out, date.month);
+            *out++ = '-';
+            return writeTwoDigits(out, date.day);
+        }
+
+    } // anonymous namespace
+
+    void appendDate(std::string& out, const std::chrono::system_clock::time_point& timePoint) {
+        char buffer[32];
+        char* end = writeCivil(buffer, toLocal(timePoint).date);
+        out.append(buffer, end);
+    }
+
+    void appendDateTime(std::string& out, const std::chrono::system_clock::time_point& timePoint) {
+        const LocalTime local = toLocal(timePoint);
+        char buffer[48];
+        char* end = writeCivil(buffer, local.date);
+        *end++ = ' ';
+        end = writeTwoDigits(end, local.secondOfDay / 3600);
+        *end++ = ':';
+        end = writeTwoDigits(end, local.secondOfDay / 60 % 60);
+        *end++ = ':';
+        end = writeTwoDigits(end, local.secondOfDay % 60);
+        out.append(buffer, end);
+    }
+
+} // namespace TextFormat
@@ -0,0 +1,416 @@
+/**
+ * @file TimeZone.cpp
+ * @brief TZif and POSIX rule loading and offset lookup for TimeZone
+ */
+
+#include "TimeZone.hpp"
+#include "ByteOrder.hpp"
+#include "TextFormat.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace {
+
+    constexpr int64_t kSecondsPerDay = 86400;
+    constexpr int64_t kExpandThroughYear = 2200;    ///< Rule transitions precomputed into the table
+    constexpr int64_t kPosixFirstYear = 1970;       ///< Pure POSIX zones expand from here
+    constexpr size_t kMaxTzifBytes = 1 << 20;
+    constexpr int kBucketShift = 21;                ///< 2^21 s (~24 days) per bucket
+    constexpr int64_t kIndexFloor = -5364662400;    ///< 1800-01-01; earlier instants use binary search
+    constexpr size_t kMaxBuckets = 1 << 16;
+
+    using TextFormat::floorDiv;
+
+    constexpr int64_t floorMod(int64_t value, int64_t divisor) noexcept {
+        return value - floorDiv(value, divisor) * divisor;
+    }
+
+    /// Year containing a local instant
+    int64_t yearOf(int64_t localSeconds) noexcept {
+        return TextFormat::civilFromDays(floorDiv(localSeconds, kSecondsPerDay)).year;
+    }
+
+    /// Cursor over POSIX rule text
+    struct RuleReader {
+        std::string_view text;
+        size_t pos = 0;
+
+        [[nodiscard]] bool done() const noexcept { return pos >= text.size(); }
+        [[nodiscard]] char peek() const noexcept { return done() ? '\0' : text[pos]; }
+
+        bool consume(char c) noexcept {
+            if (peek() != c) return false;
+            ++pos;
+            return true;
+        }
+
+        /// Unsigned decimal number with at most maxValue
+        std::optional<int> number(int maxValue) noexcept {
+            if (peek() < '0' || peek() > '9') return std::nullopt;
+            int value = 0;
+            while (peek() >= '0' && peek() <= '9') {
+                value = value * 10 + (text[pos++] - '0');
+                if (value > maxValue) return std::nullopt;
+            }
+            return value;
+        }
+
+        /// Zone abbreviation: three or more letters, or <...> quoted
+        bool name() noexcept {
+            if (consume('<')) {
+                const size_t close = text.find('>', pos);
+                if (close == std::string_view::npos || close - pos < 3) return false;
+                pos = close + 1;
+                return true;
+            }
+            const size_t start = pos;
+            while ((peek() >= 'A' && peek() <= 'Z') || (peek() >= 'a' && peek() <= 'z')) ++pos;
+            return pos - start >= 3;
+        }
+
+        /// [+-]hh[:mm[:ss]] in seconds
+        std::optional<int32_t> duration(int maxHours) noexcept {
+            int32_t sign = 1;
+            if (consume('-')) sign = -1;
+            else consume('+');
+            auto hours = number(maxHours);
+            if (!hours) return std::nullopt;
+            int32_t seconds = *hours * 3600;
+            if (consume(':')) {
+                auto minutes = number(59);
+                if (!minutes) return std::nullopt;
+                seconds += *minutes * 60;
+                if (consume(':')) {
+                    auto secs = number(59);
+                    if (!secs) return std::nullopt;
+                    seconds += *secs;
+                }
+            }
+            return sign * seconds;
+        }
+    };
+
+    std::optional<std::string> readSmallFile(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return std::nullopt;
+        std::string data;
+        char buffer[4096];
+        while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0) {
+            data.append(buffer, static_cast<size_t>(in.gcount()));
+            if (data.size() > kMaxTzifBytes) return std::nullopt;
+        }
+        return data;
+    }
+
+    /// Resolve TZ the way glibc does
+    TimeZone loadLocalZone() {
+        const char* tz = std::getenv("TZ");
+        if (tz == nullptr) {
+            if (auto data = readSmallFile("/etc/localtime")) {
+                if (auto zone = TimeZone::fromTzif(*data)) return *zone;
+            }
+            return TimeZone::utc();
+        }
+
+        std::string_view name = tz;
+        if (!name.empty() && name.front() == ':') name.remove_prefix(1);
+        if (name.empty()) return TimeZone::utc();
+
+        std::string path;
+        if (name.front() == '/') {
+            path = name;
+        } else {
+            const char* dir = std::getenv("TZDIR");
+            path = (dir != nullptr && *dir != '\0') ? dir : "/usr/share/zoneinfo";
+            path += '/';
+            path += name;
+        }
+        if (auto data = readSmallFile(path)) {
+            if (auto zone = TimeZone::fromTzif(*data)) return *zone;
+        }
+        if (auto zone = TimeZone::fromPosix(name)) return *zone;
+        return TimeZone::utc();
+    }
+
+} // anonymous namespace
+
+// ======================
+// Construction
+// ======================
+
+const TimeZone& TimeZone::local() {
+    static const TimeZone zone = loadLocalZone();
+    return zone;
+}
+
+TimeZone TimeZone::utc() {
+    return TimeZone{};
+}
+
+std::optional<TimeZone> TimeZone::fromTzif(std::string_view data) {
+    constexpr size_t kHeaderSize = 44;
+
+    struct Counts {
+        uint32_t isut, isstd, leap, time, type, chars;
+    };
+    auto readCounts = [&](size_t at) {
+        return Counts{ ByteOrder::getBE<uint32_t>(data, at + 20), ByteOrder::getBE<uint32_t>(data, at + 24),
+            ByteOrder::getBE<uint32_t>(data, at + 28), ByteOrder::getBE<uint32_t>(data, at + 32),
+            ByteOrder::getBE<uint32_t>(data, at + 36), ByteOrder::getBE<uint32_t>(data, at + 40) };
+    };
+    auto blockSize = [](const Counts& c, size_t timeSize) {
+        return c.time * timeSize + c.time + c.type * 6 + c.chars + c.leap * (timeSize + 4) + c.isstd + c.isut;
+    };
+
+    if (data.size() < kHeaderSize || data.substr(0, 4) != "TZif") return std::nullopt;
+    const char version = data[4];
+
+    // Version 2+ files repeat the data with 64-bit times after the v1 block
+    size_t header = 0;
+    size_t timeSize = 4;
+    Counts counts = readCounts(0);
+    if (version >= '2') {
+        header = kHeaderSize + blockSize(counts, 4);
+        if (data.size() < header + kHeaderSize || data.substr(header, 4) != "TZif") return std::nullopt;
+        counts = readCounts(header);
+        timeSize = 8;
+    }
+    const size_t body = header + kHeaderSize;
+    if (counts.type == 0 || data.size() < body + blockSize(counts, timeSize)) return std::nullopt;
+
+    const size_t indexAt = body + counts.time * timeSize;
+    const size_t typesAt = indexAt + counts.time;
+    auto typeOffset = [&](size_t type) {
+        return ByteOrder::getBE<int32_t>(data, typesAt + type * 6);
+    };
+
+    TimeZone zone;
+    zone.initialOffset_ = typeOffset(0);
+    int32_t current = zone.initialOffset_;
+    for (size_t i = 0; i < counts.time; ++i) {
+        const int64_t at = timeSize == 8 ? ByteOrder::getBE<int64_t>(data, body + i * 8)
+                                         : ByteOrder::getBE<int32_t>(data, body + i * 4);
+        const auto type = static_cast<uint8_t>(data[indexAt + i]);
+        if (type >= counts.type || (!zone.transitions_.empty() && at <= zone.transitions_.back())) return std::nullopt;
+        const int32_t offset = typeOffset(type);
+        if (offset == current) continue;
+        zone.transitions_.push_back(at);
+        zone.offsets_.push_back(offset);
+        current = offset;
+    }
+
+    // Footer: "\n<POSIX rule>\n" governs instants after the last transition
+    if (version >= '2') {
+        const size_t footerAt = body + blockSize(counts, timeSize);
+        if (footerAt < data.size() && data[footerAt] == '\n') {
+            const size_t close = data.find('\n', footerAt + 1);
+            if (close != std::string_view::npos) {
+                auto rule = parseRule(data.substr(footerAt + 1, close - footerAt - 1));
+                if (rule && rule->hasDst) {
+                    zone.rule_ = rule;
+                    zone.expandRule(kExpandThroughYear);
+                }
+            }
+        }
+    }
+    zone.buildIndex();
+    return zone;
+}
+
+std::optional<TimeZone> TimeZone::fromPosix(std::string_view text) {
+    auto rule = parseRule(text);
+    if (!rule) return std::nullopt;
+
+    TimeZone zone;
+    zone.initialOffset_ = rule->stdOffset;
+    if (rule->hasDst) {
+        // glibc evaluates years before 1970 against 1970's transitions
+        zone.initialOffset_ = ruleOffset(*rule, 0);
+        zone.rule_ = rule;
+        zone.expandRule(kExpandThroughYear);
+    }
+    zone.buildIndex();
+    return zone;
+}
+
+// ======================
+// POSIX Rules
+// ======================
+
+std::optional<TimeZone::Rule> TimeZone::parseRule(std::string_view text) {
+    RuleReader reader{ text };
+    Rule rule;
+
+    // Offsets are written as hours west of UTC: "EST5" is UTC-5
+    if (!reader.name()) return std::nullopt;
+    auto stdOffset = reader.duration(24);
+    if (!stdOffset) return std::nullopt;
+    rule.stdOffset = -*stdOffset;
+    if (reader.done()) return rule;
+
+    if (!reader.name()) return std::nullopt;
+    rule.hasDst = true;
+    rule.dstOffset = rule.stdOffset + 3600;
+    if (reader.peek() != ',' && !reader.done()) {
+        auto dstOffset = reader.duration(24);
+        if (!dstOffset) return std::nullopt;
+        rule.dstOffset = -*dstOffset;
+    }
+
+    // Without explicit dates, use the current US rules (glibc's built-in default)
+    if (reader.done()) {
+        rule.start = { Rule::Date::Kind::MonthWeekDay, 0, 3, 2, 7200 };
+        rule.end = { Rule::Date::Kind::MonthWeekDay, 0, 11, 1, 7200 };
+        return rule;
+    }
+
+    auto readDate = [&reader](Rule::Date& date) {
+        if (!reader.consume(',')) return false;
+        if (reader.consume('J')) {
+            auto day = reader.number(365);
+            if (!day || *day < 1) return false;
+            date.kind = Rule::Date::Kind::Julian;
+            date.day = *day;
+        } else if (reader.consume('M')) {
+            auto month = reader.number(12);
+            if (!month || *month < 1 || !reader.consume('.')) return false;
+            auto week = reader.number(5);
+            if (!week || *week < 1 || !reader.consume('.')) return false;
+            auto weekday = reader.number(6);
+            if (!weekday) return false;
+            date.kind = Rule::Date::Kind::MonthWeekDay;
+            date.month = *month;
+            date.week = *week;
+            date.day = *weekday;
+        } else {
+            auto day = reader.number(365);
+            if (!day) return false;
+            date.kind = Rule::Date::Kind::ZeroBased;
+            date.day = *day;
+        }
+        if (reader.consume('/')) {
+            auto time = reader.duration(167);
+            if (!time) return false;
+            date.time = *time;
+        }
+        return true;
+    };
+    if (!readDate(rule.start) || !readDate(rule.end) || !reader.done()) return std::nullopt;
+    return rule;
+}
+
+int64_t TimeZone::ruleInstant(const Rule::Date& date, int64_t year, int32_t offset) noexcept {
+    const int64_t jan1 = TextFormat::daysFromCivil(year, 1, 1);
+    int64_t day = 0;
+    switch (date.kind) {
+    case Rule::Date::Kind::Julian: {
+        // Jn never counts February 29
+        const bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        day = jan1 + date.day - 1 + (leap && date.day >= 60);
+        break;
+    }
+    case Rule::Date::Kind::ZeroBased:
+        day = jan1 + date.day;
+        break;
+    case Rule::Date::Kind::MonthWeekDay: {
+        const auto month = static_cast<unsigned>(date.month);
+        const int64_t first = TextFormat::daysFromCivil(year, month, 1);
+        const int64_t next = month == 12 ? TextFormat::daysFromCivil(year + 1, 1, 1)
+                                         : TextFormat::daysFromCivil(year, month + 1, 1);
+        // 1970-01-01 was a Thursday (weekday 4)
+        const int64_t firstWeekday = floorMod(first + 4, 7);
+        day = first + floorMod(date.day - firstWeekday, 7) + (date.week - 1) * 7;
+        while (day >= next) day -= 7;
+        break;
+    }
+    }
+    return day * kSecondsPerDay + date.time - offset;
+}
+
+int32_t TimeZone::ruleOffset(const Rule& rule, int64_t utcSeconds) noexcept {
+    const int64_t year = yearOf(utcSeconds + rule.stdOffset);
+    const int64_t start = ruleInstant(rule.start, year, rule.stdOffset);
+    const int64_t end = ruleInstant(rule.end, year, rule.dstOffset);
+    const bool daylight = start < end ? (utcSeconds >= start && utcSeconds < end)
+                                      : (utcSeconds < end || utcSeconds >= start);
+    return daylight ? rule.dstOffset : rule.stdOffset;
+}
+
+void TimeZone::expandRule(int64_t lastYear) {
+    const Rule& rule = *rule_;
+    const int64_t firstYear = transitions_.empty() ? kPosixFirstYear : yearOf(transitions_.back());
+    int32_t current = offsets_.empty() ? initialOffset_ : offsets_.back();
+
+    for (int64_t year = firstYear; year <= lastYear; ++year) {
+        std::array<std::pair<int64_t, int32_t>, 2> changes{ {
+            { ruleInstant(rule.start, year, rule.stdOffset), rule.dstOffset },
+            { ruleInstant(rule.end, year, rule.dstOffset), rule.stdOffset } } };
+        std::ranges::sort(changes);
+        for (const auto& [at, offset] : changes) {
+            if (!transitions_.empty() && at <= transitions_.back()) continue;
+            if (offset == current) continue;
+            transitions_.push_back(at);
+            offsets_.push_back(offset);
+            current = offset;
+        }
+    }
+    ruleHorizon_ = TextFormat::daysFromCivil(lastYear + 1, 1, 1) * kSecondsPerDay;
+}
+
+void TimeZone::buildIndex() {
+    if (transitions_.empty()) return;
+    bucketBase_ = std::max(transitions_.front(), kIndexFloor);
+    const int64_t span = std::min(transitions_.back(), ruleHorizon_) - bucketBase_;
+    const auto count = static_cast<size_t>(span >> kBucketShift) + 1;
+    if (count > kMaxBuckets) return;
+
+    buckets_.resize(count);
+    size_t next = 0;
+    for (size_t bucket = 0; bucket < count; ++bucket) {
+        const int64_t start = bucketBase_ + (static_cast<int64_t>(bucket) << kBucketShift);
+        while (next < transitions_.size() && transitions_[next] <= start) ++next;
+        buckets_[bucket] = static_cast<uint32_t>(next);
+    }
+}
+
+// ======================
+// Conversions
+// ======================
+
+int32_t TimeZone::offsetAt(int64_t utcSeconds) const noexcept {
+    if (utcSeconds >= ruleHorizon_) return ruleOffset(*rule_, utcSeconds);
+
+    // Bucketed range: start from the bucket's count and step past the few
+    // transitions inside it
+    if (utcSeconds >= bucketBase_) {
+        const auto bucket = static_cast<uint64_t>(utcSeconds - bucketBase_) >> kBucketShift;
+        if (bucket < buckets_.size()) {
+            size_t next = buckets_[bucket];
+            while (next < transitions_.size() && transitions_[next] <= utcSeconds) ++next;
+            return next == 0 ? initialOffset_ : offsets_[next - 1];
+        }
+    }
+
+    const auto next = std::ranges::upper_bound(transitions_, utcSeconds);
+    if (next == transitions_.begin()) return initialOffset_;
+    return offsets_[static_cast<size_t>(std::distance(transitions_.begin(), next)) - 1];
+}
+
+int64_t TimeZone::toUtc(int64_t localSeconds) const noexcept {
+    // Offsets in effect a day either side bracket any single transition
+    const int32_t before = offsetAt(localSeconds - kSecondsPerDay);
+    const int32_t after = offsetAt(localSeconds + kSecondsPerDay);
+    const int64_t early = localSeconds - before;
+    if (offsetAt(early) == before) return early;
+    const int64_t late = localSeconds - after;
+    if (offsetAt(late) == after) return late;
+    return early;  // Skipped by a spring-forward gap
+}
+
+int64_t TimeZone::localDay(int64_t utcSeconds) const noexcept {
+    return floorDiv(toLocal(utcSeconds), kSecondsPerDay);
+}
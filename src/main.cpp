@@ -10,8 +10,16 @@
  */
 
 #include "Tasks.hpp"
+#include "FileWatcher.hpp"
+#include "LiveView.hpp"
+#include "TaskImport.hpp"
+#include "TaskJson.hpp"
+#include "TaskSchema.hpp"
+#include "TaskSync.hpp"
 #include "utils.hpp"
 #include <iostream>
+#include <sstream>
+#include <csignal>
 #include <memory>
 #include <format>
 #include <vector>
@@ -22,6 +30,17 @@
 #include <unordered_map> // Added for std::unordered_map
 #include <unordered_set> // Added for std::unordered_set
 #include <optional>      // Added for std::optional
+#include <chrono>
+#include <thread>
+#include <type_traits>
+#include <charconv>
+
+namespace {
+
+    volatile std::sig_atomic_t stop_requested = 0;   ///< Set by SIGINT/SIGTERM to end a live view
+    volatile std::sig_atomic_t terminal_resized = 0; ///< Set by SIGWINCH to force a full repaint
+
+} // namespace
 
  /**
   * @class CommandLineParser
@@ -139,12 +158,13 @@ public:
     // ===================
 
     /**
-     * @brief Check if argument is an option (starts with -)
+     * @brief Check if argument is an option (--name or -x)
      * @param arg Argument to check
      * @return true if argument is an option
      */
     [[nodiscard]] bool isOption(std::string_view arg) const noexcept {
-        return arg.starts_with("-");
+        // Long options or single-letter short ones, so values like "-priority" stay values
+        return arg.starts_with("--") || (arg.size() == 2 && arg[0] == '-');
     }
 
     /**
@@ -206,6 +226,9 @@ class TodoApplication {
 private:
     std::unique_ptr<Tasks> tasks_;    ///< Main task container
     std::unordered_map<std::string, std::function<void(CommandLineParser&)>> command_handlers_; ///< Command dispatcher
+    const std::unordered_set<std::string> single_task_commands_{
+        "detail", "show", "info", "complete", "done", "tag", "untag", "due", "deadline", "watch", "diff"
+    }; ///< Commands that touch one task by ID or none (run against a deferred store)
 
     /**
      * @struct Config
@@ -215,7 +238,10 @@ private:
         std::string data_file = "data/data.json";  ///< Path to data file
         bool verbose = false;                      ///< Enable verbose output
         bool quiet = false;                        ///< Suppress non-essential output
+        LsmStore::CheckpointPolicy checkpoint;     ///< Limits that trigger an automatic checkpoint
+        std::optional<std::chrono::system_clock::time_point> as_of; ///< Fixed evaluation instant (--as-of)
     } config_;
+    bool memory_stale_ = false;    ///< Set after a live view: memory may lag the store, so never checkpoint from it
 
     // ==================
     // Help and Usage
@@ -234,6 +260,10 @@ private:
         std::cout << "  --data-file <path>    Specify custom data file path\n";
         std::cout << "  -v, --verbose         Enable detailed output\n";
         std::cout << "  -q, --quiet          Suppress non-essential output\n";
+        std::cout << "  --as-of <date>       Evaluate overdue state, stats and listings as of a date\n";
+        std::cout << "  --checkpoint-bytes <n>    Checkpoint when log and runs exceed n bytes (default: 16 MiB)\n";
+        std::cout << "  --checkpoint-records <n>  Checkpoint when log and runs exceed n records (default: 50000)\n";
+        std::cout << "  --checkpoint-ms <n>       Checkpoint when replay would take over n ms (default: 250)\n";
         std::cout << "  --version            Show version information\n";
         std::cout << "  -h, --help           Show this help message\n\n";
 
@@ -244,14 +274,19 @@ private:
         std::cout << "              -t|--tags <tag1,tag2,...>\n\n";
 
         std::cout << "  📋 list [filter]                  Display tasks (aliases: ls)\n";
-        std::cout << "     Filters: todo, inprogress, completed, low, medium, high, overdue\n\n";
+        std::cout << "     Filters: todo, inprogress, completed, low, medium, high, overdue\n";
+        std::cout << "     ('completed' also lists archived tasks)\n";
+        std::cout << "     Options: --watch (keep the view open and redraw rows as tasks change)\n";
+        std::cout << "              --sort <keys> (comma-separated: " << TaskSort::fieldNames() << ";\n";
+        std::cout << "              prefix '-' for descending, e.g. due,-priority)\n\n";
 
         std::cout << "  🔄 update <id> <name> <status> <priority>  Modify existing task\n\n";
 
         std::cout << "  🗑️  remove <id>                   Delete a task (aliases: rm, delete)\n";
         std::cout << "     Options: --all (remove all tasks with confirmation)\n\n";
 
-        std::cout << "  🔍 search <query>                 Find tasks (aliases: find)\n\n";
+        std::cout << "  🔍 search <query>                 Find tasks (aliases: find)\n";
+        std::cout << "     Options: --all (also search the archive)\n\n";
 
         std::cout << "  📖 detail <id>                    Show task details (aliases: show, info)\n\n";
 
@@ -263,15 +298,54 @@ private:
 
         std::cout << "  📅 due <id> <date>                Set due date (aliases: deadline)\n\n";
 
-        std::cout << "  📊 stats                          Show statistics (aliases: statistics)\n\n";
+        std::cout << "  📊 stats                          Show statistics (aliases: statistics)\n";
+        std::cout << "     Options: --all (include archived tasks), --watch (redraw as tasks change)\n\n";
+
+        std::cout << "  📈 report                         Show metrics grouped by task fields\n";
+        std::cout << "     Options: --group-by <fields> (" << TaskReport::dimensionNames() << ")\n";
+        std::cout << "              --metrics <names> (" << TaskReport::metricNames() << "; default count)\n";
+        std::cout << "              --all (include archived tasks)\n\n";
+
+        std::cout << "  🗄️  archive                        Move old completed tasks to the archive file\n";
+        std::cout << "     Options: --older-than <days> (default: 30)\n\n";
+
+        std::cout << "  ⚠️  overdue                       Show overdue tasks\n\n";
+
+        std::cout << "  💾 storage                        Show data file format and compression stats\n";
+        std::cout << "     Options: --format json|compressed|binary (rewrite the data file)\n\n";
+
+        std::cout << "  🧹 compact                        Fold sorted runs and the write-ahead log into the data file\n\n";
+
+        std::cout << "  👀 watch                          Print change events as JSON lines\n";
+        std::cout << "     Options: --since <seq> (only newer events), --follow (keep waiting for more)\n\n";
+
+        std::cout << "  🧩 reshard <count>                Split tasks across shard files (1 merges them back)\n";
+        std::cout << "     Options: --by range|hash (default: range)\n\n";
 
-        std::cout << "  ⚠️  overdue                       Show overdue tasks\n\n";        std::cout << Utils::CYAN << "EXAMPLES:" << Utils::RESET << "\n";
+        std::cout << "  🔀 diff [<fileA>] <fileB>         List tasks added, removed or changed between two data files\n";
+        std::cout << "     (fileA defaults to the current data file)\n\n";
+
+        std::cout << "  🔄 sync <other-file>              Three-way merge with another copy of the data file\n";
+        std::cout << "     (both files end up with the same tasks; conflicts go to the latest change)\n\n";
+
+        std::cout << "  📥 import <file>                  Bulk-load tasks from CSV, NDJSON or todo.txt\n";
+        std::cout << "     Options: --format csv|ndjson|todotxt (default: from the file extension)\n\n";
+
+        std::cout << "  📤 export <file>                  Write every task as CSV or NDJSON (readable by import)\n";
+        std::cout << "     Options: --format csv|ndjson (default: from the file extension)\n\n";
+
+        std::cout << Utils::CYAN << "EXAMPLES:" << Utils::RESET << "\n";
         std::cout << "  todo add \"Buy groceries\" --priority high --due 2025-12-31\n";
         std::cout << "  todo add \"Write report\" -p medium -d \"Quarterly analysis\" -t work,urgent\n";
         std::cout << "  todo list completed\n";
+        std::cout << "  todo list high --watch\n";
+        std::cout << "  todo list --sort due,-priority,created\n";
+        std::cout << "  todo report --group-by tag,status --metrics count,overdue,avg_age\n";
+        std::cout << "  todo list overdue --as-of 2025-06-30\n";
         std::cout << "  todo search \"grocery\"\n";
         std::cout << "  todo complete 1\n";
-        std::cout << "  todo tag 2 urgent\n\n";
+        std::cout << "  todo tag 2 urgent\n";
+        std::cout << "  todo import backlog.csv\n\n";
 
         std::cout << Utils::CYAN << "VALID VALUES:" << Utils::RESET << "\n";
         std::cout << "  Status: todo, inprogress, completed\n";
@@ -298,13 +372,163 @@ private:
             auto dataFile = parser.getOptionValue("--data-file");
             if (!dataFile.empty()) {
                 config_.data_file = dataFile;
-                tasks_ = std::make_unique<Tasks>(config_.data_file);
             }
         }
 
         // Set verbosity flags
         config_.verbose = parser.hasOption("-v") || parser.hasOption("--verbose");
         config_.quiet = parser.hasOption("-q") || parser.hasOption("--quiet");
+
+        // Checkpoint triggers bound how much the next startup has to replay
+        auto limit = [&parser](std::string_view option, auto& target) {
+            if (!parser.hasOption(option)) return;
+            auto value = parser.getOptionValue(option);
+            if (!Utils::isNumber(value)) {
+                std::cout << Utils::YELLOW << "Warning: ignoring " << option << " (expects a number)" << Utils::RESET << std::endl;
+                return;
+            }
+            target = static_cast<std::remove_reference_t<decltype(target)>>(std::stoull(std::string{ value }));
+            };
+        limit("--checkpoint-bytes", config_.checkpoint.maxBytes);
+        limit("--checkpoint-records", config_.checkpoint.maxRecords);
+        limit("--checkpoint-ms", config_.checkpoint.maxReplayMs);
+
+        // Reports for another point in time: every overdue check uses this instant instead of the clock
+        if (parser.hasOption("--as-of")) {
+            auto value = parser.getOptionValue("--as-of");
+            config_.as_of = Utils::parseDate(value);
+            if (!config_.as_of) {
+                std::cout << Utils::YELLOW << "Warning: ignoring --as-of (expects a date)" << Utils::RESET << std::endl;
+            }
+        }
+    }
+
+    /**
+     * @brief Checkpoint if a trigger fired and report replay costs when verbose
+     */
+    void finishStorage() {
+        if (memory_stale_) {
+            return;
+        }
+        if (auto checkpoint = tasks_->checkpointIfNeeded()) {
+            if (!checkpoint->success) {
+                std::cout << Utils::YELLOW << "⚠️  " << checkpoint->message << Utils::RESET << std::endl;
+            }
+            else if (config_.verbose) {
+                std::cout << Utils::BLUE << checkpoint->message << Utils::RESET << std::endl;
+            }
+        }
+
+        if (config_.verbose) {
+            const auto& replay = tasks_->getReplayReport();
+            std::cout << Utils::BLUE << std::format("Replay: {} record(s) applied from {} byte(s) of log and runs in {:.3f} ms",
+                replay.records, replay.bytes, replay.seconds * 1000.0) << Utils::RESET << std::endl;
+        }
+    }
+
+    // ==================
+    // Live View
+    // ==================
+
+    /**
+     * @brief Keep a view on screen, redrawing it whenever the store changes, until interrupted
+     * @param render Prints the current frame to std::cout
+     *
+     * Sleeps on inotify while nothing changes. On a change, new change feed
+     * events are applied to memory; only if the snapshot itself changed with
+     * no events behind it is the store reloaded and diffed. The frame is then
+     * redrawn, and only rows whose text differs reach the terminal.
+     */
+    void runLiveView(const std::function<void()>& render) {
+        const std::filesystem::path data_path{ config_.data_file };
+        const auto stem = data_path.stem().string();
+        memory_stale_ = true;
+
+        // Files that only change on checkpoints, reshards or edits made outside the application
+        auto is_snapshot = [&](const std::string& name) {
+            return name.empty() || name == data_path.filename().string() ||
+                name == TaskStorage::shardManifestPath(data_path).filename().string() ||
+                name.starts_with(stem + ".shard-");
+        };
+
+        auto capture = [&render, this] {
+            // One clock sample per frame, so overdue markers advance while the view stays open
+            if (!config_.as_of) {
+                tasks_->setEvalContext(EvalContext::current());
+            }
+            std::ostringstream frame;
+            auto* previous = std::cout.rdbuf(frame.rdbuf());
+            try {
+                render();
+            }
+            catch (...) {
+                std::cout.rdbuf(previous);
+                throw;
+            }
+            std::cout.rdbuf(previous);
+            return frame.str();
+        };
+
+        struct sigaction action {};
+        action.sa_handler = [](int signal) {
+            if (signal == SIGWINCH) terminal_resized = 1;
+            else stop_requested = 1;
+        };
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = 0; // No SA_RESTART: a signal has to interrupt the blocking wait
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+        sigaction(SIGWINCH, &action, nullptr);
+
+        try {
+            FileWatcher watcher(data_path.parent_path());
+            LiveView view;
+            uint64_t since = tasks_->lastChange();
+            std::string status = "Waiting for changes";
+
+            auto draw = [&] {
+                auto header = std::format("{}👀 Watching {} (Ctrl-C to stop){}\n{}{}{}\n\n",
+                    Utils::BOLD, config_.data_file, Utils::RESET, Utils::DIM, status, Utils::RESET);
+                view.draw(header + capture());
+            };
+            draw();
+
+            while (!stop_requested) {
+                auto changed = watcher.wait();
+                if (stop_requested) break;
+                if (terminal_resized) {
+                    terminal_resized = 0;
+                    view.invalidate();
+                    draw();
+                }
+                if (!changed || changed->empty()) continue;
+
+                auto start = std::chrono::steady_clock::now();
+                auto applied = tasks_->applyChanges(since);
+                if (applied && *applied > 0) {
+                    status = std::format("Applied {} change event(s) up to #{}", *applied, since);
+                }
+                else if (!applied || std::ranges::any_of(*changed, is_snapshot)) {
+                    auto differing = tasks_->reload(since);
+                    if (differing == 0) continue;
+                    status = std::format("Reloaded: {} task(s) differ from the previous view", differing);
+                }
+                else {
+                    continue; // Log, run and manifest writes are always followed by feed events
+                }
+
+                auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+                status += std::format(" in {:.1f} ms", elapsed.count());
+                draw();
+            }
+        }
+        catch (const std::exception& e) {
+            std::cout << Utils::RED << "✗ Live view stopped: " << e.what() << Utils::RESET << std::endl;
+        }
+
+        std::signal(SIGINT, SIG_DFL);
+        std::signal(SIGTERM, SIG_DFL);
+        std::signal(SIGWINCH, SIG_DFL);
     }
 
     // =======================
@@ -449,6 +673,21 @@ private:
         }
 
         try {
+            if (parser.hasOption("--sort")) {
+                auto order = TaskSort::parseOrder(parser.getOptionValue("--sort"));
+                if (!order) {
+                    std::cout << Utils::RED << "✗ Invalid --sort keys: " << parser.getOptionValue("--sort") << Utils::RESET << std::endl;
+                    std::cout << "Sort keys: " << TaskSort::fieldNames() << " (prefix '-' for descending)" << std::endl;
+                    return;
+                }
+                tasks_->setSortOrder(std::move(*order));
+            }
+
+            if (parser.hasOption("--watch")) {
+                watchTaskList(filter);
+                return;
+            }
+
             if (!config_.quiet) {
                 std::cout << Utils::CYAN << "Listing tasks..." << Utils::RESET << std::endl;
             }
@@ -489,6 +728,48 @@ private:
         }
     }
 
+    /**
+     * @brief Show a live, screen-sized window of the task list
+     * @param filter List filter (empty for all tasks)
+     *
+     * Archived tasks are not part of the live view, so 'completed' shows
+     * only tasks still in the data file.
+     */
+    void watchTaskList(const std::string& filter) {
+        std::function<bool(const Task&)> predicate;
+        if (filter.empty()) {
+            predicate = [](const Task&) { return true; };
+        }
+        else if (filter == "todo" || filter == "inprogress" || filter == "completed") {
+            predicate = [status = Utils::parseTaskStatus(filter)](const Task& task) { return task.getStatus() == status; };
+        }
+        else if (filter == "low" || filter == "medium" || filter == "high") {
+            predicate = [priority = Utils::parseTaskPriority(filter)](const Task& task) { return task.getPriority() == priority; };
+        }
+        else if (filter == "overdue") {
+            predicate = [this](const Task& task) { return task.isOverdue(tasks_->getEvalContext()); };
+        }
+        else {
+            std::cout << Utils::YELLOW << "Unknown filter: " << filter << Utils::RESET << std::endl;
+            std::cout << "Available filters: todo, inprogress, completed, low, medium, high, overdue" << std::endl;
+            return;
+        }
+
+        const auto title = filter.empty() ? std::string{ "All Tasks" } : "Tasks: " + filter;
+        runLiveView([&] {
+            // Rows left after the watch header, table chrome and the spare bottom line
+            constexpr size_t overhead = 11;
+            auto rows = LiveView::terminalRows();
+            size_t matched = 0;
+            auto window = tasks_->topTasks(predicate, rows > overhead ? rows - overhead : 1, matched);
+            if (window.empty()) {
+                std::cout << Utils::YELLOW << "No tasks found!" << Utils::RESET << std::endl;
+                return;
+            }
+            tasks_->displayTaskList(window, title, matched);
+            });
+    }
+
     /**
      * @brief Handle 'update' command - modify existing task
      * @param parser Command line parser
@@ -618,21 +899,23 @@ private:
     void handleSearchCommand(CommandLineParser& parser) {
         parser.reset();
 
-        if (!parser.hasMoreArgs()) {
+        bool include_archive = parser.hasOption("--all");
+
+        // "search --all <query>" parses the query as the option's value
+        std::string query{ parser.hasMoreArgs() ? parser.nextArg() : parser.getOptionValue("--all") };
+        if (query.empty()) {
             std::cout << Utils::RED << "Error: Search query is required" << Utils::RESET << std::endl;
-            std::cout << "Usage: todo search <query>" << std::endl;
+            std::cout << "Usage: todo search <query> [--all]" << std::endl;
             return;
         }
 
-        std::string query{ parser.nextArg() };
-
         try {
             if (!config_.quiet) {
                 std::cout << Utils::CYAN << "Searching for: \"" << query << "\"..." << Utils::RESET << std::endl;
             }
 
             // Execute search operation
-            auto results = tasks_->searchTasks(query);
+            auto results = tasks_->searchTasks(query, include_archive);
 
             if (results.empty()) {
                 std::cout << Utils::YELLOW << "No tasks found matching: \"" << query << "\"" << Utils::RESET << std::endl;
@@ -688,7 +971,7 @@ private:
                 std::cout << Utils::CYAN << operation_name << " task " << id << "..." << Utils::RESET << std::endl;
             }
 
-            if (auto task = tasks_->findTask(id)) {
+            if (auto task = tasks_->loadTask(id)) {
                 op(task);
                 tasks_->save();
                 std::cout << Utils::GREEN << "✓ Operation completed successfully!" << Utils::RESET << std::endl;
@@ -770,7 +1053,7 @@ private:
                 std::cout << Utils::CYAN << "Removing tag \"" << tag << "\" from task " << id << "..." << Utils::RESET << std::endl;
             }
 
-            if (auto task = tasks_->findTask(id)) {
+            if (auto task = tasks_->loadTask(id)) {
                 task->removeTag(tag);
                 tasks_->save();
                 std::cout << Utils::GREEN << "✓ Tag removed successfully!" << Utils::RESET << std::endl;
@@ -823,7 +1106,7 @@ private:
             }
 
             // Execute due date setting
-            if (auto task = tasks_->findTask(id)) {
+            if (auto task = tasks_->loadTask(id)) {
                 task->setDueDate(due_date);
                 tasks_->save();
                 std::cout << Utils::GREEN << "✓ Due date set successfully!" << Utils::RESET << std::endl;
@@ -839,16 +1122,52 @@ private:
 
     /**
      * @brief Handle 'stats' command - show task statistics
+     * @param parser Command line parser
      */
-    void handleStatsCommand() {
+    void handleStatsCommand(CommandLineParser& parser) {
         try {
-            tasks_->showStatistics();
+            bool include_archive = parser.hasOption("--all");
+            if (parser.hasOption("--watch")) {
+                runLiveView([&] { tasks_->showStatistics(include_archive); });
+                return;
+            }
+            tasks_->showStatistics(include_archive);
         }
         catch (const std::exception& e) {
             std::cout << Utils::RED << "✗ Failed to show statistics: " << e.what() << Utils::RESET << std::endl;
         }
     }
 
+    /**
+     * @brief Handle 'report' command - show metrics grouped by task fields
+     * @param parser Command line parser
+     */
+    void handleReportCommand(CommandLineParser& parser) {
+        auto groupBy = TaskReport::parseDimensions(parser.getOptionValue("--group-by"));
+        if (!groupBy) {
+            std::cout << Utils::RED << "✗ Usage: todo report --group-by <fields> [--metrics <names>]" << Utils::RESET << std::endl;
+            std::cout << "Fields: " << TaskReport::dimensionNames() << std::endl;
+            return;
+        }
+
+        std::optional<std::vector<TaskReport::Metric>> metrics{ { TaskReport::Metric::Count } };
+        if (parser.hasOption("--metrics")) {
+            metrics = TaskReport::parseMetrics(parser.getOptionValue("--metrics"));
+            if (!metrics) {
+                std::cout << Utils::RED << "✗ Invalid --metrics: " << parser.getOptionValue("--metrics") << Utils::RESET << std::endl;
+                std::cout << "Metrics: " << TaskReport::metricNames() << std::endl;
+                return;
+            }
+        }
+
+        try {
+            tasks_->showReport(*groupBy, *metrics, parser.hasOption("--all"));
+        }
+        catch (const std::exception& e) {
+            std::cout << Utils::RED << "✗ Failed to build report: " << e.what() << Utils::RESET << std::endl;
+        }
+    }
+
     /**
      * @brief Handle 'overdue' command - show overdue tasks
      */
@@ -861,13 +1180,412 @@ private:
         }
     }
 
+    /**
+     * @brief Handle 'archive' command - move old completed tasks to the archive
+     * @param parser Command line parser
+     */
+    void handleArchiveCommand(CommandLineParser& parser) {
+        int days = 30;
+        if (parser.hasOption("--older-than")) {
+            // from_chars rejects trailing text and out-of-range counts without throwing
+            auto days_str = parser.getOptionValue("--older-than");
+            const char* end = days_str.data() + days_str.size();
+            auto [parsed, error] = std::from_chars(days_str.data(), end, days);
+            if (error != std::errc{} || parsed != end || days < 0) {
+                std::cout << Utils::RED << "Error: --older-than expects a number of days" << Utils::RESET << std::endl;
+                return;
+            }
+        }
+
+        try {
+            if (!config_.quiet) {
+                std::cout << Utils::CYAN << "Archiving tasks completed more than " << days << " day(s) ago..." << Utils::RESET << std::endl;
+            }
+
+            auto result = tasks_->archiveCompletedTasks(std::chrono::days{ days });
+            if (result.success) {
+                std::cout << Utils::GREEN << "✓ " << result.message << Utils::RESET << std::endl;
+            }
+            else {
+                std::cout << Utils::RED << "✗ Error: " << result.message << Utils::RESET << std::endl;
+            }
+        }
+        catch (const std::exception& e) {
+            std::cout << Utils::RED << "✗ Failed to archive tasks: " << e.what() << Utils::RESET << std::endl;
+        }
+    }
+
+    /**
+     * @brief Handle 'compact' command - fold runs and the log into the snapshot
+     */
+    void handleCompactCommand() {
+        try {
+            auto result = tasks_->compact();
+            if (result.success) {
+                std::cout << Utils::GREEN << "✓ " << result.message << Utils::RESET << std::endl;
+            }
+            else {
+                std::cout << Utils::RED << "✗ Error: " << result.message << Utils::RESET << std::endl;
+            }
+        }
+        catch (const std::exception& e) {
+            std::cout << Utils::RED << "✗ Failed to compact: " << e.what() << Utils::RESET << std::endl;
+        }
+    }
+
+    /**
+     * @brief Handle 'watch' command - stream change events after a sequence number
+     * @param parser Command line parser
+     */
+    void handleWatchCommand(CommandLineParser& parser) {
+        uint64_t since = 0;
+        if (parser.hasOption("--since")) {
+            auto since_str = parser.getOptionValue("--since");
+            if (!Utils::isNumber(since_str)) {
+                std::cout << Utils::RED << "Error: --since expects a sequence number" << Utils::RESET << std::endl;
+                return;
+            }
+            since = std::stoull(std::string{ since_str });
+        }
+
+        try {
+            // Events are printed verbatim so consumers can parse each line as JSON
+            auto print = [](std::string_view line) { std::cout << line << '\n'; };
+            since = tasks_->readChanges(since, print);
+            std::cout.flush();
+
+            while (parser.hasOption("--follow")) {
+                std::this_thread::sleep_for(std::chrono::seconds(1));
+                since = tasks_->readChanges(since, print);
+                std::cout.flush();
+            }
+        }
+        catch (const std::exception& e) {
+            std::cout << Utils::RED << "✗ Failed to read change feed: " << e.what() << Utils::RESET << std::endl;
+        }
+    }
+
+    /**
+     * @brief Handle 'reshard' command - repartition tasks across shard files
+     * @param parser Command line parser
+     */
+    void handleReshardCommand(CommandLineParser& parser) {
+        parser.reset();
+        auto count_str = parser.nextArg();
+        if (count_str.empty() || !Utils::isNumber(count_str)) {
+            std::cout << Utils::RED << "Error: reshard expects a shard count" << Utils::RESET << std::endl;
+            std::cout << "Usage: todo reshard <count> [--by range|hash]" << std::endl;
+            return;
+        }
+
+        auto scheme = TaskStorage::ShardLayout::Scheme::Range;
+        if (parser.hasOption("--by")) {
+            auto scheme_str = parser.getOptionValue("--by");
+            auto parsed = TaskStorage::parseScheme(Utils::toLowerCase(scheme_str));
+            if (!parsed) {
+                std::cout << Utils::RED << "✗ Unknown shard scheme: " << scheme_str << Utils::RESET << std::endl;
+                std::cout << "Available schemes: range, hash" << std::endl;
+                return;
+            }
+            scheme = *parsed;
+        }
+
+        try {
+            if (!config_.quiet) {
+                std::cout << Utils::CYAN << "Resharding " << tasks_->size() << " task(s)..." << Utils::RESET << std::endl;
+            }
+
+            auto result = tasks_->reshard(std::stoul(std::string{ count_str }), scheme);
+            if (result.success) {
+                std::cout << Utils::GREEN << "✓ " << result.message << Utils::RESET << std::endl;
+            }
+            else {
+                std::cout << Utils::RED << "✗ Error: " << result.message << Utils::RESET << std::endl;
+            }
+        }
+        catch (const std::exception& e) {
+            std::cout << Utils::RED << "✗ Failed to reshard: " << e.what() << Utils::RESET << std::endl;
+        }
+    }
+
+    /**
+     * @brief Handle 'storage' command - report or change the data file format
+     * @param parser Command line parser
+     */
+    void handleStorageCommand(CommandLineParser& parser) {
+        try {
+            if (parser.hasOption("--format")) {
+                auto format_str = parser.getOptionValue("--format");
+                auto format = TaskStorage::parseFormat(Utils::toLowerCase(format_str));
+                if (!format) {
+                    std::cout << Utils::RED << "✗ Unknown storage format: " << format_str << Utils::RESET << std::endl;
+                    std::cout << "Available formats: json, compressed, binary" << std::endl;
+                    return;
+                }
+
+                auto result = tasks_->setSnapshotFormat(*format);
+                if (!result.success) {
+                    std::cout << Utils::RED << "✗ Error: " << result.message << Utils::RESET << std::endl;
+                    return;
+                }
+                std::cout << Utils::GREEN << "✓ " << result.message << Utils::RESET << std::endl;
+                if (config_.quiet) return;
+            }
+
+            tasks_->showStorageInfo();
+        }
+        catch (const std::exception& e) {
+            std::cout << Utils::RED << "✗ Failed to inspect storage: " << e.what() << Utils::RESET << std::endl;
+        }
+    }
+
+    /**
+     * @brief Handle 'diff' command - list tasks that differ between two stores
+     * @param parser Command line parser
+     *
+     * With one file, compares the current data file against it.
+     */
+    void handleDiffCommand(CommandLineParser& parser) {
+        parser.reset();
+        std::string first{ parser.nextArg() };
+        std::string second{ parser.nextArg() };
+        if (first.empty()) {
+            std::cout << Utils::RED << "Error: diff expects one or two data files" << Utils::RESET << std::endl;
+            std::cout << "Usage: todo diff [<fileA>] <fileB>" << std::endl;
+            return;
+        }
+        if (second.empty()) {
+            second = std::exchange(first, config_.data_file);
+        }
+
+        for (const auto& file : { first, second }) {
+            if (!TaskStorage::storeExists(file)) {
+                std::cout << Utils::RED << "✗ No data file at " << file << Utils::RESET << std::endl;
+                return;
+            }
+        }
+
+        try {
+            Tasks left(first);
+            Tasks right(second);
+
+            auto start = std::chrono::steady_clock::now();
+            auto left_index = left.contentIndex();
+            auto right_index = right.contentIndex();
+            auto hashed = std::chrono::steady_clock::now();
+            auto comparison = ContentIndex::compare(left_index, right_index);
+            auto compared = std::chrono::steady_clock::now();
+
+            for (int id : comparison.ids) {
+                const Task* before = left.findTask(id);
+                const Task* after = right.findTask(id);
+                if (!after) {
+                    std::cout << Utils::RED << "- #" << id << " " << before->getName() << Utils::RESET << std::endl;
+                    continue;
+                }
+                if (!before) {
+                    std::cout << Utils::GREEN << "+ #" << id << " " << after->getName() << Utils::RESET << std::endl;
+                    continue;
+                }
+
+                // Name the fields that changed
+                auto changed = TaskSchema::changedFields(*before, *after);
+                std::string fields;
+                for (size_t i = 0; i < TaskSchema::FIELD_COUNT; ++i) {
+                    if (changed & (uint32_t{ 1 } << i)) {
+                        fields += (fields.empty() ? "" : ", ") + std::string{ TaskSchema::key(i) };
+                    }
+                }
+                std::cout << Utils::YELLOW << "~ #" << id << " " << after->getName() << Utils::RESET
+                    << " (" << fields << ")" << std::endl;
+            }
+
+            if (comparison.ids.empty()) {
+                std::cout << Utils::GREEN << "✓ Stores are identical (" << left_index.size() << " task(s))" << Utils::RESET << std::endl;
+            }
+            else if (!config_.quiet) {
+                std::cout << Utils::CYAN << comparison.ids.size() << " task(s) differ" << Utils::RESET << std::endl;
+            }
+
+            if (config_.verbose) {
+                auto ms = [](auto duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+                std::cout << Utils::BLUE << std::format("Root hashes {:016x} / {:016x}; {} range(s) compared for {} + {} task(s)",
+                    left_index.rootHash(), right_index.rootHash(), comparison.rangesCompared, left_index.size(), right_index.size())
+                    << Utils::RESET << std::endl;
+                std::cout << Utils::BLUE << std::format("Hashing: {:.2f} ms, comparison: {:.3f} ms",
+                    ms(hashed - start), ms(compared - hashed)) << Utils::RESET << std::endl;
+            }
+        }
+        catch (const std::exception& e) {
+            std::cout << Utils::RED << "✗ Failed to compare stores: " << e.what() << Utils::RESET << std::endl;
+        }
+    }
+
+    /**
+     * @brief Handle 'sync' command - three-way merge with another copy of the store
+     * @param parser Command line parser
+     */
+    void handleSyncCommand(CommandLineParser& parser) {
+        parser.reset();
+        std::string other{ parser.nextArg() };
+        if (other.empty()) {
+            std::cout << Utils::RED << "Error: sync expects the other data file" << Utils::RESET << std::endl;
+            std::cout << "Usage: todo sync <other-file>" << std::endl;
+            return;
+        }
+        if (!TaskStorage::storeExists(other)) {
+            std::cout << Utils::RED << "✗ No data file at " << other << Utils::RESET << std::endl;
+            return;
+        }
+
+        try {
+            Tasks remote(other);
+            remote.setCheckpointPolicy(config_.checkpoint);
+            auto report = TaskSync::synchronize(*tasks_, config_.data_file, remote, other);
+
+            if (report.firstSync && !config_.quiet) {
+                std::cout << Utils::YELLOW << "No common ancestor recorded: tasks with the same ID were merged as the same task"
+                    << Utils::RESET << std::endl;
+            }
+            std::cout << Utils::GREEN << std::format("✓ Sync generation {}: {} task(s) changed since the ancestor",
+                report.generation, report.changed) << Utils::RESET << std::endl;
+            if (!config_.quiet) {
+                std::cout << std::format("  Pulled: {} written, {} removed\n", report.toLocal, report.deletedLocal);
+                std::cout << std::format("  Pushed: {} written, {} removed\n", report.toRemote, report.deletedRemote);
+                std::cout << std::format("  Conflicts resolved: {}, IDs remapped: {}", report.conflicts, report.remapped) << std::endl;
+            }
+            if (config_.verbose) {
+                std::cout << Utils::BLUE << std::format("{} range hash(es) compared", report.rangesCompared) << Utils::RESET << std::endl;
+            }
+
+            // The other store gets the same checkpoint treatment as ours
+            if (auto checkpoint = remote.checkpointIfNeeded(); checkpoint && !checkpoint->success) {
+                std::cout << Utils::YELLOW << "⚠️  " << checkpoint->message << Utils::RESET << std::endl;
+            }
+        }
+        catch (const std::exception& e) {
+            std::cout << Utils::RED << "✗ Sync failed: " << e.what() << Utils::RESET << std::endl;
+        }
+    }
+
+    /**
+     * @brief Handle 'import' command - bulk-load tasks from another format
+     * @param parser Command line parser
+     */
+    void handleImportCommand(CommandLineParser& parser) {
+        parser.reset();
+        std::string file{ parser.nextArg() };
+        if (file.empty()) {
+            std::cout << Utils::RED << "Error: import expects an input file" << Utils::RESET << std::endl;
+            std::cout << "Usage: todo import <file> [--format csv|ndjson|todotxt]" << std::endl;
+            return;
+        }
+        if (!std::filesystem::exists(file)) {
+            std::cout << Utils::RED << "✗ No input file at " << file << Utils::RESET << std::endl;
+            return;
+        }
+
+        auto format = TaskImport::detectFormat(file);
+        if (parser.hasOption("--format")) {
+            auto format_str = parser.getOptionValue("--format");
+            format = TaskImport::parseFormat(Utils::toLowerCase(format_str));
+            if (!format) {
+                std::cout << Utils::RED << "✗ Unknown import format: " << format_str << Utils::RESET << std::endl;
+                std::cout << "Available formats: csv, ndjson, todotxt" << std::endl;
+                return;
+            }
+        }
+        if (!format) {
+            std::cout << Utils::RED << "✗ Cannot tell the format of " << file << " from its extension" << Utils::RESET << std::endl;
+            std::cout << "Use --format csv|ndjson|todotxt" << std::endl;
+            return;
+        }
+
+        try {
+            auto report = TaskImport::importFile(*tasks_, file, *format);
+            if (report.imported > 0) {
+                std::cout << Utils::GREEN << std::format("✓ Imported {} task(s) (#{}-#{}) from {} row(s) in {:.2f} s ({:.0f} rows/s)",
+                    report.imported, report.firstId, report.lastId, report.rows, report.seconds, report.rowsPerSecond())
+                    << Utils::RESET << std::endl;
+            }
+            else {
+                std::cout << Utils::YELLOW << std::format("No tasks imported from {} row(s)", report.rows) << Utils::RESET << std::endl;
+            }
+
+            if (report.rejectedRows > 0) {
+                constexpr size_t kShown = 20;
+                std::cout << Utils::YELLOW << std::format("⚠️  {} row(s) rejected", report.rejectedRows) << Utils::RESET << std::endl;
+                if (!config_.quiet) {
+                    size_t shown = config_.verbose ? report.rejected.size() : std::min(report.rejected.size(), kShown);
+                    for (size_t i = 0; i < shown; ++i) {
+                        std::cout << std::format("  line {}: {}", report.rejected[i].line, report.rejected[i].reason) << std::endl;
+                    }
+                    if (report.rejectedRows > shown) {
+                        std::cout << std::format("  ... and {} more", report.rejectedRows - shown) << std::endl;
+                    }
+                }
+            }
+            if (config_.verbose) {
+                std::cout << Utils::BLUE << std::format("{} byte(s) read as {}", report.bytes, TaskImport::formatName(*format))
+                    << Utils::RESET << std::endl;
+            }
+        }
+        catch (const std::exception& e) {
+            std::cout << Utils::RED << "✗ Import failed: " << e.what() << Utils::RESET << std::endl;
+        }
+    }
+
+    /**
+     * @brief Handle 'export' command - write every task as CSV or NDJSON
+     * @param parser Command line parser
+     */
+    void handleExportCommand(CommandLineParser& parser) {
+        parser.reset();
+        std::string file{ parser.nextArg() };
+        if (file.empty()) {
+            std::cout << Utils::RED << "Error: export expects an output file" << Utils::RESET << std::endl;
+            std::cout << "Usage: todo export <file> [--format csv|ndjson]" << std::endl;
+            return;
+        }
+
+        auto format = TaskImport::detectFormat(file);
+        if (parser.hasOption("--format")) {
+            format = TaskImport::parseFormat(Utils::toLowerCase(parser.getOptionValue("--format")));
+        }
+        if (!format || *format == TaskImport::Format::TodoTxt) {
+            std::cout << Utils::RED << "✗ Export writes csv or ndjson; use --format csv|ndjson" << Utils::RESET << std::endl;
+            return;
+        }
+
+        try {
+            std::string out;
+            if (*format == TaskImport::Format::Csv) {
+                out = TaskSchema::csvHeader();
+            }
+            tasks_->forEachTask([&](const Task& task) {
+                if (*format == TaskImport::Format::Csv) {
+                    TaskSchema::appendCsvRow(out, task);
+                }
+                else {
+                    TaskJson::appendCompact(out, task);
+                    out += '\n';
+                }
+                });
+            std::string buffers[] = { std::move(out) };
+            TaskStorage::writeBuffers(file, buffers);
+            std::cout << Utils::GREEN << std::format("✓ Exported {} task(s) to {} as {}", tasks_->size(), file,
+                TaskImport::formatName(*format)) << Utils::RESET << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cout << Utils::RED << "✗ Export failed: " << e.what() << Utils::RESET << std::endl;
+        }
+    }
+
 public:
     /**
      * @brief Construct TodoApplication with default configuration
      */
     TodoApplication() {
-        tasks_ = std::make_unique<Tasks>(config_.data_file);
-
         // Initialize command handlers
         command_handlers_["add"] = [this](CommandLineParser& p) { this->handleAddCommand(p); };
         command_handlers_["list"] = [this](CommandLineParser& p) { this->handleListCommand(p); };
@@ -887,9 +1605,19 @@ public:
         command_handlers_["untag"] = [this](CommandLineParser& p) { this->handleUntagCommand(p); };
         command_handlers_["due"] = [this](CommandLineParser& p) { this->handleDueDateCommand(p); };
         command_handlers_["deadline"] = [this](CommandLineParser& p) { this->handleDueDateCommand(p); };
-        command_handlers_["stats"] = [this](CommandLineParser&) { this->handleStatsCommand(); }; // Note: handleStatsCommand takes no parser
-        command_handlers_["statistics"] = [this](CommandLineParser&) { this->handleStatsCommand(); };
+        command_handlers_["stats"] = [this](CommandLineParser& p) { this->handleStatsCommand(p); };
+        command_handlers_["statistics"] = [this](CommandLineParser& p) { this->handleStatsCommand(p); };
+        command_handlers_["report"] = [this](CommandLineParser& p) { this->handleReportCommand(p); };
         command_handlers_["overdue"] = [this](CommandLineParser&) { this->handleOverdueCommand(); }; // Note: handleOverdueCommand takes no parser
+        command_handlers_["archive"] = [this](CommandLineParser& p) { this->handleArchiveCommand(p); };
+        command_handlers_["storage"] = [this](CommandLineParser& p) { this->handleStorageCommand(p); };
+        command_handlers_["compact"] = [this](CommandLineParser&) { this->handleCompactCommand(); };
+        command_handlers_["reshard"] = [this](CommandLineParser& p) { this->handleReshardCommand(p); };
+        command_handlers_["diff"] = [this](CommandLineParser& p) { this->handleDiffCommand(p); };
+        command_handlers_["sync"] = [this](CommandLineParser& p) { this->handleSyncCommand(p); };
+        command_handlers_["import"] = [this](CommandLineParser& p) { this->handleImportCommand(p); };
+        command_handlers_["export"] = [this](CommandLineParser& p) { this->handleExportCommand(p); };
+        command_handlers_["watch"] = [this](CommandLineParser& p) { this->handleWatchCommand(p); };
     }
 
     /**
@@ -928,7 +1656,16 @@ public:
             auto command_str = std::string{ command };
             auto it = command_handlers_.find(command_str);
             if (it != command_handlers_.end()) {
+                // Single-task commands read one record and log the change instead of loading the store
+                auto mode = single_task_commands_.contains(command_str) ? LoadMode::Deferred : LoadMode::Full;
+                tasks_ = std::make_unique<Tasks>(config_.data_file, mode);
+                tasks_->setCheckpointPolicy(config_.checkpoint);
+                if (config_.as_of) {
+                    tasks_->setEvalContext(EvalContext::at(*config_.as_of));
+                }
+
                 it->second(parser); // Call the handler
+                finishStorage();
             }
             else {
                 std::cout << Utils::RED << "Error: Unknown command '" << command << "'" << Utils::RESET << std::endl;
@@ -1,10 +1,14 @@
 #include "utils.hpp"
+#include "ByteOrder.hpp"
+#include "TextFormat.hpp"
+#include "TimeZone.hpp"
 #include <iostream>
 #include <algorithm>
 #include <sstream>
 #include <cctype>
 #include <iomanip>
 #include <chrono>
+#include <bit>
 #include <format>
 
 using namespace std::chrono;
@@ -67,21 +71,28 @@ namespace Utils {
 
     // Date/time utilities
     std::string formatDateTime(const system_clock::time_point& timePoint) {
-        auto time_t_val = system_clock::to_time_t(timePoint);
-        auto tm_val = *std::localtime(&time_t_val);
-
-        std::ostringstream oss;
-        oss << std::put_time(&tm_val, "%Y-%m-%d %H:%M:%S");
-        return oss.str();
+        std::string out;
+        out.reserve(19);
+        TextFormat::appendDateTime(out, timePoint);
+        return out;
     }
 
     std::string formatDate(const system_clock::time_point& timePoint) {
-        auto time_t_val = system_clock::to_time_t(timePoint);
-        auto tm_val = *std::localtime(&time_t_val);
+        std::string out;
+        out.reserve(10);
+        TextFormat::appendDate(out, timePoint);
+        return out;
+    }
+
+    namespace {
+        // Local wall-clock conversions through the process-wide TimeZone table
+        int64_t localDay(const system_clock::time_point& timePoint) {
+            return TimeZone::local().localDay(system_clock::to_time_t(timePoint));
+        }
 
-        std::ostringstream oss;
-        oss << std::put_time(&tm_val, "%Y-%m-%d");
-        return oss.str();
+        system_clock::time_point fromLocalSeconds(int64_t localSeconds) {
+            return system_clock::from_time_t(static_cast<std::time_t>(TimeZone::local().toUtc(localSeconds)));
+        }
     }
 
     // Date parsing helper functions
@@ -89,7 +100,10 @@ namespace Utils {
         std::istringstream iss{ std::string{dateStr} };
         std::tm tm = {};
         if (iss >> std::get_time(&tm, format)) {
-            return system_clock::from_time_t(std::mktime(&tm));
+            // Out-of-range days roll into the next month, as mktime() did
+            const int64_t day = TextFormat::daysFromCivil(tm.tm_year + 1900,
+                static_cast<unsigned>(tm.tm_mon + 1), static_cast<unsigned>(tm.tm_mday));
+            return fromLocalSeconds(day * 86400 + tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec);
         }
         return std::nullopt;
     }
@@ -146,16 +160,8 @@ namespace Utils {
 
     // Helper functions for date calculations
     std::chrono::system_clock::time_point getToday() {
-        auto now = system_clock::now();
-        auto time_t_now = system_clock::to_time_t(now);
-        auto tm_now = *std::localtime(&time_t_now);
-
-        // Set to start of day (midnight)
-        tm_now.tm_hour = 0;
-        tm_now.tm_min = 0;
-        tm_now.tm_sec = 0;
-
-        return system_clock::from_time_t(std::mktime(&tm_now));
+        // Start of the current local day (midnight)
+        return fromLocalSeconds(localDay(system_clock::now()) * 86400);
     }
 
     std::chrono::system_clock::time_point getTomorrow() {
@@ -180,24 +186,24 @@ namespace Utils {
     }
 
     std::chrono::system_clock::time_point getNextMonth() {
-        auto today = getToday();
-        auto time_t_today = system_clock::to_time_t(today);
-        auto tm_today = *std::localtime(&time_t_today);
+        auto today = TextFormat::civilFromDays(localDay(system_clock::now()));
 
         // Add one month
-        tm_today.tm_mon += 1;
-        if (tm_today.tm_mon > 11) {
-            tm_today.tm_mon = 0;
-            tm_today.tm_year += 1;
+        int64_t year = today.year;
+        unsigned month = today.month + 1;
+        if (month > 12) {
+            month = 1;
+            year += 1;
         }
 
         // Handle day overflow (e.g., Jan 31 + 1 month = Feb 28/29)
-        int maxDay = getDaysInMonth(tm_today.tm_mon, tm_today.tm_year + 1900);
-        if (tm_today.tm_mday > maxDay) {
-            tm_today.tm_mday = maxDay;
+        unsigned day = today.day;
+        auto maxDay = static_cast<unsigned>(getDaysInMonth(static_cast<int>(month) - 1, static_cast<int>(year)));
+        if (day > maxDay) {
+            day = maxDay;
         }
 
-        return system_clock::from_time_t(std::mktime(&tm_today));
+        return fromLocalSeconds(TextFormat::daysFromCivil(year, month, day) * 86400);
     }
 
     std::chrono::system_clock::time_point addDays(const std::chrono::system_clock::time_point& tp, int days) {
@@ -272,6 +278,40 @@ namespace Utils {
         throw std::invalid_argument(std::format("Invalid priority: {}", priorityStr));
     }
 
+    // Hashing utilities
+    uint64_t hash64(std::string_view data, uint64_t seed) noexcept {
+        constexpr uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+        constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr uint64_t prime3 = 0x165667B19E3779F9ULL;
+
+        // Words are read little-endian so stored checksums match on every host
+        size_t pos = 0;
+        uint64_t h = seed ^ (static_cast<uint64_t>(data.size()) * prime1);
+
+        for (; pos + 8 <= data.size(); pos += 8) {
+            const auto word = ByteOrder::getLE<uint64_t>(data, pos);
+            h ^= std::rotl(word * prime2, 31) * prime1;
+            h = std::rotl(h, 27) * prime1 + prime3;
+        }
+
+        if (pos < data.size()) {
+            uint64_t tail = 0;
+            for (size_t i = 0; pos + i < data.size(); ++i) {
+                tail |= static_cast<uint64_t>(static_cast<uint8_t>(data[pos + i])) << (8 * i);
+            }
+            h ^= std::rotl(tail * prime2, 31) * prime1;
+            h = std::rotl(h, 27) * prime1 + prime3;
+        }
+
+        // Final avalanche so every input bit affects every output bit
+        h ^= h >> 33;
+        h *= prime2;
+        h ^= h >> 29;
+        h *= prime3;
+        h ^= h >> 32;
+        return h;
+    }
+
     // Display utilities
     void printHeader() {
         std::cout << BOLD << CYAN;